@@ -0,0 +1,287 @@
+/*
+ * experimentBatch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "experimentBatch.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "../exportWriter.hpp"
+#include "../utilities.hpp"
+#include "../threads.hpp"
+#include "../trace.hpp"
+#include "../tcga-analyzer/TCGA-Analyzer.hpp"
+
+namespace {
+
+std::mutex outputMutex;
+
+//Experiments with the same key share the corresponding intermediate result
+std::string getCohortKey(const RunConfig &experiment) {
+	return experiment.describeCohort();
+}
+
+std::string getNormalizationKey(const RunConfig &experiment) {
+	return getCohortKey(experiment) + "|" + experiment.describeNormalization();
+}
+
+std::string getDistanceMatrixKey(const RunConfig &experiment) {
+	return getNormalizationKey(experiment) + "|" + experiment.metricName + "|"
+			+ std::to_string(experiment.distanceKernelMode);
+}
+
+}
+
+std::vector<RunConfig> readExperiments(const std::string &file,
+		const RunConfig &defaults) {
+	std::ifstream input(file);
+	if (!input) {
+		throw std::runtime_error("Cannot open experiment file " + file);
+	}
+	std::vector<RunConfig> experiments;
+	std::string line;
+	unsigned int lineNumber = 0;
+	while (std::getline(input, line)) {
+		++lineNumber;
+		std::istringstream words(line);
+		std::vector<std::string> tokens;
+		std::string word;
+		while (words >> word) {
+			tokens.push_back(word);
+		}
+		if (tokens.empty() || tokens[0][0] == '#') {
+			continue;
+		}
+		try {
+			if (tokens.size() % 2 != 0) {
+				throw wrong_usage_exception(
+						"options should come in \"-option value\" pairs");
+			}
+			std::vector<RunConfig> lineExperiments = { defaults };
+			for (unsigned int i = 0; i < tokens.size(); i += 2) {
+				std::vector<RunConfig> expanded;
+				for (const std::string &value : split(tokens[i + 1], { '|' })) {
+					for (RunConfig experiment : lineExperiments) {
+						experiment.set(tokens[i], value);
+						expanded.push_back(experiment);
+					}
+				}
+				lineExperiments.swap(expanded);
+			}
+			experiments.insert(experiments.end(), lineExperiments.begin(),
+					lineExperiments.end());
+		} catch (const wrong_usage_exception &e) {
+			throw wrong_usage_exception(
+					file + ":" + std::to_string(lineNumber) + " : " + e.what());
+		}
+	}
+	return experiments;
+}
+
+ExperimentBatch::ExperimentBatch(
+		const std::vector<RunConfig> &_experiments,
+		unsigned int _numberOfWorkers, bool _verbose) :
+		experiments(_experiments), results(_experiments.size()), numberOfWorkers(
+				_numberOfWorkers), verbose(_verbose) {
+	numberOfWorkers = ThreadBudget::getWorkers(numberOfWorkers);
+	numberOfWorkers = std::min(numberOfWorkers,
+			std::max(1u, (unsigned int) experiments.size()));
+	for (const auto &experiment : experiments) {
+		cohorts.addUser(getCohortKey(experiment));
+		normalizedData.addUser(getNormalizationKey(experiment));
+		distanceMatrices.addUser(getDistanceMatrixKey(experiment));
+	}
+}
+
+void ExperimentBatch::run() {
+	//Experiments sharing intermediate results run next to each other, so
+	//that those results are not held for long
+	std::vector<unsigned int> order(experiments.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+			[this](unsigned int i, unsigned int j) {
+				return getDistanceMatrixKey(experiments[i])
+						< getDistanceMatrixKey(experiments[j]);
+			});
+
+	std::atomic<unsigned int> next(0);
+	std::vector<std::thread> workers;
+	for (unsigned int t = 0; t < numberOfWorkers; ++t) {
+		workers.emplace_back([this, &order, &next, t]() {
+			ThreadScope threads(t, numberOfWorkers);
+			for (unsigned int i = next++; i < order.size(); i = next++) {
+				runExperiment(order[i]);
+			}
+		});
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+}
+
+std::shared_ptr<const TCGAData> ExperimentBatch::getNormalizedData(
+		const RunConfig &experiment) {
+	return normalizedData.get(getNormalizationKey(experiment),
+			[this, &experiment]() {
+				std::shared_ptr<const TCGAData> cohort = cohorts.get(
+						getCohortKey(experiment), [&experiment]() {
+							std::shared_ptr<TCGAData> data = std::make_shared<
+									TCGAData>();
+							TCGADataLoader loader(data.get(), experiment.cancers,
+									experiment.maxControlSamples,
+									experiment.maxTumorSamples, false);
+							loader.loadGeneExpressionData(experiment.sampleFile);
+							loader.loadClinicalData(experiment.clinical);
+							return std::shared_ptr<const TCGAData>(data);
+						});
+
+				std::shared_ptr<TCGAData> data = std::make_shared<TCGAData>(
+						*cohort);
+				TCGADataNormalizer tcgaNormalizer(data.get(),
+						experiment.buildNormalizer(), false);
+				tcgaNormalizer.normalize();
+				data->buildDataMatrix();
+				data->reorderSamples();
+				return std::shared_ptr<const TCGAData>(data);
+			});
+}
+
+std::shared_ptr<const Eigen::MatrixXd> ExperimentBatch::getDistanceMatrix(
+		const RunConfig &experiment,
+		const std::shared_ptr<const TCGAData> &data) {
+	return distanceMatrices.get(getDistanceMatrixKey(experiment),
+			[&experiment, &data]() {
+				return std::shared_ptr<const Eigen::MatrixXd>(
+						std::make_shared<Eigen::MatrixXd>(
+								TCGADataDistanceMatrixAnalyser::computeDistanceMatrix(
+										*data, experiment.metricName,
+										false, experiment.distanceKernelMode)));
+			});
+}
+
+void ExperimentBatch::runExperiment(unsigned int id) {
+	ScopedTimer timer("batch/experiment");
+	const RunConfig &experiment = experiments[id];
+	Result &result = results[id];
+	auto start = std::chrono::steady_clock::now();
+	try {
+		std::shared_ptr<const TCGAData> data = getNormalizedData(experiment);
+		std::shared_ptr<const Eigen::MatrixXd> distanceMatrix =
+				getDistanceMatrix(experiment, data);
+
+		//The clusterers only read the data, whose matrix is already built
+		std::unique_ptr<TCGADataClusterer> clusterer = buildTCGADataClusterer(
+				experiment.clusteringMethod, const_cast<TCGAData *>(data.get()),
+				*distanceMatrix, experiment.buildMetric(), experiment.K,
+				experiment.getClusteringSettings());
+		clusterer->computeClustering();
+		std::vector<int> clusters = clusterer->getClusters();
+		std::vector<int> realClusters =
+				TCGADataClusteringEvaluator::buildRealClusters(
+						data->getClassMapHandler(), data->getNumberOfSamples());
+		TCGADataClusteringEvaluator evaluator(clusters, realClusters,
+				distanceMatrix.get(),
+				DISTANCE_METRICS.find(experiment.metricName)
+						== DISTANCE_METRICS.end());
+		result.evaluation = evaluator.evaluate();
+	} catch (const std::exception &e) {
+		result.error = e.what();
+		std::replace(result.error.begin(), result.error.end(), '\n', ' ');
+		std::replace(result.error.begin(), result.error.end(), '\t', ' ');
+	}
+	cohorts.release(getCohortKey(experiment));
+	normalizedData.release(getNormalizationKey(experiment));
+	distanceMatrices.release(getDistanceMatrixKey(experiment));
+	result.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+
+	std::lock_guard<std::mutex> lock(outputMutex);
+	result.done = true;
+	if (verbose) {
+		unsigned int done = std::count_if(results.begin(), results.end(),
+				[](const Result &r) {
+					return r.done;
+				});
+		std::cout << "* [" << done << "/" << experiments.size()
+				<< "] experiment " << id << " ("
+				<< experiment.clusteringMethod << ", "
+				<< experiment.metricName << ", "
+				<< experiment.describeNormalization() << ", K = "
+				<< experiment.K << ") : ";
+		if (result.error.empty()) {
+			std::cout << "ARI " << result.evaluation.adjustedRandIndex;
+		} else {
+			std::cout << "failed (" << result.error << ")";
+		}
+		std::cout << " in " << result.seconds << " s" << std::endl;
+	}
+}
+
+void ExperimentBatch::exportResults(const std::string &file) const {
+	ExportStream output(file);
+	//The label column of the evaluation is the experiment number
+	std::string evaluationHeader = ClusteringEvaluation::toTSVHeader();
+	evaluationHeader.erase(0, evaluationHeader.find('\t'));
+	output << "EXPERIMENT\tCANCERS\tCLINICAL\tMAX_CONTROL\tMAX_TUMOR"
+			<< "\tNORMALIZATION\tMETRIC\tMETHOD\tK\tTRANSFORMATION\tSECONDS"
+			<< "\tSTATUS" << evaluationHeader << std::endl;
+	unsigned int numberOfEvaluationColumns = std::count(
+			evaluationHeader.begin(), evaluationHeader.end(), '\t');
+	for (unsigned int i = 0; i < experiments.size(); ++i) {
+		const RunConfig &experiment = experiments[i];
+		const Result &result = results[i];
+		output << i << "\t"
+				<< implode(experiment.cancers.begin(), experiment.cancers.end(),
+						",") << "\t"
+				<< (experiment.clinical.empty() ?
+						std::string("-") :
+						implode(experiment.clinical.begin(),
+								experiment.clinical.end(), ",")) << "\t"
+				<< experiment.maxControlSamples << "\t"
+				<< experiment.maxTumorSamples << "\t"
+				<< experiment.describeNormalization() << "\t"
+				<< experiment.metricName << "\t"
+				<< experiment.clusteringMethod << "\t" << experiment.K << "\t"
+				<< experiment.describeGraphTransformation() << "\t" << result.seconds
+				<< "\t";
+		if (result.error.empty()) {
+			std::string row = result.evaluation.toTSVRow("");
+			output << "ok" << row << std::endl;
+		} else {
+			output << result.error;
+			for (unsigned int c = 0; c < numberOfEvaluationColumns; ++c) {
+				output << "\tNA";
+			}
+			output << std::endl;
+		}
+	}
+}
+
+void ExperimentBatch::printSummary(std::ostream &output) const {
+	output << "* Experiments : " << experiments.size() << " ("
+			<< getNumberOfFailedExperiments() << " failed) on "
+			<< numberOfWorkers << " workers" << std::endl;
+	output << "* Cohorts loaded : " << cohorts.getMisses() << ", reused : "
+			<< cohorts.getHits() << std::endl;
+	output << "* Normalizations computed : " << normalizedData.getMisses()
+			<< ", reused : " << normalizedData.getHits() << std::endl;
+	output << "* Distance matrices computed : "
+			<< distanceMatrices.getMisses() << ", reused : "
+			<< distanceMatrices.getHits() << std::endl;
+}
+
+unsigned int ExperimentBatch::getNumberOfFailedExperiments() const {
+	return std::count_if(results.begin(), results.end(),
+			[](const Result &result) {
+				return !result.error.empty();
+			});
+}
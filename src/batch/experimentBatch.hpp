@@ -0,0 +1,134 @@
+/*
+ * experimentBatch.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_BATCH_EXPERIMENTBATCH_HPP_
+#define SRC_BATCH_EXPERIMENTBATCH_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <functional>
+#include <iostream>
+#include <Eigen/Dense>
+#include "../config.hpp"
+#include "../runConfig.hpp"
+#include "../tcga-analyzer/TCGAData.hpp"
+#include "../tcga-analyzer/TCGADataClusterer.hpp"
+#include "../tcga-analyzer/TCGADataClusteringEvaluator.hpp"
+
+//One experiment per line, as "-option value" pairs applied to the defaults
+//(same options as the command line).
+//"a|b" in a value expands into one experiment per alternative (every
+//combination of the alternatives of a line is run). Blank lines and lines
+//starting with # are skipped.
+std::vector<RunConfig> readExperiments(const std::string &file,
+		const RunConfig &defaults);
+
+//Results shared between experiments : the first caller of a key computes
+//it, the others wait for it. A value is dropped once all of its declared
+//users released it.
+template<typename T>
+class Memo {
+public:
+	void addUser(const std::string &key) {
+		std::lock_guard<std::mutex> lock(mutex);
+		++entries[key].users;
+	}
+
+	std::shared_ptr<const T> get(const std::string &key,
+			const std::function<std::shared_ptr<const T>()> &compute) {
+		std::unique_lock<std::mutex> lock(mutex);
+		Entry &entry = entries[key];
+		if (entry.value.valid()) {
+			std::shared_future<std::shared_ptr<const T>> value = entry.value;
+			++hits;
+			lock.unlock();
+			return value.get();
+		}
+		std::promise<std::shared_ptr<const T>> promise;
+		entry.value = promise.get_future().share();
+		++misses;
+		lock.unlock();
+		try {
+			std::shared_ptr<const T> value = compute();
+			promise.set_value(value);
+			return value;
+		} catch (...) {
+			//The experiments sharing the key fail with the same error
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+	}
+
+	void release(const std::string &key) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = entries.find(key);
+		if (it != entries.end() && --it->second.users == 0) {
+			entries.erase(it);
+		}
+	}
+
+	unsigned int getHits() const {
+		return hits;
+	}
+	unsigned int getMisses() const {
+		return misses;
+	}
+
+private:
+	struct Entry {
+		unsigned int users = 0;
+		std::shared_future<std::shared_ptr<const T>> value;
+	};
+	std::mutex mutex;
+	std::map<std::string, Entry> entries;
+	unsigned int hits = 0;
+	unsigned int misses = 0;
+};
+
+// Runs experiments on a pool of worker threads. Loaded cohorts, normalized
+// data and distance matrices are shared by the experiments with the same
+// prefix, and experiments are started in an order which keeps them close.
+class ExperimentBatch {
+public:
+	ExperimentBatch(const std::vector<RunConfig> &_experiments,
+			unsigned int _numberOfWorkers = 0, bool _verbose = true);
+	void run();
+	//One line per experiment : its parameters and its evaluation
+	void exportResults(const std::string &file) const;
+	void printSummary(std::ostream &output = std::cout) const;
+	unsigned int getNumberOfFailedExperiments() const;
+
+private:
+	struct Result {
+		ClusteringEvaluation evaluation;
+		double seconds = 0;
+		//Empty when the experiment succeeded
+		std::string error;
+		bool done = false;
+	};
+
+	std::vector<RunConfig> experiments;
+	std::vector<Result> results;
+	unsigned int numberOfWorkers;
+	bool verbose;
+
+	Memo<TCGAData> cohorts;
+	Memo<TCGAData> normalizedData;
+	Memo<Eigen::MatrixXd> distanceMatrices;
+
+	void runExperiment(unsigned int id);
+	std::shared_ptr<const TCGAData> getNormalizedData(
+			const RunConfig &experiment);
+	std::shared_ptr<const Eigen::MatrixXd> getDistanceMatrix(
+			const RunConfig &experiment,
+			const std::shared_ptr<const TCGAData> &data);
+};
+
+#endif /* SRC_BATCH_EXPERIMENTBATCH_HPP_ */
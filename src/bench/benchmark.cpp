@@ -0,0 +1,184 @@
+/*
+ * benchmark.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string formatDuration(double ns) {
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(3);
+	if (ns >= 1e9) {
+		ss << ns / 1e9 << " s";
+	} else if (ns >= 1e6) {
+		ss << ns / 1e6 << " ms";
+	} else if (ns >= 1e3) {
+		ss << ns / 1e3 << " us";
+	} else {
+		ss << ns << " ns";
+	}
+	return ss.str();
+}
+
+//Value of "key": in a line written by writeJson
+std::string jsonField(const std::string &line, const std::string &key) {
+	std::string pattern = "\"" + key + "\": ";
+	std::size_t begin = line.find(pattern);
+	if (begin == std::string::npos) {
+		return "";
+	}
+	begin += pattern.size();
+	if (line[begin] == '"') {
+		return line.substr(begin + 1, line.find('"', begin + 1) - begin - 1);
+	}
+	return line.substr(begin, line.find_first_of(",}", begin) - begin);
+}
+
+}
+
+BenchmarkSuite::BenchmarkSuite(unsigned int _warmup, unsigned int _repetitions,
+		bool _verbose) :
+		warmup(_warmup), repetitions(std::max(1u, _repetitions)), verbose(
+				_verbose) {
+}
+
+void BenchmarkSuite::add(const std::string &name, const Function &run,
+		const Function &setup) {
+	benchmarks.push_back( { name, run, setup });
+}
+
+void BenchmarkSuite::run(const std::string &filter) {
+	results.clear();
+	for (const auto &benchmark : benchmarks) {
+		if (benchmark.name.find(filter) == std::string::npos) {
+			continue;
+		}
+		if (verbose) {
+			std::cout << std::left << std::setw(40) << benchmark.name
+					<< std::flush;
+		}
+		for (unsigned int i = 0; i < warmup; ++i) {
+			if (benchmark.setup) {
+				benchmark.setup();
+			}
+			benchmark.run();
+		}
+		std::vector<double> times;
+		for (unsigned int i = 0; i < repetitions; ++i) {
+			if (benchmark.setup) {
+				benchmark.setup();
+			}
+			auto start = std::chrono::steady_clock::now();
+			benchmark.run();
+			auto end = std::chrono::steady_clock::now();
+			times.push_back(
+					std::chrono::duration<double, std::nano>(end - start).count());
+		}
+
+		BenchmarkResult result;
+		result.name = benchmark.name;
+		result.repetitions = repetitions;
+		std::sort(times.begin(), times.end());
+		result.minNs = times.front();
+		result.medianNs =
+				times.size() % 2 == 1 ?
+						times[times.size() / 2] :
+						(times[times.size() / 2 - 1] + times[times.size() / 2])
+								/ 2;
+		for (double t : times) {
+			result.meanNs += t;
+		}
+		result.meanNs /= times.size();
+		for (double t : times) {
+			result.stddevNs += (t - result.meanNs) * (t - result.meanNs);
+		}
+		result.stddevNs = std::sqrt(result.stddevNs / times.size());
+		results.push_back(result);
+
+		if (verbose) {
+			std::cout << "median " << std::setw(14)
+					<< formatDuration(result.medianNs) << " min "
+					<< std::setw(14) << formatDuration(result.minNs)
+					<< std::right << std::endl;
+		}
+	}
+}
+
+void BenchmarkSuite::writeJson(const std::string &filename) const {
+	std::ofstream outputStream(filename);
+	outputStream << std::fixed << std::setprecision(1);
+	outputStream << "{\n  \"benchmarks\": [\n";
+	for (unsigned int i = 0; i < results.size(); ++i) {
+		const BenchmarkResult &result = results[i];
+		//One benchmark per line, which is what readBaseline expects
+		outputStream << "    {\"name\": \"" << result.name
+				<< "\", \"repetitions\": " << result.repetitions
+				<< ", \"min_ns\": " << result.minNs << ", \"median_ns\": "
+				<< result.medianNs << ", \"mean_ns\": " << result.meanNs
+				<< ", \"stddev_ns\": " << result.stddevNs << "}"
+				<< (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	outputStream << "  ]\n}\n";
+	if (!outputStream) {
+		throw std::runtime_error("Cannot write " + filename);
+	}
+}
+
+std::map<std::string, double> BenchmarkSuite::readBaseline(
+		const std::string &filename) {
+	std::ifstream inputStream(filename);
+	if (!inputStream) {
+		throw std::runtime_error("Cannot read baseline " + filename);
+	}
+	std::map<std::string, double> baseline;
+	std::string line;
+	while (std::getline(inputStream, line)) {
+		std::string name = jsonField(line, "name");
+		std::string median = jsonField(line, "median_ns");
+		if (!name.empty() && !median.empty()) {
+			baseline[name] = std::stod(median);
+		}
+	}
+	return baseline;
+}
+
+unsigned int BenchmarkSuite::compare(
+		const std::map<std::string, double> &baseline, double tolerance,
+		std::ostream &output) const {
+	unsigned int regressions = 0;
+	std::streamsize precision = output.precision();
+	output << std::left << std::setw(40) << "Benchmark" << std::setw(16)
+			<< "Median" << std::setw(16) << "Baseline" << "Ratio" << std::endl;
+	for (const auto &result : results) {
+		auto it = baseline.find(result.name);
+		output << std::setw(40) << result.name << std::setw(16)
+				<< formatDuration(result.medianNs);
+		if (it == baseline.end() || it->second <= 0) {
+			output << "(new)" << std::endl;
+			continue;
+		}
+		double ratio = result.medianNs / it->second;
+		output << std::setw(16) << formatDuration(it->second) << std::fixed
+				<< std::setprecision(2) << ratio << std::defaultfloat;
+		if (ratio > 1 + tolerance) {
+			output << "  REGRESSION";
+			++regressions;
+		} else if (ratio < 1 - tolerance) {
+			output << "  improved";
+		}
+		output << std::endl;
+	}
+	output << std::right << std::setprecision(precision);
+	return regressions;
+}
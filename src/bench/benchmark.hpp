@@ -0,0 +1,65 @@
+/*
+ * benchmark.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_BENCH_BENCHMARK_HPP_
+#define SRC_BENCH_BENCHMARK_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <iostream>
+
+struct BenchmarkResult {
+	std::string name;
+	unsigned int repetitions = 0;
+	double minNs = 0;
+	double medianNs = 0;
+	double meanNs = 0;
+	double stddevNs = 0;
+};
+
+// Runs named benchmarks with warm-up and repetitions, and compares the
+// median times with a baseline written by a previous run (writeJson).
+class BenchmarkSuite {
+public:
+	typedef std::function<void()> Function;
+
+	BenchmarkSuite(unsigned int _warmup = 1, unsigned int _repetitions = 5,
+			bool _verbose = true);
+	//setup runs before every repetition and is not timed
+	void add(const std::string &name, const Function &run,
+			const Function &setup = nullptr);
+	//Only the benchmarks whose name contains filter
+	void run(const std::string &filter = "");
+	const std::vector<BenchmarkResult> &getResults() const {
+		return results;
+	}
+
+	void writeJson(const std::string &filename) const;
+	//name -> median time (ns) of a file written by writeJson
+	static std::map<std::string, double> readBaseline(
+			const std::string &filename);
+	//Prints the comparison and returns the number of benchmarks slower than
+	//the baseline by more than tolerance (relative)
+	unsigned int compare(const std::map<std::string, double> &baseline,
+			double tolerance, std::ostream &output = std::cout) const;
+
+private:
+	struct Benchmark {
+		std::string name;
+		Function run;
+		Function setup;
+	};
+
+	unsigned int warmup;
+	unsigned int repetitions;
+	bool verbose;
+	std::vector<Benchmark> benchmarks;
+	std::vector<BenchmarkResult> results;
+};
+
+#endif /* SRC_BENCH_BENCHMARK_HPP_ */
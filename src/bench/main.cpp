@@ -0,0 +1,330 @@
+/*
+ * main.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <memory>
+#include <queue>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <ClusterXX/metrics/metrics.hpp>
+#include "benchmark.hpp"
+#include "../command_line_processor.hpp"
+#include "../config.hpp"
+#include "../utilities.hpp"
+#include "../generator/syntheticDataGenerator.hpp"
+#include "../heinz-analyzer/graph.hpp"
+#include "../heinz-analyzer/heinzModuleAnalyzer.hpp"
+#include "../tcga-analyzer/TCGA-Analyzer.hpp"
+
+namespace {
+
+const std::string GRAPH_NODE_FILE = "biogrid-nodes-tcga.txt";
+const std::string GRAPH_EDGE_FILE = "biogrid-edges-tcga.txt";
+const std::string MODULE_BASENAME = "1_BRCA_Tumor_BENCH";
+
+//Runs TCGA-Analyzer in-process, without its output
+void runAnalyzer(const std::vector<std::string> &arguments) {
+	std::vector<std::string> argvStrings = { "TCGA-Analyzer" };
+	argvStrings.insert(argvStrings.end(), arguments.begin(), arguments.end());
+	std::vector<char *> argv;
+	for (auto &s : argvStrings) {
+		argv.push_back(&s[0]);
+	}
+	std::ostringstream sink;
+	std::streambuf *coutBuffer = std::cout.rdbuf(sink.rdbuf());
+	try {
+		CommandLineProcessor clp(argv.size(), argv.data());
+		clp.runProgram();
+	} catch (...) {
+		std::cout.rdbuf(coutBuffer);
+		throw;
+	}
+	std::cout.rdbuf(coutBuffer);
+}
+
+//Heinz-like module : a breadth-first neighbourhood of the busiest node
+void writeModule(const PPIGraph &graph, unsigned int size) {
+	unsigned int start = 0;
+	for (unsigned int u = 0; u < graph.size(); ++u) {
+		if (graph.getOutDegree(u) > graph.getOutDegree(start)) {
+			start = u;
+		}
+	}
+	std::vector<int> moduleId(graph.size(), -1);
+	std::vector<unsigned int> nodes;
+	std::queue<unsigned int> queue;
+	queue.push(start);
+	moduleId[start] = 0;
+	while (!queue.empty() && nodes.size() < size) {
+		unsigned int u = queue.front();
+		queue.pop();
+		nodes.push_back(u);
+		for (auto it = graph.neighborsBegin(u); it != graph.neighborsEnd(u);
+				++it) {
+			if (moduleId[*it] < 0) {
+				moduleId[*it] = 0;
+				queue.push(*it);
+			}
+		}
+	}
+	std::fill(moduleId.begin(), moduleId.end(), -1);
+	for (unsigned int i = 0; i < nodes.size(); ++i) {
+		moduleId[nodes[i]] = i;
+	}
+
+	mkdir((HEINZ_RAW_OUTPUT_DIRECTORY + "1").c_str(), 0755);
+	std::ofstream output(HEINZ_RAW_OUTPUT_DIRECTORY + "1/" + MODULE_BASENAME
+			+ ".txt");
+	output << "graph G {\n";
+	for (unsigned int i = 0; i < nodes.size(); ++i) {
+		output << i << " [label=\"" << graph.getNodeName(nodes[i]) << "\\n"
+				<< (i % 3 == 0 ? "-1" : "1") << "\\n\"];\n";
+	}
+	for (unsigned int i = 0; i < nodes.size(); ++i) {
+		for (auto it = graph.neighborsBegin(nodes[i]);
+				it != graph.neighborsEnd(nodes[i]); ++it) {
+			if (moduleId[*it] > (int) i) {
+				output << i << " -- " << moduleId[*it] << "\n";
+			}
+		}
+	}
+	output << "}\n";
+}
+
+}
+
+// Usage : TCGA-Analyzer-bench [-option value]...
+// -workdir (generated data), -genes, -tumor, -control (per cancer),
+// -warmup, -repetitions, -filter (substring of the benchmark names),
+// -output (JSON results), -baseline (JSON of a previous run), -tolerance
+int main(int argc, char *argv[]) {
+	if (argc % 2 != 1) {
+		throw wrong_usage_exception(
+				"Invalid command line : number of arguments should be an odd number.");
+	}
+
+	SyntheticDataParameters dataParameters;
+	dataParameters.outputDirectory = "bench-data";
+	dataParameters.numberOfGenes = 5000;
+	dataParameters.tumorSamples = 50;
+	dataParameters.controlSamples = 10;
+	unsigned int warmup = 1;
+	unsigned int repetitions = 5;
+	std::string filter;
+	std::string outputFile;
+	std::string baselineFile;
+	double tolerance = 0.1;
+	for (int i = 1; i < argc; i += 2) {
+		std::string optionName = argv[i];
+		std::string optionValue = argv[i + 1];
+		if (optionName == "-workdir") {
+			dataParameters.outputDirectory = optionValue;
+		} else if (optionName == "-genes") {
+			dataParameters.numberOfGenes = std::atoi(optionValue.c_str());
+		} else if (optionName == "-tumor") {
+			dataParameters.tumorSamples = std::atoi(optionValue.c_str());
+		} else if (optionName == "-control") {
+			dataParameters.controlSamples = std::atoi(optionValue.c_str());
+		} else if (optionName == "-warmup") {
+			warmup = std::atoi(optionValue.c_str());
+		} else if (optionName == "-repetitions") {
+			repetitions = std::atoi(optionValue.c_str());
+		} else if (optionName == "-filter") {
+			filter = optionValue;
+		} else if (optionName == "-output") {
+			outputFile = optionValue;
+		} else if (optionName == "-baseline") {
+			baselineFile = optionValue;
+		} else if (optionName == "-tolerance") {
+			tolerance = std::atof(optionValue.c_str());
+		} else {
+			throw wrong_usage_exception(
+					"Unknown command line option '" + optionName + "'.");
+		}
+	}
+	//Read before moving to the data directory
+	std::map<std::string, double> baseline;
+	if (!baselineFile.empty()) {
+		baseline = BenchmarkSuite::readBaseline(baselineFile);
+	}
+	char currentDirectory[4096];
+	if (getcwd(currentDirectory, sizeof(currentDirectory)) == nullptr) {
+		throw std::runtime_error("Cannot read the current directory");
+	}
+	if (!outputFile.empty() && outputFile[0] != '/') {
+		outputFile = std::string(currentDirectory) + "/" + outputFile;
+	}
+
+	std::cout << "--------------------------------------" << std::endl;
+	std::cout << "|         TCGA-ANALYZER-BENCH        |" << std::endl;
+	std::cout << "--------------------------------------" << std::endl;
+	std::cout << "* Data : " << dataParameters.outputDirectory << " ("
+			<< dataParameters.numberOfGenes << " genes, "
+			<< dataParameters.tumorSamples << " tumor and "
+			<< dataParameters.controlSamples << " control samples per cancer)"
+			<< std::endl;
+	std::cout << "* Warm-up / repetitions : " << warmup << " / "
+			<< repetitions << std::endl;
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	SyntheticDataGenerator generator(dataParameters, false);
+	generator.generate();
+	if (chdir(dataParameters.outputDirectory.c_str()) != 0) {
+		throw std::runtime_error(
+				"Cannot move to " + dataParameters.outputDirectory);
+	}
+
+	std::set<std::string> cancers = dataParameters.cancers;
+	std::string cancerList = implode(cancers.begin(), cancers.end(), ",");
+	std::string maxTumor = std::to_string(dataParameters.tumorSamples);
+	std::string maxControl = std::to_string(dataParameters.controlSamples);
+	auto loadData = [&](TCGAData *data) {
+		TCGADataLoader loader(data, cancers, dataParameters.controlSamples,
+				dataParameters.tumorSamples, false);
+		loader.loadGeneExpressionData(SAMPLE_TCGA_FILE);
+	};
+
+	TCGAData rawData;
+	loadData(&rawData);
+	TCGAData normalizedData = rawData;
+	TCGADataNormalizer(&normalizedData,
+			std::make_shared<BinaryQuantileNormalizer>(0.995), false).normalize();
+	normalizedData.buildDataMatrix();
+	std::shared_ptr<const PPIGraph> graph = PPIGraph::buildFromFile(
+			GRAPH_DATA_DIRECTORY + GRAPH_NODE_FILE,
+			GRAPH_DATA_DIRECTORY + GRAPH_EDGE_FILE);
+	writeModule(*graph, 500);
+	std::cout << std::endl;
+
+	BenchmarkSuite suite(warmup, repetitions);
+
+	/* Micro-benchmarks */
+	std::string line;
+	for (unsigned int i = 0; i < 10000; ++i) {
+		line += "GENE" + std::to_string(i) + "|" + std::to_string(100000 + i)
+				+ (i % 2 ? '\t' : '-');
+	}
+	suite.add("split", [&]() {
+		split(line, { '\t', '-', '|' });
+	});
+
+	suite.add("parse/loader", [&]() {
+		TCGAData data;
+		loadData(&data);
+	});
+	suite.add("parse/graph", [&]() {
+		PPIGraph::buildFromTextFiles(GRAPH_DATA_DIRECTORY + GRAPH_NODE_FILE,
+				GRAPH_DATA_DIRECTORY + GRAPH_EDGE_FILE);
+	});
+
+	std::vector<double> sample = rawData.getPatientRNASeqData(0);
+	std::vector<double> normalizerInput;
+	suite.add("normalizer/binary-quantile", [&]() {
+		BinaryQuantileNormalizer(0.995).normalize(&normalizerInput);
+	}, [&]() {
+		normalizerInput = sample;
+	});
+	suite.add("normalizer/kmeans", [&]() {
+		KMeansNormalizer(2, 1000).normalize(&normalizerInput);
+	}, [&]() {
+		normalizerInput = sample;
+	});
+
+	for (const std::string metricName : { "pearson", "spearman", "euclidean",
+			"manhattan", "cosine", "jaccard" }) {
+		std::shared_ptr<ClusterXX::Metric> metric = ClusterXX::buildMetric(
+				metricName);
+		suite.add("distance/" + metricName, [&normalizedData, metricName]() {
+			TCGADataDistanceMatrixAnalyser(&normalizedData, metricName, false).computeDistanceMatrix();
+		});
+		suite.add("distance-float/" + metricName, [&normalizedData, metricName]() {
+			TCGADataDistanceMatrixAnalyser(&normalizedData, metricName, false,
+					DistanceKernels::NATIVE_FLOAT).computeDistanceMatrix();
+		});
+		suite.add("distance-clusterxx/" + metricName, [&normalizedData, metric]() {
+			TCGADataDistanceMatrixAnalyser(&normalizedData, metric, false).computeDistanceMatrix();
+		});
+	}
+
+	std::shared_ptr<ClusterXX::Metric> pearson = ClusterXX::buildMetric(
+			"pearson");
+	TCGADataDistanceMatrixAnalyser distanceAnalyzer(&normalizedData, pearson,
+			false);
+	distanceAnalyzer.computeDistanceMatrix();
+	const Eigen::MatrixXd &distanceMatrix =
+			distanceAnalyzer.getDistanceMatrixHandler();
+	auto graphTransformation = std::make_pair(
+			ClusterXX::SpectralParameters::GraphTransformationMethod::K_NEAREST_NEIGHBORS,
+			3.0);
+	suite.add("clustering/kmeans", [&]() {
+		TCGADataKMeansClusterer clusterer(&normalizedData, 0, 1000, 10, false);
+		clusterer.computeClustering();
+	});
+	suite.add("clustering/hierarchical", [&]() {
+		TCGADataHierarchicalClusterer clusterer(&normalizedData, distanceMatrix,
+				pearson, 0, ClusterXX::HierarchicalParameters::COMPLETE, false);
+		clusterer.computeClustering();
+	});
+	suite.add("clustering/unnormalized-spectral", [&]() {
+		TCGADataUnnormalizedSpectralClusterer clusterer(&normalizedData,
+				distanceMatrix, pearson, 0, graphTransformation, false);
+		clusterer.computeClustering();
+	});
+	suite.add("clustering/normalized-spectral", [&]() {
+		TCGADataNormalizedSpectralClusterer clusterer(&normalizedData,
+				distanceMatrix, pearson, 0, graphTransformation, false);
+		clusterer.computeClustering();
+	});
+	suite.add("clustering/random-walk-spectral", [&]() {
+		TCGADataNormalizedSpectralClusterer_RandomWalk clusterer(
+				&normalizedData, distanceMatrix, pearson, 0,
+				graphTransformation, false);
+		clusterer.computeClustering();
+	});
+
+	suite.add("heinz/build-module", [&]() {
+		HeinzModuleAnalyzer(MODULE_BASENAME, graph);
+	});
+
+	/* End-to-end runs of the program modes */
+	std::vector<std::string> dataOptions = { "-cancers", cancerList,
+			"-maxtumor", maxTumor, "-maxcontrol", maxControl, "-verbose", "0" };
+	for (const std::string mode : { "0", "1", "2" }) {
+		std::vector<std::string> arguments = { "-mode", mode };
+		arguments.insert(arguments.end(), dataOptions.begin(),
+				dataOptions.end());
+		if (mode == "0") {
+			//Cached artifacts would turn the repetitions into cache reads
+			arguments.insert(arguments.end(), { "-cache", "0" });
+		}
+		if (mode == "2") {
+			arguments.insert(arguments.end(), { "-weights", "1,2" });
+		}
+		suite.add("end-to-end/mode-" + mode, [arguments]() {
+			runAnalyzer(arguments);
+		});
+	}
+
+	suite.run(filter);
+
+	if (!outputFile.empty()) {
+		suite.writeJson(outputFile);
+		std::cout << std::endl << "Results written to " << outputFile
+				<< std::endl;
+	}
+	if (!baselineFile.empty()) {
+		std::cout << std::endl;
+		unsigned int regressions = suite.compare(baseline, tolerance);
+		std::cout << std::endl << regressions << " regression(s) above "
+				<< tolerance * 100 << "%." << std::endl;
+		return regressions == 0 ? 0 : 1;
+	}
+	return 0;
+}
@@ -7,11 +7,26 @@
 
 #include <iostream>
 #include <set>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
 #include <ClusterXX/metrics/metrics.hpp>
 #include "command_line_processor.hpp"
 #include "config.hpp"
+#include "runConfig.hpp"
+#include "heinz-analyzer/heinzJobScheduler.hpp"
 #include "heinz-analyzer/heinzModuleAnalyzer.hpp"
-#include "parameters.hpp"
+#include "heinz-analyzer/heinzModuleSearch.hpp"
+#include "heinz-analyzer/heinzOutputAnalyzer.hpp"
+#include "heinz-analyzer/moduleSimilarity.hpp"
+#include "heinz-analyzer/positiveComponents.hpp"
+#include "batch/experimentBatch.hpp"
+#include "pipeline/pipeline.hpp"
+#include "server/analyzerServer.hpp"
+#include "exportWriter.hpp"
+#include "threads.hpp"
+#include "trace.hpp"
+#include "memory.hpp"
 #include "utilities.hpp"
 #include "tcga-analyzer/TCGA-Analyzer.hpp"
 
@@ -22,343 +37,739 @@ CommandLineProcessor::CommandLineProcessor(int argc, char *argv[]) {
 	}
 
 	for (int i = 1; i < argc; i += 2) {
-		process(argv[i], argv[i + 1]);
+		config.set(argv[i], argv[i + 1]);
+	}
+
+	//Checked once all options are known, whatever their order
+	if (config.minPositiveComponent > 0
+			&& config.normalizationMethod != BINARY_QUANTILE_NORMALIZATION) {
+		throw wrong_usage_exception(
+				"-mincomponent option requires the binary quantile normalization (-normalization 1).");
 	}
 }
 
-void CommandLineProcessor::process(const std::string &optionName,
-		const std::string &optionValue) {
-	if (optionName == "-mode") {
-		if (std::isdigit(optionValue[0])) {
-			int i = std::atoi(optionValue.c_str());
-			if (i >= 0 && i <= 2) {
-				PROGRAM_MODE = i;
-			} else {
-				throw wrong_usage_exception(
-						"-mode option value should be a digit between 0 and 2.");
+const RunConfig &CommandLineProcessor::getConfig() const {
+	return config;
+}
 
-			}
-		} else {
-			throw wrong_usage_exception(
-					"-mode option value should be a digit between 0 and 2.");
-		}
+//What the loaded data and the matrices of the current mode should take
+unsigned long long estimateMemory(const RunConfig &config,
+		unsigned int numberOfGenes,
+		unsigned int numberOfSamples) {
+	unsigned long long rnaSeqData = TCGAData::estimateRNASeqDataBytes(
+			numberOfGenes, numberOfSamples);
+	unsigned long long estimate = rnaSeqData
+			+ TCGAData::estimateDataMatrixBytes(numberOfGenes,
+					numberOfSamples);
+	//The distance matrix, and about as much again for the similarity graph,
+	//Laplacian and eigenvectors of the spectral clusterers
+	unsigned long long clustering = 4
+			* TCGADataDistanceMatrixAnalyser::estimateDistanceMatrixBytes(
+					numberOfSamples);
+	if (config.programMode == 0 || config.programMode == 8) {
+		//The pipeline keeps the cohort next to its normalized copy
+		estimate += rnaSeqData
+				+ TCGAData::estimateDataMatrixBytes(numberOfGenes,
+						numberOfSamples) + clustering;
+	} else if (config.programMode == 1) {
+		//Copy of the data restored after each cut percentage
+		estimate += rnaSeqData + clustering;
+	} else if (config.programMode == 3) {
+		estimate += clustering
+				+ TCGADataConsensusClusterer::estimateMemory(numberOfSamples,
+						config.consensusMinK, config.consensusMaxK);
+	} else if (config.programMode == 7) {
+		//Module distances of one weight and their running mean
+		estimate += clustering
+				+ TCGADataDistanceMatrixAnalyser::estimateDistanceMatrixBytes(
+						numberOfSamples);
+	} else if (config.programMode == 10) {
+		//A tumor and a control class per cancer without clinical attributes.
+		//Clinical attributes split the classes further : the analyzer checks
+		//again once its comparisons are built.
+		unsigned int classes = 2 * config.cancers.size();
+		unsigned int comparisons =
+				config.differentialComparisons == TUMOR_VERSUS_CONTROL ?
+						config.cancers.size() : classes * (classes - 1) / 2;
+		estimate += TCGADataDifferentialAnalyzer::estimateMemory(
+				numberOfGenes, comparisons);
 	}
+	return estimate;
+}
 
-	else if (optionName == "-cancers") {
-		CANCERS.clear();
-		std::vector<std::string> cancers = split(optionValue, { ',' });
-		for (const auto &s : cancers) {
-			if (ALLOWED_CANCERS.find(s) != ALLOWED_CANCERS.end()) {
-				CANCERS.insert(s);
-			} else {
-				throw wrong_usage_exception(
-						"Error when trying to process cancer with name '" + s
-								+ "'. -cancers must be a subset of "
-								+ implode(ALLOWED_CANCERS.begin(),
-										ALLOWED_CANCERS.end(), ","));
-			}
-		}
-		if (CANCERS.find("SARCB") != CANCERS.end()) {
-			if (CANCERS.size() != 1) {
-				throw wrong_usage_exception(
-						"Cannot mix Bergonie samples and TCGA samples.");
-			}
-			//Use the right graph
-			else {
-				GRAPH_NODE_FILE = GRAPH_NODE_FILE_BERGONIE;
-				GRAPH_EDGE_FILE = GRAPH_EDGE_FILE_BERGONIE;
-				SAMPLE_FILE = SAMPLE_BERGONIE_FILE;
-			}
-		}
-	}
+void checkMemory(const RunConfig &config, const TCGADataLoader &loader) {
+	unsigned int numberOfGenes = TCGADataLoader::countGenes(config.sampleFile);
+	unsigned int numberOfSamples = loader.countSamples();
+	unsigned long long estimate = estimateMemory(config, numberOfGenes,
+			numberOfSamples);
+	unsigned long long limit = MemoryMonitor::getLimit();
+	std::cout << "* Genes x samples : " << numberOfGenes << " x "
+			<< numberOfSamples << std::endl;
+	std::cout << "* Estimated memory : " << MemoryMonitor::formatBytes(estimate)
+			<< std::endl;
+	std::cout << "* Memory limit : "
+			<< (limit == 0 ?
+					std::string("unknown") :
+					MemoryMonitor::formatBytes(limit)
+							+ (config.memoryLimitMB == 0 ?
+									" (available)" : " (-memlimit)"))
+			<< std::endl;
+	MemoryMonitor::checkEstimate(estimate);
+}
 
-	else if (optionName == "-clinical") {
-		std::vector<std::string> clinicalAttributes = split(optionValue,
-				{ ',' });
-		for (const auto &attribute : clinicalAttributes) {
-			CLINICAL.insert(attribute);
-		}
-	}
+void printDataParameters(const RunConfig &config) {
+	std::cout << "------------------- Data Parameters --------------------"
+			<< std::endl;
+	std::cout << "* Cancers : "
+			<< implode(config.cancers.begin(), config.cancers.end(), ", ") << std::endl;
+	std::cout << "* Clinical attributes : "
+			<< implode(config.clinical.begin(), config.clinical.end(), ", ") << std::endl;
+	std::cout << "* Max control samples : " << config.maxControlSamples
+			<< std::endl;
+	std::cout << "* Max tumor samples : " << config.maxTumorSamples << std::endl;
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+}
 
-	else if (optionName == "-weights") {
-		WEIGHTS.clear();
-		std::vector<std::string> weights = split(optionValue, { ',' });
-		for (const auto &s : weights) {
-			double d = std::atof(s.c_str());
-			if (d <= 0) {
-				throw wrong_usage_exception(
-						"Error when trying to process weight '" + s
-								+ "'. -weights should be a comma-separated list of weights (without the minus sign).");
-			}
-			WEIGHTS.push_back(d);
-		}
+void printNormalizationParameters(const RunConfig &config) {
+	std::cout << "-------------- Normalization parameters ----------------"
+			<< std::endl;
+	if (config.normalizationMethod == KMEANS_NORMALIZATION) {
+		std::cout << "* Normalization method : K-Means" << std::endl;
+		std::cout << "* K : " << config.kMeansNormalizationK << std::endl;
+		std::cout << "* Max iterations : " << config.kMeansMaxIterations
+				<< std::endl;
+	} else if (config.normalizationMethod == BINARY_QUANTILE_NORMALIZATION) {
+		std::cout << "* Normalization method : Binary quantile"
+				<< std::endl;
+		std::cout << "* Binary quantile cut percentage : "
+				<< config.binaryQuantileCutPercentage << std::endl;
+	} else {
+		std::cout << "* Normalization method : no normalization"
+				<< std::endl;
 	}
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+}
 
-	else if (optionName == "-maxcontrol") {
-		MAX_CONTROL_SAMPLES = std::atoi(optionValue.c_str());
-	}
+//The "cohort" and "normalized" stages, normalized samples ordered by class
+void addDataStages(Pipeline *pipeline, const RunConfig &config,
+		const std::string &fingerprint) {
+	pipeline->addStage<TCGAData>("cohort", { },
+			config.describeCohort() + " " + fingerprint,
+			[&config](const Pipeline::Inputs &) {
+				std::shared_ptr<TCGAData> data = std::make_shared<TCGAData>();
+				TCGADataLoader loader(data.get(), config.cancers,
+						config.maxControlSamples, config.maxTumorSamples,
+						config.verbose);
+				loader.loadGeneExpressionData(config.sampleFile);
+				loader.loadClinicalData(config.clinical);
+				return data;
+			});
+	pipeline->addStage<TCGAData>("normalized", { "cohort" },
+			config.describeNormalization(),
+			[&config](const Pipeline::Inputs &inputs) {
+				std::shared_ptr<TCGAData> data = std::make_shared<TCGAData>(
+						inputs.get<TCGAData>(0));
+				TCGADataNormalizer tcgaNormalizer(data.get(),
+						config.buildNormalizer(), config.verbose);
+				tcgaNormalizer.normalize();
+				data->buildDataMatrix();
+				data->reorderSamples();
+				return data;
+			});
+}
 
-	else if (optionName == "-maxtumor") {
-		MAX_TUMOR_SAMPLES = std::atoi(optionValue.c_str());
-	}
+//Mode 0 : each stage is only run when its cached artifact is missing or stale
+void runClusteringPipeline(const RunConfig &config) {
+	printDataParameters(config);
+	printNormalizationParameters(config);
 
-	else if (optionName == "-verbose") {
-		VERBOSE = std::atoi(optionValue.c_str());
+	std::cout << "---------------- Clustering parameters -----------------"
+			<< std::endl;
+	if (config.K == 0) {
+		std::cout
+				<< "Number of clusters to find : automatic (= number of real classes in the data)"
+				<< std::endl;
+	} else {
+		std::cout << "Number of clusters to find : " << config.K << std::endl;
 	}
-
-	else if (optionName == "-k") {
-		K_CLUSTER = std::atoi(optionValue.c_str());
+	std::cout << "* Metric : " << config.buildMetric()->toString() << std::endl;
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	std::cout << "----------------------- Pipeline -----------------------"
+			<< std::endl;
+	std::cout << "* Cache : "
+			<< (config.pipelineCache ? CACHE_DIRECTORY : std::string("disabled"))
+			<< std::endl;
+	TCGAData countedData;
+	TCGADataLoader countingLoader(&countedData, config.cancers, config.maxControlSamples,
+			config.maxTumorSamples, false);
+	checkMemory(config, countingLoader);
+
+	std::ostringstream kMeansParameters;
+	kMeansParameters << config.K << " " << config.kMeansMaxIterations << " "
+			<< config.parallelKMeans;
+	std::ostringstream spectralParameters;
+	spectralParameters << std::setprecision(17) << config.K << " "
+			<< config.graphTransformation.first << " "
+			<< config.graphTransformation.second;
+
+	Pipeline pipeline(CACHE_DIRECTORY, config.pipelineCache, config.verbose);
+	addDataStages(&pipeline, config,
+			countingLoader.getFingerprint(config.sampleFile));
+	//The stages below run concurrently, hence quiet
+	pipeline.addStage<Eigen::MatrixXd>("distance-matrix", { "normalized" },
+			config.metricName + " "
+					+ std::to_string(config.distanceKernelMode),
+			[&config](const Pipeline::Inputs &inputs) {
+				return std::make_shared<Eigen::MatrixXd>(
+						TCGADataDistanceMatrixAnalyser::computeDistanceMatrix(
+								inputs.get<TCGAData>(0), config.metricName, false,
+								config.distanceKernelMode));
+			});
+	//The clusterers only read the data, whose matrix is already built
+	pipeline.addStage<std::vector<int>>("kmeans", { "normalized" },
+			kMeansParameters.str(), [&config](const Pipeline::Inputs &inputs) {
+				TCGAData &data = const_cast<TCGAData &>(inputs.get<TCGAData>(0));
+				TCGADataKMeansClusterer clusterer(&data, config.K,
+						config.kMeansMaxIterations, config.parallelKMeans, false);
+				clusterer.computeClustering();
+				return std::make_shared<std::vector<int>>(clusterer.getClusters());
+			});
+	pipeline.addStage<std::vector<int>>("unnormalized-spectral", {
+			"normalized", "distance-matrix" }, spectralParameters.str(),
+			[&config](const Pipeline::Inputs &inputs) {
+				TCGAData &data = const_cast<TCGAData &>(inputs.get<TCGAData>(0));
+				TCGADataUnnormalizedSpectralClusterer clusterer(&data,
+						inputs.get<Eigen::MatrixXd>(1), config.buildMetric(), config.K,
+						config.graphTransformation, false);
+				clusterer.computeClustering();
+				return std::make_shared<std::vector<int>>(clusterer.getClusters());
+			});
+	pipeline.addStage<std::vector<int>>("normalized-spectral", {
+			"normalized", "distance-matrix" }, spectralParameters.str(),
+			[&config](const Pipeline::Inputs &inputs) {
+				TCGAData &data = const_cast<TCGAData &>(inputs.get<TCGAData>(0));
+				TCGADataNormalizedSpectralClusterer clusterer(&data,
+						inputs.get<Eigen::MatrixXd>(1), config.buildMetric(), config.K,
+						config.graphTransformation, false);
+				clusterer.computeClustering();
+				return std::make_shared<std::vector<int>>(clusterer.getClusters());
+			});
+
+	//The normalized data gives the real classes of the samples
+	pipeline.run( { "normalized", "distance-matrix", "kmeans",
+			"unnormalized-spectral", "normalized-spectral" });
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	std::shared_ptr<const TCGAData> data = pipeline.get<TCGAData>("normalized");
+	std::shared_ptr<const Eigen::MatrixXd> distanceMatrix = pipeline.get<
+			Eigen::MatrixXd>("distance-matrix");
+	std::vector<std::string> classLabels;
+	std::vector<int> realClusters =
+			TCGADataClusteringEvaluator::buildRealClusters(
+					data->getClassMapHandler(), data->getNumberOfSamples(),
+					&classLabels);
+	bool isSimilarity = (DISTANCE_METRICS.find(config.metricName)
+			== DISTANCE_METRICS.end());
+
+	std::vector<std::pair<std::string, std::string>> clusterings = { {
+			"------------------ KMeans Clustering -------------------",
+			"kmeans" }, {
+			"---------- Unnormalized Spectral Clustering ------------",
+			"unnormalized-spectral" }, {
+			"------ Normalized Spectral Clustering (Symmetric) ------",
+			"normalized-spectral" } };
+	for (const auto &clustering : clusterings) {
+		std::cout << clustering.first << std::endl;
+		std::shared_ptr<const std::vector<int>> clusters = pipeline.get<
+				std::vector<int>>(clustering.second);
+		TCGADataClusteringEvaluator evaluator(*clusters, realClusters,
+				distanceMatrix.get(), isSimilarity);
+		ClusteringEvaluation evaluation = evaluator.evaluate();
+		evaluator.printClusteringMatrix(classLabels);
+		std::cout << std::endl << "Adjusted Rand Index : "
+				<< evaluation.adjustedRandIndex << std::endl;
+		TCGADataClusteringEvaluator::exportEvaluation(evaluation,
+				clustering.second + "_" + config.metricName);
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
 	}
 
-	else if (optionName == "-normalization") {
-		if (std::isdigit(optionValue[0])) {
-			int i = std::atoi(optionValue.c_str());
-			//Default is 1
-			if (i == 0) {
-				DEFAULT_NORMALIZATION_METHOD = KMEANS_NORMALIZATION;
-			} else if (i == 2) {
-				DEFAULT_NORMALIZATION_METHOD = NO_NORMALIZATION;
-			} else if (i != 1) {
-				throw wrong_usage_exception(
-						"-normalization option value should be a digit between 0 and 2.");
+	std::cout << "------------------- Pipeline stages --------------------"
+			<< std::endl;
+	pipeline.printSummary();
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+}
 
-			}
-		} else {
-			throw wrong_usage_exception(
-					"-normalization option value should be a digit between 0 and 2.");
-		}
+//Mode 8 : the cohort is loaded once and queried over config.serverSocket
+void runServer(const RunConfig &config) {
+	printDataParameters(config);
+	printNormalizationParameters(config);
+
+	std::cout << "------------------ Server parameters -------------------"
+			<< std::endl;
+	std::cout << "* Socket : " << config.serverSocket << std::endl;
+	std::cout << "* Workers : " << ThreadBudget::getWorkers(config.serverWorkers)
+			<< std::endl;
+	std::cout << "* Preloaded metric : " << config.metricName << std::endl;
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	std::cout << "-------------------- Loading data ----------------------"
+			<< std::endl;
+	TCGAData countedData;
+	TCGADataLoader countingLoader(&countedData, config.cancers, config.maxControlSamples,
+			config.maxTumorSamples, false);
+	checkMemory(config, countingLoader);
+	Pipeline pipeline(CACHE_DIRECTORY, config.pipelineCache, config.verbose);
+	addDataStages(&pipeline, config,
+			countingLoader.getFingerprint(config.sampleFile));
+	pipeline.run( { "normalized" });
+	std::shared_ptr<const PPIGraph> graph;
+	if (std::ifstream(GRAPH_DATA_DIRECTORY + config.graphNodeFile).good()) {
+		graph = PPIGraph::buildFromFile(GRAPH_DATA_DIRECTORY + config.graphNodeFile,
+				GRAPH_DATA_DIRECTORY + config.graphEdgeFile);
+		std::cout << "* Graph : " << graph->size() << " nodes" << std::endl;
+	} else {
+		std::cout << "* Graph : not found, neighbors requests are refused"
+				<< std::endl;
 	}
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	AnalyzerServer server(pipeline.get<TCGAData>("normalized"), graph,
+			config.getClusteringSettings(), config.serverWorkers, config.verbose);
+
+	std::cout << "------------------------ Server ------------------------"
+			<< std::endl;
+	server.preload(config.metricName);
+	server.run(config.serverSocket);
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+}
 
-	else if (optionName == "-cutpercentage") {
-		BINARY_QUANTILE_NORMALIZATION_PARAM = std::atof(optionValue.c_str());
-		if (BINARY_QUANTILE_NORMALIZATION_PARAM < 0
-				|| BINARY_QUANTILE_NORMALIZATION_PARAM > 1) {
-			throw wrong_usage_exception(
-					"Error while processing " + optionName + " " + optionValue
-							+ ".\n The cut percentage should be between 0 and 1");
-		}
-	}
+//Mode 9 : the command line options are the defaults of the experiments
+void runBatch(const RunConfig &config) {
+	std::vector<RunConfig> experiments = readExperiments(
+			config.experimentsFile, config);
+	std::string resultsFile = EXPORT_DIRECTORY + "batch-results.tsv";
+
+	std::cout << "------------------- Batch parameters -------------------"
+			<< std::endl;
+	std::cout << "* Experiment file : " << config.experimentsFile << " ("
+			<< experiments.size() << " experiments)" << std::endl;
+	std::cout << "* Workers : " << ThreadBudget::getWorkers(config.batchJobs)
+			<< std::endl;
+	std::cout << "* Results : " << resultsFile << std::endl;
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	std::cout << "--------------------- Experiments ----------------------"
+			<< std::endl;
+	ExperimentBatch batch(experiments, config.batchJobs, config.verbose);
+	batch.run();
+	batch.exportResults(resultsFile);
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	std::cout << "-------------------- Batch summary ---------------------"
+			<< std::endl;
+	batch.printSummary();
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+}
 
-	else if (optionName == "-metric") {
-		if (ALLOWED_METRICS.find(optionValue) == ALLOWED_METRICS.end()) {
-			throw wrong_usage_exception(
-					"Error while processing " + optionName + " " + optionValue
-							+ ".\n The metric name should be in the following set: \n{ "
-							+ implode(ALLOWED_METRICS.begin(),
-									ALLOWED_METRICS.end(), ", ") + " }");
-		}
-		METRIC = ClusterXX::buildMetric(optionValue);
-	}
+//Mode 10 : tests on the loaded expression values, before any normalization
+void runDifferentialExpression(const RunConfig &config) {
+	printDataParameters(config);
+
+	std::cout << "-------------------- Loading data ----------------------"
+			<< std::endl;
+	TCGAData data;
+	TCGADataLoader loader(&data, config.cancers, config.maxControlSamples,
+			config.maxTumorSamples, config.verbose);
+	checkMemory(config, loader);
+	loader.loadGeneExpressionData(config.sampleFile);
+	loader.loadClinicalData(config.clinical);
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	std::cout << "--------------- Differential expression ----------------"
+			<< std::endl;
+	std::cout << "* Comparisons : "
+			<< (config.differentialComparisons == TUMOR_VERSUS_CONTROL ?
+					"tumor vs control" : "all class pairs") << std::endl;
+	std::cout << "* Ranking test : "
+			<< (config.differentialTest == WELCH_TEST ?
+					"Welch t-test" : "Mann-Whitney U") << std::endl;
+	std::cout << "* FDR : " << config.differentialFDR << std::endl;
+	TCGADataDifferentialAnalyzer analyzer(&data,
+			config.differentialComparisons, config.verbose);
+	analyzer.compute();
+	analyzer.printReport(config.differentialFDR);
+	analyzer.exportRankedGenes(config.differentialTest);
+	analyzer.exportHeinzWeights(config.differentialTest,
+			config.differentialFDR);
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+}
 
-	else if (optionName == "-f") {
-		workingFile = optionValue;
+void CommandLineProcessor::runProgram() const {
+	if (!config.traceFile.empty()) {
+		Trace::enable();
 	}
-
-	else {
-		throw wrong_usage_exception(
-				"Unknown command line option '" + optionName + "'.");
+	if (config.memoryReport) {
+		MemoryMonitor::enable();
 	}
-}
+	MemoryMonitor::setLimit(config.memoryLimitMB << 20);
+	ThreadBudget::configure(config.threads, config.nestedPolicy,
+			config.pinThreads);
+	if (config.asyncExport) {
+		ExportWriter::start(config.exportQueueMB << 20, config.exportSync);
+	}
+	//The write errors are reported whichever way the mode ends
+	ExportWriterScope exportWriter;
 
-void CommandLineProcessor::runProgram() {
 	std::cout << "--------------------------------------" << std::endl;
 	std::cout << "|            TCGA-ANALYZER           |" << std::endl;
 	std::cout << "--------------------------------------" << std::endl;
+	std::cout << "Threads : " << ThreadBudget::describe() << std::endl;
 
-	if (PROGRAM_MODE == 0) {
+	if (config.programMode == 0) {
 		std::cout << std::endl << "Program mode : 0 (Clustering mode)"
 				<< std::endl << std::endl;
 	}
 
-	else if (PROGRAM_MODE == 2) {
+	else if (config.programMode == 2) {
 		std::cout << std::endl
 				<< "Program mode : 2 (Entry of the Heinz pipeline)" << std::endl
 				<< std::endl;
 	}
 
-	else if (PROGRAM_MODE == 1) {
+	else if (config.programMode == 1) {
 		std::cout << std::endl
 				<< "Program mode : 1 (Multiple cut percentages analyzer)"
 				<< std::endl << std::endl;
 	}
 
-	if (PROGRAM_MODE == 0 || PROGRAM_MODE == 2) {
+	else if (config.programMode == 3) {
+		std::cout << std::endl << "Program mode : 3 (Consensus clustering)"
+				<< std::endl << std::endl;
+	}
 
-		std::cout << "------------------- Data Parameters --------------------"
-				<< std::endl;
-		std::cout << "* Cancers : "
-				<< implode(CANCERS.begin(), CANCERS.end(), ", ") << std::endl;
-		std::cout << "* Clinical attributes : "
-				<< implode(CLINICAL.begin(), CLINICAL.end(), ", ") << std::endl;
-		std::cout << "* Max control samples : " << MAX_CONTROL_SAMPLES
+	else if (config.programMode == 4) {
+		std::cout << std::endl << "Program mode : 4 (Heinz output analyzer)"
+				<< std::endl << std::endl;
+	}
+
+	else if (config.programMode == 5) {
+		std::cout << std::endl << "Program mode : 5 (Heinz job scheduler)"
+				<< std::endl << std::endl;
+	}
+
+	else if (config.programMode == 6) {
+		std::cout << std::endl << "Program mode : 6 (Native module search)"
+				<< std::endl << std::endl;
+	}
+
+	else if (config.programMode == 7) {
+		std::cout << std::endl << "Program mode : 7 (Module clustering)"
+				<< std::endl << std::endl;
+	}
+
+	else if (config.programMode == 8) {
+		std::cout << std::endl << "Program mode : 8 (Server)" << std::endl
 				<< std::endl;
-		std::cout << "* Max tumor samples : " << MAX_TUMOR_SAMPLES << std::endl;
-		std::cout << "--------------------------------------------------------"
+	}
+
+	else if (config.programMode == 9) {
+		std::cout << std::endl << "Program mode : 9 (Batch experiments)"
+				<< std::endl << std::endl;
+	}
+
+	else if (config.programMode == 10) {
+		std::cout << std::endl << "Program mode : 10 (Differential expression)"
 				<< std::endl << std::endl;
+	}
+
+	if (config.programMode == 0) {
+		runClusteringPipeline(config);
+	}
+
+	else if (config.programMode == 8) {
+		runServer(config);
+	}
+
+	else if (config.programMode == 9) {
+		runBatch(config);
+	}
+
+	else if (config.programMode == 10) {
+		runDifferentialExpression(config);
+	}
+
+	else if (config.programMode == 2 || config.programMode == 3 || config.programMode == 6
+			|| config.programMode == 7) {
+
+		printDataParameters(config);
 
 		/* Read Data */
 		std::cout << "-------------------- Loading data ----------------------"
 				<< std::endl;
 		TCGAData data;
-		TCGADataLoader loader(&data, CANCERS, MAX_CONTROL_SAMPLES,
-				MAX_TUMOR_SAMPLES, VERBOSE);
-		loader.loadGeneExpressionData(SAMPLE_FILE);
-		loader.loadClinicalData(CLINICAL);
+		TCGADataLoader loader(&data, config.cancers, config.maxControlSamples,
+				config.maxTumorSamples, config.verbose);
+		checkMemory(config, loader);
+		loader.loadGeneExpressionData(config.sampleFile);
+		loader.loadClinicalData(config.clinical);
 
 		//Keep only data which will be in the PPI graph
-		//data.keepOnlyGenesInGraph(GRAPH_NODE_FILE);
+		//data.keepOnlyGenesInGraph(config.graphNodeFile);
 		std::cout << "--------------------------------------------------------"
 				<< std::endl << std::endl;
 
-		/* Normalize */
-		std::shared_ptr<Normalizer> normalizer;
-		std::cout << "-------------- Normalization parameters ----------------"
-				<< std::endl;
-		if (DEFAULT_NORMALIZATION_METHOD == KMEANS_NORMALIZATION) {
-			normalizer = std::make_shared<KMeansNormalizer>(
-					K_MEANS_NORMALIZATION_PARAM, K_MEANS_MAX_ITERATIONS);
-			std::cout << "* Normalization method : K-Means" << std::endl;
-			std::cout << "* K : " << K_MEANS_NORMALIZATION_PARAM << std::endl;
-			std::cout << "* Max iterations : " << K_MEANS_MAX_ITERATIONS
-					<< std::endl;
-		} else if (DEFAULT_NORMALIZATION_METHOD
-				== BINARY_QUANTILE_NORMALIZATION) {
-			normalizer = std::make_shared<BinaryQuantileNormalizer>(
-					BINARY_QUANTILE_NORMALIZATION_PARAM);
-			std::cout << "* Normalization method : Binary quantile"
-					<< std::endl;
-			std::cout << "* Binary quantile cut percentage : "
-					<< BINARY_QUANTILE_NORMALIZATION_PARAM << std::endl;
-		} else {
-			normalizer = std::make_shared<NoOperationNormalizer>();
-			std::cout << "* Normalization method : no normalization"
-					<< std::endl;
-		}
-		std::cout << "--------------------------------------------------------"
-				<< std::endl << std::endl;
+		printNormalizationParameters(config);
+		std::shared_ptr<Normalizer> normalizer = config.buildNormalizer();
 
 		std::cout << "------------------ Normalizing data --------------------"
 				<< std::endl;
 
-		TCGADataNormalizer tcgaNormalizer(&data, normalizer, VERBOSE);
+		TCGADataNormalizer tcgaNormalizer(&data, normalizer, config.verbose);
 		tcgaNormalizer.normalize();
 		std::cout << "--------------------------------------------------------"
 				<< std::endl << std::endl;
 
-		if (PROGRAM_MODE == 0) {
-			/* Output distance matrix */
+		//Samples left without positive genes are not given to the solver
+		std::vector<std::string> skippedSamples;
+		if ((config.programMode == 2 || config.programMode == 6)
+				&& config.minPositiveComponent > 0) {
 			std::cout
-					<< "------------------ Distance matrix ---------------------"
+					<< "------------------ Positive components -----------------"
 					<< std::endl;
-			std::cout << "* Metric : " << METRIC->toString() << std::endl;
-			TCGADataDistanceMatrixAnalyser distanceMetricAnalyzer(&data, METRIC,
-					VERBOSE);
-			distanceMetricAnalyzer.computeDistanceMatrix();
-			//distanceMetricAnalyzer.exportClassStats();
-			//distanceMetricAnalyzer.exportHeatMap();
+			std::cout << "* Minimum component size : " << config.minPositiveComponent
+					<< std::endl;
+			PositiveComponents positiveComponents(&data,
+					PPIGraph::buildFromFile(
+							GRAPH_DATA_DIRECTORY + config.graphNodeFile,
+							GRAPH_DATA_DIRECTORY + config.graphEdgeFile), config.verbose);
+			positiveComponents.compute();
+			positiveComponents.printReport();
+			if (config.minPositiveComponent > 1) {
+				std::cout << std::endl << "Positive genes set to 0 : "
+						<< positiveComponents.shrink(config.minPositiveComponent)
+						<< std::endl;
+			}
+			skippedSamples = positiveComponents.getEmptySamples();
+			std::cout << "Samples without positive genes : "
+					<< skippedSamples.size() << std::endl;
 			std::cout
 					<< "--------------------------------------------------------"
 					<< std::endl << std::endl;
+		}
 
+		if (config.programMode == 3) {
 			std::cout
-					<< "---------------- Clustering parameters -----------------"
+					<< "------------ Consensus clustering parameters -----------"
+					<< std::endl;
+			std::cout << "* Resampling rounds : " << config.consensusRounds
+					<< std::endl;
+			std::cout << "* K : " << config.consensusMinK << ".." << config.consensusMaxK
+					<< std::endl;
+			std::cout << "* Sample fraction : " << config.consensusSampleFraction
+					<< std::endl;
+			std::cout << "* Gene fraction : " << config.consensusGeneFraction
 					<< std::endl;
-			if (K_CLUSTER == 0) {
-				std::cout
-						<< "Number of clusters to find : automatic (= number of real classes in the data)"
-						<< std::endl;
-			} else {
-				std::cout << "Number of clusters to find : " << K_CLUSTER
-						<< std::endl;
-			}
 			std::cout
 					<< "--------------------------------------------------------"
 					<< std::endl << std::endl;
 
-			std::vector<std::string> patientLabels = data.getPatientLabels();
-
 			std::cout
-					<< "------------------ KMeans Clustering -------------------"
+					<< "----------------- Consensus clustering -----------------"
 					<< std::endl;
+			std::shared_ptr<TCGADataClusterer> clusterer;
+			TCGADataDistanceMatrixAnalyser distanceMetricAnalyzer(&data, config.metricName,
+					config.verbose, config.distanceKernelMode);
+			if (config.consensusClusteringMethod == KMEANS_CLUSTERING) {
+				std::cout << "* Clustering method : K-Means" << std::endl;
+				clusterer = std::make_shared<TCGADataKMeansClusterer>(&data,
+						config.consensusMinK, config.kMeansMaxIterations, config.parallelKMeans,
+						false);
+			} else {
+				std::cout << "* Metric : " << config.buildMetric()->toString() << std::endl;
+				distanceMetricAnalyzer.computeDistanceMatrix();
+				if (config.consensusClusteringMethod == SPECTRAL_CLUSTERING) {
+					std::cout
+							<< "* Clustering method : Unnormalized spectral clustering"
+							<< std::endl;
+					clusterer = std::make_shared<
+							TCGADataUnnormalizedSpectralClusterer>(&data,
+							distanceMetricAnalyzer.getDistanceMatrixHandler(),
+							config.buildMetric(), config.consensusMinK,
+							config.graphTransformation, false);
+				} else {
+					std::cout << "* Clustering method : Hierarchical"
+							<< std::endl;
+					clusterer = std::make_shared<TCGADataHierarchicalClusterer>(
+							&data,
+							distanceMetricAnalyzer.getDistanceMatrixHandler(),
+							config.buildMetric(), config.consensusMinK, config.linkageMethod,
+							false);
+				}
+			}
 
-			TCGADataKMeansClusterer kMeansClusterer(&data, K_CLUSTER,
-					K_MEANS_MAX_ITERATIONS, PARALLEL_KMEANS, VERBOSE);
-			kMeansClusterer.computeClustering();
-			kMeansClusterer.printClusteringInfo();
-			//kMeansClusterer.printRawClustering(patientLabels);
-
+			TCGADataConsensusClusterer consensusClusterer(&data,
+					clusterer.get(), config.consensusMinK, config.consensusMaxK,
+					config.consensusRounds, config.consensusSampleFraction,
+					config.consensusGeneFraction, config.consensusSeed, config.verbose);
+			consensusClusterer.computeConsensus();
+			consensusClusterer.printConsensusInfo();
+			consensusClusterer.exportConsensusCDF();
 			std::cout
 					<< "--------------------------------------------------------"
 					<< std::endl << std::endl;
+		}
 
-			/*
-			 std::cout
-			 << "-------------- Hierarchical Clustering -----------------"
-			 << std::endl;
-
-			 TCGADataHierarchicalClusterer hierarchicalClusterer(&data,
-			 distanceMetricAnalyzer.getDistanceMatrixHandler(), METRIC,
-			 K_CLUSTER, DEFAULT_LINKAGE_METHOD, VERBOSE);
-			 hierarchicalClusterer.computeClustering();
-			 hierarchicalClusterer.printClusteringInfo();
-			 //kMeansClusterer.printRawClustering(patientLabels);
-
-			 std::cout
-			 << "--------------------------------------------------------"
-			 << std::endl << std::endl;
-			 */
-
+		else if (config.programMode == 6) {
+			std::vector<std::string> weights_string =
+					HeinzModuleSearch::toWeightStrings(config.weights);
 			std::cout
-					<< "---------- Unnormalized Spectral Clustering ------------"
+					<< "----------------- Native module search -----------------"
 					<< std::endl;
-
-			TCGADataUnnormalizedSpectralClusterer unnormalizedSpectralClusterer(
-					&data, distanceMetricAnalyzer.getDistanceMatrixHandler(),
-					METRIC, K_CLUSTER, DEFAULT_GRAPH_TRANSFORMATION, VERBOSE);
-			unnormalizedSpectralClusterer.computeClustering();
-			unnormalizedSpectralClusterer.printClusteringInfo();
-			//unnormalizedSpectralClusterer.printRawClustering(patientLabels);
-
+			std::cout << "* Weights : "
+					<< implode(weights_string.begin(), weights_string.end(),
+							", ") << std::endl;
+			std::cout << "* Seeds : " << config.mwcsSeeds << std::endl;
+			std::shared_ptr<const PPIGraph> graph = PPIGraph::buildFromFile(
+					GRAPH_DATA_DIRECTORY + config.graphNodeFile,
+					GRAPH_DATA_DIRECTORY + config.graphEdgeFile);
+			HeinzModuleSearch moduleSearch(&data, graph, config.weights, 1,
+					config.mwcsSeeds, config.verbose);
+			HeinzOutputAnalyzer outputAnalyzer(weights_string,
+					moduleSearch.getPatientIDs(), graph, config.verbose);
+			moduleSearch.run(&outputAnalyzer);
 			std::cout
 					<< "--------------------------------------------------------"
 					<< std::endl << std::endl;
 
 			std::cout
-					<< "------ Normalized Spectral Clustering (Symmetric) ------"
+					<< "---------------- Analyzing Heinz output ----------------"
 					<< std::endl;
+			outputAnalyzer.printReport();
+			outputAnalyzer.exportFrequencyMatrix(
+					EXPORT_DIRECTORY + "heinz-negative-gene-frequencies");
+			std::cout
+					<< "--------------------------------------------------------"
+					<< std::endl << std::endl;
+		}
 
-			TCGADataNormalizedSpectralClusterer normalizedSpectralClusterer(
-					&data, distanceMetricAnalyzer.getDistanceMatrixHandler(),
-					METRIC, K_CLUSTER, DEFAULT_GRAPH_TRANSFORMATION, VERBOSE);
-			normalizedSpectralClusterer.computeClustering();
-			normalizedSpectralClusterer.printClusteringInfo();
-			//normalizedSpectralClusterer.printRawClustering(patientLabels);
+		else if (config.programMode == 7) {
+			std::vector<std::string> weights_string =
+					HeinzModuleSearch::toWeightStrings(config.weights);
+			std::cout
+					<< "---------------- Module clustering ---------------------"
+					<< std::endl;
+			std::cout << "* Weights : "
+					<< implode(weights_string.begin(), weights_string.end(),
+							", ") << std::endl;
+			std::shared_ptr<const PPIGraph> graph = PPIGraph::buildFromFile(
+					GRAPH_DATA_DIRECTORY + config.graphNodeFile,
+					GRAPH_DATA_DIRECTORY + config.graphEdgeFile);
+			std::vector<std::string> patientIDs;
+			for (const auto &patient : data.getPatientsHandler()) {
+				patientIDs.push_back(patient.toString());
+			}
+			std::shared_ptr<ClusterXX::Metric> moduleMetric =
+					ClusterXX::buildMetric("jaccard-distance");
+			//Samples are compared on all weights at once with the mean distance
+			Eigen::MatrixXd meanDistanceMatrix = Eigen::MatrixXd::Zero(
+					patientIDs.size(), patientIDs.size());
+			ModuleSimilarity allModules(graph);
+			std::vector<std::string> moduleLabels;
+
+			weights_string.push_back("all");
+			for (const auto &weight : weights_string) {
+				std::cout << std::endl << "* Weight : " << weight << std::endl;
+				Eigen::MatrixXd distanceMatrix;
+				if (weight == "all") {
+					distanceMatrix = meanDistanceMatrix
+							/ (weights_string.size() - 1);
+				} else {
+					ModuleSimilarity similarity(graph);
+					similarity.addHeinzOutput(weight, patientIDs, config.verbose);
+					distanceMatrix = similarity.computeJaccardDistance();
+					meanDistanceMatrix += distanceMatrix;
+					if (config.exportModuleSimilarity) {
+						allModules.addModules(similarity);
+						for (const auto &patientID : patientIDs) {
+							moduleLabels.push_back(weight + "_" + patientID);
+						}
+					}
+				}
+
+				TCGADataHierarchicalClusterer hierarchicalClusterer(&data,
+						distanceMatrix, moduleMetric, config.K,
+						config.linkageMethod, config.verbose);
+				hierarchicalClusterer.computeClustering();
+				hierarchicalClusterer.printClusteringInfo();
+				TCGADataClusteringEvaluator::exportEvaluation(
+						hierarchicalClusterer.evaluate(&distanceMatrix, false),
+						"modules-hierarchical_" + weight);
+
+				TCGADataNormalizedSpectralClusterer spectralClusterer(&data,
+						distanceMatrix, moduleMetric, config.K,
+						config.graphTransformation, config.verbose);
+				spectralClusterer.computeClustering();
+				spectralClusterer.printClusteringInfo();
+				TCGADataClusteringEvaluator::exportEvaluation(
+						spectralClusterer.evaluate(&distanceMatrix, false),
+						"modules-normalized-spectral_" + weight);
+			}
 
+			if (config.exportModuleSimilarity) {
+				std::cout << std::endl << "Exporting the similarity of "
+						<< allModules.getNumberOfModules() << " modules... "
+						<< std::flush;
+				ModuleSimilarity::exportSimilarityMatrix(
+						allModules.computeJaccardSimilarity(), moduleLabels,
+						EXPORT_DIRECTORY + "heinz-module-similarity");
+				std::cout << "Done." << std::endl;
+			}
 			std::cout
 					<< "--------------------------------------------------------"
 					<< std::endl << std::endl;
 		}
 
 		else {
-			std::ofstream negativeWeightsOutput(HEINZ_NEGATIVEWEIGHT_LIST);
+			ExportStream negativeWeightsOutput(HEINZ_NEGATIVEWEIGHT_LIST);
 			std::cout
 					<< "----------------- Writing Heinz input ------------------"
 					<< std::endl;
 			std::vector<std::string> weights_string;
-			for (double d : WEIGHTS) {
+			for (double d : config.weights) {
 				weights_string.push_back(
 						removeTrailingZeros(std::to_string(d)));
 			}
 			std::cout << "* Weights : "
 					<< implode(weights_string.begin(), weights_string.end(),
 							", ") << std::endl;
-			for (double d : WEIGHTS) {
+			std::vector<double> negativeValues;
+			for (double d : config.weights) {
 				negativeWeightsOutput << removeTrailingZeros(std::to_string(d))
 						<< std::endl;
-				std::cout << "Writing files for d=-" << d << "... "
-						<< std::endl;
-				tcgaNormalizer.exportToFile(1, -d);
+				negativeValues.push_back(-d);
 			}
+			std::cout << "Writing "
+					<< (config.heinzPackedExport ? "packed files" : "files")
+					<< "... " << std::endl;
+			tcgaNormalizer.exportToFile(1, negativeValues,
+					config.heinzPackedExport);
+			PositiveComponents::writeSkippedSamples(skippedSamples,
+					HEINZ_SKIPPED_SAMPLES_LIST);
 
 			std::cout
 					<< "--------------------------------------------------------"
@@ -366,14 +777,14 @@ void CommandLineProcessor::runProgram() {
 		}
 	}
 
-	else if (PROGRAM_MODE == 1) {
+	else if (config.programMode == 1) {
 		std::cout << "------------------- Data Parameters --------------------"
 				<< std::endl;
 		std::cout << "* Cancers : "
-				<< implode(CANCERS.begin(), CANCERS.end(), ", ") << std::endl;
-		std::cout << "* Max control samples : " << MAX_CONTROL_SAMPLES
+				<< implode(config.cancers.begin(), config.cancers.end(), ", ") << std::endl;
+		std::cout << "* Max control samples : " << config.maxControlSamples
 				<< std::endl;
-		std::cout << "* Max tumor samples : " << MAX_TUMOR_SAMPLES << std::endl;
+		std::cout << "* Max tumor samples : " << config.maxTumorSamples << std::endl;
 		std::cout << "--------------------------------------------------------"
 				<< std::endl << std::endl;
 
@@ -381,34 +792,35 @@ void CommandLineProcessor::runProgram() {
 		std::cout << "-------------------- Loading data ----------------------"
 				<< std::endl;
 		TCGAData data;
-		TCGADataLoader loader(&data, CANCERS, MAX_CONTROL_SAMPLES,
-				MAX_TUMOR_SAMPLES, VERBOSE);
-		loader.loadGeneExpressionData(SAMPLE_FILE);
-		data.keepOnlyGenesInGraph(GRAPH_NODE_FILE);
+		TCGADataLoader loader(&data, config.cancers, config.maxControlSamples,
+				config.maxTumorSamples, config.verbose);
+		checkMemory(config, loader);
+		loader.loadGeneExpressionData(config.sampleFile);
+		data.keepOnlyGenesInGraph(config.graphNodeFile);
 		std::cout << "--------------------------------------------------------"
 				<< std::endl << std::endl;
 
 		/*Normalizing and clustering*/
 		std::cout << "------------- Normalizing and clustering ---------------"
 				<< std::endl;
-		std::cout << "* Metric : " << METRIC->toString() << std::endl;
-		for (double d = MIN_CUT_PERCENTAGE; d < MAX_CUT_PERCENTAGE; d +=
-				STEP_CUT_PERCENTAGE) {
+		std::cout << "* Metric : " << config.buildMetric()->toString() << std::endl;
+		for (double d = config.minCutPercentage; d < config.maxCutPercentage; d +=
+				config.stepCutPercentage) {
 			TCGAData dataCopy = data;
 			std::cout << d << std::flush;
 			std::shared_ptr<Normalizer> normalizer = std::make_shared<
 					BinaryQuantileNormalizer>(d);
 			TCGADataNormalizer tcgaNormalizer(&data, normalizer, false);
 			tcgaNormalizer.normalize();
-			TCGADataDistanceMatrixAnalyser distanceMetricAnalyzer(&data, METRIC,
-					false);
+			TCGADataDistanceMatrixAnalyser distanceMetricAnalyzer(&data, config.metricName,
+					false, config.distanceKernelMode);
 			distanceMetricAnalyzer.computeDistanceMatrix();
-//			TCGADataKMeansClusterer kMeansClusterer(&data, K_CLUSTER,
-//					K_MEANS_MAX_ITERATIONS, false);
+//			TCGADataKMeansClusterer kMeansClusterer(&data, config.K,
+//					config.kMeansMaxIterations, false);
 //			kMeansClusterer.computeClustering();
 			TCGADataUnnormalizedSpectralClusterer spectralClusterer(&data,
-					distanceMetricAnalyzer.getDistanceMatrixHandler(), METRIC,
-					K_CLUSTER, DEFAULT_GRAPH_TRANSFORMATION, false);
+					distanceMetricAnalyzer.getDistanceMatrixHandler(), config.buildMetric(),
+					config.K, config.graphTransformation, false);
 			spectralClusterer.computeClustering();
 			//double adi1 = kMeansClusterer.getAdjustedRandIndex();
 			double adi2 = spectralClusterer.getAdjustedRandIndex();
@@ -419,4 +831,83 @@ void CommandLineProcessor::runProgram() {
 		std::cout << "--------------------------------------------------------"
 				<< std::endl << std::endl;
 	}
+
+	else if (config.programMode == 4) {
+		std::cout << "---------------- Analyzing Heinz output ----------------"
+				<< std::endl;
+		HeinzOutputAnalyzer outputAnalyzer("negative-weights.txt",
+				"samples.txt", config.graphNodeFile, config.graphEdgeFile, config.verbose);
+		if (config.watchHeinzOutput) {
+			outputAnalyzer.watch(config.watchReportInterval, config.watchIdleTimeout);
+		} else {
+			outputAnalyzer.analyze();
+		}
+		outputAnalyzer.exportFrequencyMatrix(
+				EXPORT_DIRECTORY + "heinz-negative-gene-frequencies");
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
+	}
+
+	else if (config.programMode == 5) {
+		std::cout << "----------------- Scheduler parameters -----------------"
+				<< std::endl;
+		std::cout << "* Solver command : " << config.heinzSolverCommand << std::endl;
+		std::cout << "* Workers : " << ThreadBudget::getWorkers(config.heinzJobs)
+				<< std::endl;
+		std::cout << "* Timeout : "
+				<< (config.heinzTimeout == 0 ?
+						"none" : std::to_string(config.heinzTimeout) + "s")
+				<< std::endl;
+		std::cout << "* Resume from checkpoint : "
+				<< (config.heinzResume ? "yes" : "no") << std::endl;
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
+
+		std::cout << "------------------ Running Heinz jobs -------------------"
+				<< std::endl;
+		HeinzOutputAnalyzer outputAnalyzer("negative-weights.txt",
+				"samples.txt", config.graphNodeFile, config.graphEdgeFile, config.verbose);
+		HeinzJobScheduler scheduler(outputAnalyzer.getWeights(),
+				outputAnalyzer.getPatientIDs(), config.heinzSolverCommand,
+				GRAPH_DATA_DIRECTORY + config.graphEdgeFile, config.heinzJobs,
+				config.heinzTimeout, config.heinzResume, config.verbose);
+		//Modules are analyzed as soon as the solver writes them
+		scheduler.setCompletionCallback(
+				[&outputAnalyzer](const std::string &fileBasename) {
+					outputAnalyzer.analyzeModule(fileBasename);
+				});
+		scheduler.run();
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
+
+		std::cout << "---------------- Analyzing Heinz output ----------------"
+				<< std::endl;
+		outputAnalyzer.printReport();
+		outputAnalyzer.exportFrequencyMatrix(
+				EXPORT_DIRECTORY + "heinz-negative-gene-frequencies");
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
+	}
+
+	//Throws the errors of the exports, once they are all written
+	exportWriter.finish();
+
+	if (MemoryMonitor::isEnabled()) {
+		std::cout << "------------------------ Memory ------------------------"
+				<< std::endl;
+		MemoryMonitor::printReport();
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
+	}
+
+	if (Trace::isEnabled()) {
+		std::cout << "---------------------- Profiling -----------------------"
+				<< std::endl;
+		Trace::printSummary();
+		Trace::writeChromeTrace(config.traceFile);
+		Trace::clear();
+		std::cout << "* Trace written to " << config.traceFile << std::endl;
+		std::cout << "--------------------------------------------------------"
+				<< std::endl << std::endl;
+	}
 }
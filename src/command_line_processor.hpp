@@ -8,31 +8,15 @@
 #ifndef SRC_COMMAND_LINE_PROCESSOR_HPP_
 #define SRC_COMMAND_LINE_PROCESSOR_HPP_
 
-#include <set>
-#include <stdexcept>
-#include <map>
-
-class wrong_usage_exception: public std::exception {
-public:
-	wrong_usage_exception(std::string _msg = "Wrong Usage Exception") :
-			msg(_msg) {
-	}
-	~wrong_usage_exception() throw () {
-	}
-	const char* what() const throw () {
-		return msg.c_str();
-	}
-private:
-	std::string msg;
-};
+#include "runConfig.hpp"
 
 class CommandLineProcessor {
 public:
 	CommandLineProcessor(int argc, char *argv[]);
-	void runProgram();
+	void runProgram() const;
+	const RunConfig &getConfig() const;
 private:
-	void process(const std::string &optionName, const std::string &optionValue);
-	std::string workingFile;
+	RunConfig config;
 };
 
 #endif /* SRC_COMMAND_LINE_PROCESSOR_HPP_ */
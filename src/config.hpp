@@ -24,6 +24,11 @@ const std::set<std::string> ALLOWED_METRICS =
 				"spearman-absolute-correlation", "spearman",
 				"spearman-correlation", "spearman-distance", "jaccard",
 				"jaccard-similarity", "jaccard-distance" };
+//Metrics whose matrix holds dissimilarities (the others are similarities)
+const std::set<std::string> DISTANCE_METRICS = { "cosine-distance",
+		"euclidean", "euclidean-distance", "squared-euclidean",
+		"squared-euclidean-distance", "manhattan", "manhattan-distance",
+		"pearson-distance", "spearman-distance", "jaccard-distance" };
 
 enum UnsupervisedNormalizationMethod {
 	KMEANS_NORMALIZATION, BINARY_QUANTILE_NORMALIZATION, NO_NORMALIZATION
@@ -31,6 +36,10 @@ enum UnsupervisedNormalizationMethod {
 
 const std::string TCGA_DATA_DIRECTORY = "data/tcga/";
 const std::string GRAPH_DATA_DIRECTORY = "data/graph/";
+const std::string GRAPH_NODE_FILE_TCGA = "biogrid-nodes-tcga.txt";
+const std::string GRAPH_EDGE_FILE_TCGA = "biogrid-edges-tcga.txt";
+const std::string GRAPH_NODE_FILE_BERGONIE = "biogrid-nodes-bergonie.txt";
+const std::string GRAPH_EDGE_FILE_BERGONIE = "biogrid-edges-bergonie.txt";
 const std::string HEINZ_DIRECTORY = "data/heinz/";
 const std::string HEINZ_INPUT_DIRECTORY = HEINZ_DIRECTORY + "input/";
 const std::string HEINZ_RAW_OUTPUT_DIRECTORY = HEINZ_DIRECTORY + "raw_output/";
@@ -38,8 +47,19 @@ const std::string HEINZ_OUTPUT_DIRECTORY = HEINZ_DIRECTORY + "output/";
 const std::string HEINZ_SAMPLES_LIST = HEINZ_DIRECTORY + "samples.txt";
 const std::string HEINZ_NEGATIVEWEIGHT_LIST = HEINZ_DIRECTORY
 		+ "negative-weights.txt";
+//Packed Heinz input : one bit per gene and per sample, genes listed once
+const std::string HEINZ_PACKED_GENE_LIST = HEINZ_INPUT_DIRECTORY + "genes.txt";
+const std::string HEINZ_PACKED_EXTENSION = ".bits";
+//Samples without positive genes left after the component prefilter
+const std::string HEINZ_SKIPPED_SAMPLES_LIST = HEINZ_DIRECTORY
+		+ "skipped-samples.txt";
+//Node weights of the differentially expressed genes, one file per comparison
+const std::string HEINZ_DIFFERENTIAL_DIRECTORY = HEINZ_DIRECTORY
+		+ "differential/";
 
 const std::string EXPORT_DIRECTORY = "export/";
+//Intermediate artifacts of the clustering pipeline (mode 0)
+const std::string CACHE_DIRECTORY = "cache/";
 const std::string SAMPLE_TCGA_FILE = TCGA_DATA_DIRECTORY
 		+ "BRCA-normalized/TCGA-3C-AAAU-01.genes.normalized.results";
 const std::string SAMPLE_BERGONIE_FILE = TCGA_DATA_DIRECTORY
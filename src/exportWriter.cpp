@@ -0,0 +1,237 @@
+/*
+ * exportWriter.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "exportWriter.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "trace.hpp"
+
+namespace {
+
+//With sync, descriptors are kept open to group the flushes to disk, at most
+//this many at a time
+const std::size_t MAX_OPEN_DESCRIPTORS = 256;
+
+struct ExportFile {
+	std::string filename;
+	std::string content;
+	bool append;
+};
+
+struct WriterState {
+	std::mutex mutex;
+	std::condition_variable queueChanged;
+	std::deque<ExportFile> queue;
+	unsigned long long queuedBytes = 0;
+	unsigned long long maxQueuedBytes = 0;
+	bool sync = false;
+	bool stopping = false;
+	std::thread thread;
+	//Queued appends per file, not written yet : the file may not exist yet
+	std::map<std::string, unsigned int> pendingAppends;
+	std::vector<std::string> errors;
+
+	//The queued files are still written at exit when finish() was not called
+	~WriterState() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		queueChanged.notify_all();
+		if (thread.joinable()) {
+			thread.join();
+		}
+	}
+};
+
+WriterState state;
+
+//Returns the open descriptor, or -1 after recording the error
+int writeFile(const ExportFile &file) {
+	int descriptor = open(file.filename.c_str(),
+			O_WRONLY | O_CREAT | O_CLOEXEC | (file.append ? O_APPEND : O_TRUNC),
+			0644);
+	const char *data = file.content.data();
+	std::size_t remaining = file.content.size();
+	while (descriptor >= 0 && remaining > 0) {
+		ssize_t written = ::write(descriptor, data, remaining);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+		if (written < 0) {
+			int error = errno;
+			close(descriptor);
+			descriptor = -1;
+			errno = error;
+			break;
+		}
+		data += written;
+		remaining -= written;
+	}
+	if (descriptor < 0) {
+		std::string error = file.filename + " (" + std::strerror(errno) + ")";
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.errors.push_back(error);
+	}
+	return descriptor;
+}
+
+void closeFiles(const std::vector<std::pair<int, std::string>> &files,
+		bool sync) {
+	for (const auto &file : files) {
+		if ((sync && fsync(file.first) != 0) || close(file.first) != 0) {
+			std::string error = file.second + " (" + std::strerror(errno) + ")";
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.errors.push_back(error);
+		}
+	}
+}
+
+void runWriter() {
+	std::unique_lock<std::mutex> lock(state.mutex);
+	while (true) {
+		state.queueChanged.wait(lock, []() {
+			return state.stopping || !state.queue.empty();
+		});
+		if (state.queue.empty()) {
+			return;
+		}
+		std::deque<ExportFile> batch;
+		batch.swap(state.queue);
+		bool sync = state.sync;
+		lock.unlock();
+
+		ScopedTimer timer("export/write");
+		std::vector<std::pair<int, std::string>> files;
+		for (const ExportFile &file : batch) {
+			int descriptor = writeFile(file);
+			if (descriptor >= 0) {
+				files.emplace_back(descriptor, file.filename);
+			}
+			if (!sync || files.size() >= MAX_OPEN_DESCRIPTORS) {
+				closeFiles(files, sync);
+				files.clear();
+			}
+			{
+				std::lock_guard<std::mutex> queueLock(state.mutex);
+				state.queuedBytes -= file.content.size();
+				if (file.append && --state.pendingAppends[file.filename] == 0) {
+					state.pendingAppends.erase(file.filename);
+				}
+			}
+			state.queueChanged.notify_all();
+		}
+		closeFiles(files, sync);
+		lock.lock();
+	}
+}
+
+}
+
+void ExportWriter::start(unsigned long long maxQueuedBytes, bool sync) {
+	std::lock_guard<std::mutex> lock(state.mutex);
+	if (state.thread.joinable()) {
+		return;
+	}
+	state.maxQueuedBytes = maxQueuedBytes;
+	state.sync = sync;
+	state.stopping = false;
+	state.thread = std::thread(runWriter);
+}
+
+void ExportWriter::write(const std::string &filename, std::string content,
+		bool append) {
+	Trace::count("exported files", 1);
+	Trace::count("exported bytes", content.size());
+	std::unique_lock<std::mutex> lock(state.mutex);
+	if (!state.thread.joinable()) {
+		lock.unlock();
+		int descriptor = writeFile( { filename, std::move(content), append });
+		if (descriptor >= 0) {
+			closeFiles( { { descriptor, filename } }, false);
+		}
+		return;
+	}
+	//A file larger than the queue still goes through once the queue is empty
+	state.queueChanged.wait(lock, [&content]() {
+		return state.queuedBytes == 0
+				|| state.queuedBytes + content.size() <= state.maxQueuedBytes;
+	});
+	state.queuedBytes += content.size();
+	if (append) {
+		++state.pendingAppends[filename];
+	}
+	state.queue.push_back( { filename, std::move(content), append });
+	lock.unlock();
+	state.queueChanged.notify_all();
+}
+
+bool ExportWriter::exists(const std::string &filename) {
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if (state.pendingAppends.count(filename)) {
+			return true;
+		}
+	}
+	return std::ifstream(filename).good();
+}
+
+void ExportWriter::finish() {
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		state.stopping = true;
+	}
+	state.queueChanged.notify_all();
+	if (state.thread.joinable()) {
+		state.thread.join();
+	}
+
+	std::vector<std::string> errors;
+	{
+		std::lock_guard<std::mutex> lock(state.mutex);
+		errors.swap(state.errors);
+		state.stopping = false;
+	}
+	if (!errors.empty()) {
+		std::string message = std::to_string(errors.size())
+				+ " export file(s) could not be written :";
+		for (unsigned int i = 0; i < errors.size() && i < 10; ++i) {
+			message += "\n  " + errors[i];
+		}
+		if (errors.size() > 10) {
+			message += "\n  ...";
+		}
+		throw std::runtime_error(message);
+	}
+}
+
+ExportWriterScope::~ExportWriterScope() {
+	if (finished) {
+		return;
+	}
+	try {
+		ExportWriter::finish();
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+	}
+}
+
+void ExportWriterScope::finish() {
+	finished = true;
+	ExportWriter::finish();
+}
@@ -0,0 +1,62 @@
+/*
+ * exportWriter.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_EXPORTWRITER_HPP_
+#define SRC_EXPORTWRITER_HPP_
+
+#include <string>
+#include <sstream>
+
+// Export files written by a background thread. Exporters format a whole file
+// in memory and queue it, the computation goes on while the I/O thread writes
+// it with large writes. Write errors are kept until finish(), at the end of
+// the run, instead of stopping the exporters.
+class ExportWriter {
+public:
+	//Until started, files are written when queued. Exporters wait while the
+	//queue holds more than maxQueuedBytes. With sync, each batch of written
+	//files is flushed to disk before the next one.
+	static void start(unsigned long long maxQueuedBytes, bool sync = false);
+	//Thread-safe, never throws
+	static void write(const std::string &filename, std::string content,
+			bool append = false);
+	//On disk, or queued to be appended to
+	static bool exists(const std::string &filename);
+	//Waits for the queued files, stops the thread and throws the write errors
+	static void finish();
+};
+
+//Calls ExportWriter::finish() on every way out of a scope. finish() throws
+//the write errors ; if the scope is left by an exception, the destructor
+//prints them instead.
+class ExportWriterScope {
+public:
+	ExportWriterScope() = default;
+	~ExportWriterScope();
+	void finish();
+	ExportWriterScope(const ExportWriterScope &) = delete;
+	ExportWriterScope &operator=(const ExportWriterScope &) = delete;
+
+private:
+	bool finished = false;
+};
+
+//A string stream queued to ExportWriter when destroyed
+class ExportStream: public std::ostringstream {
+public:
+	explicit ExportStream(const std::string &_filename, bool _append = false) :
+			filename(_filename), append(_append) {
+	}
+	~ExportStream() {
+		ExportWriter::write(filename, str(), append);
+	}
+
+private:
+	std::string filename;
+	bool append;
+};
+
+#endif /* SRC_EXPORTWRITER_HPP_ */
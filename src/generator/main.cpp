@@ -0,0 +1,100 @@
+/*
+ * main.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include "syntheticDataGenerator.hpp"
+#include "../command_line_processor.hpp"
+#include "../config.hpp"
+#include "../utilities.hpp"
+
+// Usage : TCGA-Generator [-option value]...
+// -output, -cancers, -tumor, -control, -genes, -subtypes, -signal, -markers,
+// -graphgenes, -degree, -seed, -verbose
+int main(int argc, char *argv[]) {
+	if (argc % 2 != 1) {
+		throw wrong_usage_exception(
+				"Invalid command line : number of arguments should be an odd number.");
+	}
+
+	SyntheticDataParameters parameters;
+	bool verbose = true;
+	for (int i = 1; i < argc; i += 2) {
+		std::string optionName = argv[i];
+		std::string optionValue = argv[i + 1];
+		if (optionName == "-output") {
+			parameters.outputDirectory = optionValue;
+		} else if (optionName == "-cancers") {
+			parameters.cancers.clear();
+			for (const auto &s : split(optionValue, { ',' })) {
+				//The Bergonie data has its own layout
+				if (ALLOWED_CANCERS.find(s) == ALLOWED_CANCERS.end()
+						|| s == "SARCB") {
+					throw wrong_usage_exception(
+							"Error when trying to process cancer with name '"
+									+ s + "'.");
+				}
+				parameters.cancers.insert(s);
+			}
+		} else if (optionName == "-tumor") {
+			parameters.tumorSamples = std::atoi(optionValue.c_str());
+		} else if (optionName == "-control") {
+			parameters.controlSamples = std::atoi(optionValue.c_str());
+		} else if (optionName == "-genes") {
+			parameters.numberOfGenes = std::atoi(optionValue.c_str());
+		} else if (optionName == "-subtypes") {
+			parameters.subtypes = std::atoi(optionValue.c_str());
+		} else if (optionName == "-signal") {
+			parameters.signal = std::atof(optionValue.c_str());
+		} else if (optionName == "-markers") {
+			parameters.markerFraction = std::atof(optionValue.c_str());
+			if (parameters.markerFraction <= 0
+					|| parameters.markerFraction > 1) {
+				throw wrong_usage_exception(
+						"-markers option value should be in ]0, 1].");
+			}
+		} else if (optionName == "-graphgenes") {
+			parameters.graphGenes = std::atoi(optionValue.c_str());
+		} else if (optionName == "-degree") {
+			parameters.graphDegree = std::atoi(optionValue.c_str());
+		} else if (optionName == "-seed") {
+			parameters.seed = std::strtoull(optionValue.c_str(), nullptr, 10);
+		} else if (optionName == "-verbose") {
+			verbose = std::atoi(optionValue.c_str());
+		} else {
+			throw wrong_usage_exception(
+					"Unknown command line option '" + optionName + "'.");
+		}
+	}
+
+	std::cout << "--------------------------------------" << std::endl;
+	std::cout << "|           TCGA-GENERATOR           |" << std::endl;
+	std::cout << "--------------------------------------" << std::endl;
+	std::cout << "* Output : " << parameters.outputDirectory << std::endl;
+	std::cout << "* Cancers : "
+			<< implode(parameters.cancers.begin(), parameters.cancers.end(),
+					", ") << std::endl;
+	std::cout << "* Tumor / control samples per cancer : "
+			<< parameters.tumorSamples << " / " << parameters.controlSamples
+			<< std::endl;
+	std::cout << "* Genes : " << parameters.numberOfGenes << std::endl;
+	std::cout << "* Tumor subtypes : " << parameters.subtypes << std::endl;
+	std::cout << "* Signal (log2 fold change) : " << parameters.signal
+			<< std::endl;
+	std::cout << "* Marker fraction : " << parameters.markerFraction
+			<< std::endl;
+	std::cout << "* Graph : "
+			<< (parameters.graphGenes == 0 ?
+					std::string("80% of the genes") :
+					std::to_string(parameters.graphGenes) + " genes")
+			<< ", degree " << parameters.graphDegree << std::endl;
+	std::cout << "* Seed : " << parameters.seed << std::endl;
+	std::cout << "--------------------------------------------------------"
+			<< std::endl << std::endl;
+
+	SyntheticDataGenerator generator(parameters, verbose);
+	generator.generate();
+}
@@ -0,0 +1,361 @@
+/*
+ * syntheticDataGenerator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "syntheticDataGenerator.hpp"
+
+#include <algorithm>
+#include <random>
+#include <queue>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <exception>
+#include "../config.hpp"
+#include "../utilities.hpp"
+
+namespace {
+
+//Same names as the default graph of the analyzer
+const std::string GRAPH_NODE_FILE = "biogrid-nodes-tcga.txt";
+const std::string GRAPH_EDGE_FILE = "biogrid-edges-tcga.txt";
+
+//Independent stream for each sample, whatever the thread running it
+std::mt19937_64 sampleGenerator(std::uint64_t seed, unsigned int sampleIndex) {
+	std::seed_seq sequence { (std::uint32_t) seed, (std::uint32_t) (seed >> 32),
+			(std::uint32_t) sampleIndex, 0x5eedu };
+	return std::mt19937_64(sequence);
+}
+
+void writeBuffer(const std::string &filename, const std::string &buffer) {
+	std::ofstream outputStream(filename, std::ios::binary);
+	outputStream.write(buffer.data(), buffer.size());
+	if (!outputStream) {
+		throw std::runtime_error("Cannot write " + filename);
+	}
+}
+
+}
+
+SyntheticDataGenerator::SyntheticDataGenerator(
+		const SyntheticDataParameters &_parameters, bool _verbose) :
+		parameters(_parameters), verbose(_verbose) {
+	if (parameters.numberOfGenes == 0) {
+		throw std::invalid_argument("The number of genes should be positive.");
+	}
+	//The expression files are laid out after the first sample
+	if (parameters.cancers.empty()
+			|| parameters.tumorSamples + parameters.controlSamples == 0) {
+		throw std::invalid_argument(
+				"The cohort should have at least one cancer and one sample.");
+	}
+	if (parameters.graphGenes == 0) {
+		parameters.graphGenes = std::max(1u,
+				(unsigned int) (0.8 * parameters.numberOfGenes));
+	}
+	parameters.graphGenes = std::min(parameters.graphGenes,
+			parameters.numberOfGenes);
+	parameters.subtypes = std::max(1u, parameters.subtypes);
+}
+
+void SyntheticDataGenerator::generate() {
+	std::string dataDirectory = parameters.outputDirectory + "/data/";
+	makeDirectory(parameters.outputDirectory);
+	makeDirectory(dataDirectory);
+	makeDirectory(parameters.outputDirectory + "/" + TCGA_DATA_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + GRAPH_DATA_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + HEINZ_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + HEINZ_INPUT_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + HEINZ_RAW_OUTPUT_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + HEINZ_OUTPUT_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + HEINZ_DIFFERENTIAL_DIRECTORY);
+	makeDirectory(parameters.outputDirectory + "/" + EXPORT_DIRECTORY);
+
+	generateGenes();
+	generateGraph();
+	generateMarkers();
+	generateSamples();
+
+	if (verbose) {
+		std::cout << "Writing graph (" << graphNodes.size() << " nodes, "
+				<< graphEdges.size() << " edges)... " << std::flush;
+	}
+	writeGraph();
+	if (verbose) {
+		std::cout << "Done." << std::endl;
+	}
+
+	for (const auto &cancer : parameters.cancers) {
+		makeDirectory(cancerDirectory(cancer));
+		writeCancer(cancer);
+	}
+
+	if (verbose) {
+		std::cout << "Writing " << samples.size() << " samples of "
+				<< geneNames.size() << " genes... " << std::endl;
+	}
+	ProgressCounter progress(samples.size(), "samples", verbose);
+	std::exception_ptr exception = nullptr;
+#pragma omp parallel for schedule(dynamic)
+	for (unsigned int i = 0; i < samples.size(); ++i) {
+		try {
+			const Sample &sample = samples[i];
+			writeExpression(i,
+					cancerDirectory(sample.cancer) + sample.patientName + "-"
+							+ (sample.tumor ? "01" : "11")
+							+ ".genes.normalized.results");
+		} catch (...) {
+#pragma omp critical
+			if (!exception) {
+				exception = std::current_exception();
+			}
+		}
+		progress.increment();
+	}
+	progress.finish();
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+
+	//The loader takes the gene list from this file, whatever the cancers
+	makeDirectory(parameters.outputDirectory + "/" + TCGA_DATA_DIRECTORY
+			+ "BRCA-normalized");
+	writeExpression(0, parameters.outputDirectory + "/" + SAMPLE_TCGA_FILE);
+}
+
+std::string SyntheticDataGenerator::cancerDirectory(
+		const std::string &cancer) const {
+	return parameters.outputDirectory + "/" + TCGA_DATA_DIRECTORY + cancer
+			+ "-normalized/";
+}
+
+void SyntheticDataGenerator::generateGenes() {
+	std::mt19937_64 generator(parameters.seed);
+	//log2 of the normalized counts
+	std::normal_distribution<float> meanDistribution(6.0f, 2.5f);
+	std::uniform_real_distribution<float> deviationDistribution(0.3f, 1.0f);
+	geneNames.resize(parameters.numberOfGenes);
+	geneMeans.resize(parameters.numberOfGenes);
+	geneDeviations.resize(parameters.numberOfGenes);
+	for (unsigned int g = 0; g < parameters.numberOfGenes; ++g) {
+		geneNames[g] = "GENE" + std::to_string(g + 1);
+		geneMeans[g] = std::max(0.0f, meanDistribution(generator));
+		geneDeviations[g] = deviationDistribution(generator);
+	}
+}
+
+void SyntheticDataGenerator::generateGraph() {
+	std::mt19937_64 generator(parameters.seed + 1);
+	std::vector<unsigned int> genes(parameters.numberOfGenes);
+	for (unsigned int g = 0; g < genes.size(); ++g) {
+		genes[g] = g;
+	}
+	std::shuffle(genes.begin(), genes.end(), generator);
+	genes.resize(parameters.graphGenes);
+	std::sort(genes.begin(), genes.end());
+	graphNodes.clear();
+	for (unsigned int g : genes) {
+		graphNodes.push_back(geneNames[g]);
+	}
+
+	//Barabasi-Albert : every new node is linked to graphDegree existing nodes
+	//chosen with a probability proportional to their degree, which is the
+	//probability to pick them as the end of a random edge
+	unsigned int m = std::max(1u, parameters.graphDegree);
+	unsigned int N = genes.size();
+	unsigned int initial = std::min(N, m + 1);
+	std::vector<unsigned int> endpoints;
+	graphEdges.clear();
+	for (unsigned int u = 0; u < initial; ++u) {
+		for (unsigned int v = u + 1; v < initial; ++v) {
+			graphEdges.emplace_back(genes[u], genes[v]);
+			endpoints.push_back(u);
+			endpoints.push_back(v);
+		}
+	}
+	std::vector<unsigned int> targets;
+	for (unsigned int v = initial; v < N; ++v) {
+		targets.clear();
+		std::uniform_int_distribution<std::size_t> pick(0,
+				endpoints.size() - 1);
+		for (unsigned int attempt = 0; targets.size() < m && attempt < 10 * m;
+				++attempt) {
+			unsigned int u = endpoints[pick(generator)];
+			if (std::find(targets.begin(), targets.end(), u) == targets.end()) {
+				targets.push_back(u);
+			}
+		}
+		for (unsigned int u : targets) {
+			graphEdges.emplace_back(genes[u], genes[v]);
+			endpoints.push_back(u);
+			endpoints.push_back(v);
+		}
+	}
+}
+
+void SyntheticDataGenerator::generateMarkers() {
+	std::mt19937_64 generator(parameters.seed + 2);
+	std::vector<std::vector<unsigned int>> adjacency(parameters.numberOfGenes);
+	for (const auto &edge : graphEdges) {
+		adjacency[edge.first].push_back(edge.second);
+		adjacency[edge.second].push_back(edge.first);
+	}
+	std::vector<unsigned int> nodes;
+	for (unsigned int g = 0; g < parameters.numberOfGenes; ++g) {
+		if (!adjacency[g].empty()) {
+			nodes.push_back(g);
+		}
+	}
+
+	unsigned int setSize = std::min<unsigned int>(nodes.size(),
+			std::max(1u,
+					(unsigned int) (parameters.markerFraction
+							* parameters.numberOfGenes)));
+	//Per cancer : tissue, tumor, then one set per subtype
+	unsigned int numberOfSets = parameters.cancers.size()
+			* (2 + parameters.subtypes);
+	markerSets.assign(numberOfSets, { });
+	std::vector<char> visited(parameters.numberOfGenes);
+	for (auto &markers : markerSets) {
+		//Breadth-first ball around a random node : a connected module
+		std::fill(visited.begin(), visited.end(), 0);
+		std::uniform_int_distribution<unsigned int> pickNode(0,
+				nodes.size() - 1);
+		std::queue<unsigned int> queue;
+		while (markers.size() < setSize) {
+			if (queue.empty()) {
+				unsigned int seed = nodes[pickNode(generator)];
+				if (visited[seed]) {
+					continue;
+				}
+				visited[seed] = 1;
+				queue.push(seed);
+			}
+			unsigned int u = queue.front();
+			queue.pop();
+			markers.push_back(u);
+			std::vector<unsigned int> neighbors = adjacency[u];
+			std::shuffle(neighbors.begin(), neighbors.end(), generator);
+			for (unsigned int v : neighbors) {
+				if (!visited[v]) {
+					visited[v] = 1;
+					queue.push(v);
+				}
+			}
+		}
+	}
+}
+
+void SyntheticDataGenerator::generateSamples() {
+	std::mt19937_64 generator(parameters.seed + 3);
+	std::uniform_int_distribution<unsigned int> pickSubtype(0,
+			parameters.subtypes - 1);
+	samples.clear();
+	for (const auto &cancer : parameters.cancers) {
+		//Control samples are matched normals of the first tumor patients
+		unsigned int numberOfPatients = std::max(parameters.tumorSamples,
+				parameters.controlSamples);
+		for (unsigned int p = 0; p < numberOfPatients; ++p) {
+			char number[16];
+			std::snprintf(number, sizeof(number), "%06u", p + 1);
+			std::string patientName = "TCGA-" + cancer + "-" + number;
+			int subtype = pickSubtype(generator);
+			if (p < parameters.tumorSamples) {
+				samples.push_back( { cancer, patientName, true, subtype });
+			}
+			if (p < parameters.controlSamples) {
+				samples.push_back( { cancer, patientName, false, -1 });
+			}
+		}
+	}
+}
+
+std::vector<unsigned int> SyntheticDataGenerator::sampleMarkerSets(
+		const Sample &sample) const {
+	unsigned int c = std::distance(parameters.cancers.begin(),
+			parameters.cancers.find(sample.cancer));
+	unsigned int base = c * (2 + parameters.subtypes);
+	std::vector<unsigned int> sets = { base };
+	if (sample.tumor) {
+		sets.push_back(base + 1);
+		sets.push_back(base + 2 + sample.subtype);
+	}
+	return sets;
+}
+
+void SyntheticDataGenerator::writeGraph() const {
+	std::string nodesFile = parameters.outputDirectory + "/"
+			+ GRAPH_DATA_DIRECTORY + GRAPH_NODE_FILE;
+	std::string edgesFile = parameters.outputDirectory + "/"
+			+ GRAPH_DATA_DIRECTORY + GRAPH_EDGE_FILE;
+	std::string buffer;
+	for (const auto &node : graphNodes) {
+		buffer += node + "\n";
+	}
+	writeBuffer(nodesFile, buffer);
+	buffer.clear();
+	for (const auto &edge : graphEdges) {
+		buffer += geneNames[edge.first] + " " + geneNames[edge.second] + "\n";
+	}
+	writeBuffer(edgesFile, buffer);
+	//A snapshot of a previous graph must not be reused
+	std::remove((edgesFile + ".snapshot").c_str());
+}
+
+void SyntheticDataGenerator::writeCancer(const std::string &cancer) const {
+	std::mt19937_64 generator(
+			parameters.seed + 4
+					+ std::distance(parameters.cancers.begin(),
+							parameters.cancers.find(cancer)));
+	std::bernoulli_distribution coin(0.5);
+	std::string patientList;
+	std::string clinical =
+			"bcr_patient_barcode\tgender\tvital_status\tsubtype\n";
+	for (const auto &sample : samples) {
+		if (sample.cancer != cancer) {
+			continue;
+		}
+		patientList += sample.patientName + (sample.tumor ? "-01\n" : "-11\n");
+		if (sample.tumor) {
+			clinical += sample.patientName + "\t"
+					+ (coin(generator) ? "FEMALE" : "MALE") + "\t"
+					+ (coin(generator) ? "Alive" : "Dead") + "\tSubtype"
+					+ std::to_string(sample.subtype + 1) + "\n";
+		}
+	}
+	writeBuffer(cancerDirectory(cancer) + "patient.list", patientList);
+	writeBuffer(cancerDirectory(cancer) + "clinical.tsv", clinical);
+}
+
+void SyntheticDataGenerator::writeExpression(unsigned int sampleIndex,
+		const std::string &filename) const {
+	std::mt19937_64 generator = sampleGenerator(parameters.seed, sampleIndex);
+	std::normal_distribution<float> noise(0.0f, 1.0f);
+	std::vector<float> shift(geneNames.size(), 0.0f);
+	for (unsigned int set : sampleMarkerSets(samples[sampleIndex])) {
+		for (unsigned int g : markerSets[set]) {
+			shift[g] += parameters.signal;
+		}
+	}
+
+	std::string buffer = "gene_id\tnormalized_count\n";
+	buffer.reserve(geneNames.size() * 32);
+	char value[32];
+	for (unsigned int g = 0; g < geneNames.size(); ++g) {
+		float log2Count = geneMeans[g] + shift[g]
+				+ geneDeviations[g] * noise(generator);
+		std::snprintf(value, sizeof(value), "%.4f",
+				std::max(0.0, std::exp2(log2Count) - 1.0));
+		buffer += geneNames[g];
+		buffer += '|';
+		buffer += std::to_string(100000 + g);
+		buffer += '\t';
+		buffer += value;
+		buffer += '\n';
+	}
+	writeBuffer(filename, buffer);
+}
@@ -0,0 +1,82 @@
+/*
+ * syntheticDataGenerator.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_GENERATOR_SYNTHETICDATAGENERATOR_HPP_
+#define SRC_GENERATOR_SYNTHETICDATAGENERATOR_HPP_
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdint>
+#include <utility>
+
+struct SyntheticDataParameters {
+	//Root of the data/ layout
+	std::string outputDirectory = ".";
+	std::set<std::string> cancers = { "BRCA", "LUAD" };
+	unsigned int tumorSamples = 100;
+	unsigned int controlSamples = 20;
+	unsigned int numberOfGenes = 20000;
+	//Tumor subtypes, stored in the "subtype" clinical attribute
+	unsigned int subtypes = 2;
+	//log2 fold change of the genes marking a class
+	double signal = 1.0;
+	//Fraction of the genes marking each cancer, tumor and subtype
+	double markerFraction = 0.01;
+	//0 means 80% of the genes
+	unsigned int graphGenes = 0;
+	//Edges added with each node (preferential attachment)
+	unsigned int graphDegree = 4;
+	std::uint64_t seed = 42;
+};
+
+// Writes a synthetic cohort in the layout read by TCGADataLoader and
+// PPIGraph : for every cancer, CANCER-normalized/patient.list, one
+// .genes.normalized.results file per sample and clinical.tsv, plus the
+// BioGRID node and edge files. Expression is log-normal per gene ; the genes
+// marking a class are a neighbourhood of the PPI graph, so that the Heinz
+// pipeline finds connected modules. The graph has a power-law degree
+// distribution (Barabasi-Albert). Samples are written in parallel, each from
+// its own random stream : the output only depends on the parameters.
+class SyntheticDataGenerator {
+public:
+	SyntheticDataGenerator(const SyntheticDataParameters &_parameters,
+			bool _verbose = true);
+	void generate();
+
+private:
+	struct Sample {
+		std::string cancer;
+		std::string patientName;
+		bool tumor;
+		//-1 for control samples
+		int subtype;
+	};
+
+	SyntheticDataParameters parameters;
+	bool verbose;
+	std::vector<std::string> geneNames;
+	std::vector<float> geneMeans;
+	std::vector<float> geneDeviations;
+	std::vector<std::string> graphNodes;
+	std::vector<std::pair<unsigned int, unsigned int>> graphEdges;
+	//Genes (indices in geneNames) of each marker set
+	std::vector<std::vector<unsigned int>> markerSets;
+	std::vector<Sample> samples;
+
+	void generateGenes();
+	void generateGraph();
+	void generateMarkers();
+	void generateSamples();
+	std::vector<unsigned int> sampleMarkerSets(const Sample &sample) const;
+	void writeGraph() const;
+	void writeCancer(const std::string &cancer) const;
+	void writeExpression(unsigned int sampleIndex,
+			const std::string &filename) const;
+	std::string cancerDirectory(const std::string &cancer) const;
+};
+
+#endif /* SRC_GENERATOR_SYNTHETICDATAGENERATOR_HPP_ */
@@ -0,0 +1,82 @@
+/*
+ * directoryWatcher.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "directoryWatcher.hpp"
+
+#include <thread>
+#include <chrono>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+DirectoryWatcher::DirectoryWatcher(const std::vector<std::string> &directories,
+		bool forcePolling) :
+		inotifyDescriptor(-1) {
+#ifdef __linux__
+	if (forcePolling) {
+		return;
+	}
+	inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyDescriptor < 0) {
+		return;
+	}
+	for (const auto &directory : directories) {
+		int watch = inotify_add_watch(inotifyDescriptor, directory.c_str(),
+				IN_CLOSE_WRITE | IN_MOVED_TO);
+		if (watch < 0) {
+			//Fall back to polling for everything
+			close(inotifyDescriptor);
+			inotifyDescriptor = -1;
+			watchedDirectories.clear();
+			return;
+		}
+		watchedDirectories[watch] = directory;
+	}
+#endif
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+	if (inotifyDescriptor >= 0) {
+		close(inotifyDescriptor);
+	}
+}
+
+std::vector<std::string> DirectoryWatcher::waitForFiles(
+		int timeoutMilliseconds, bool *overflowed) {
+	std::vector<std::string> files;
+	*overflowed = false;
+	if (isPolling()) {
+		std::this_thread::sleep_for(
+				std::chrono::milliseconds(timeoutMilliseconds));
+		return files;
+	}
+#ifdef __linux__
+	pollfd descriptor = { inotifyDescriptor, POLLIN, 0 };
+	if (poll(&descriptor, 1, timeoutMilliseconds) <= 0) {
+		return files;
+	}
+	alignas(inotify_event) char buffer[64 * 1024];
+	ssize_t length;
+	while ((length = read(inotifyDescriptor, buffer, sizeof(buffer))) > 0) {
+		for (char *current = buffer; current < buffer + length;) {
+			const inotify_event *event =
+					reinterpret_cast<const inotify_event *>(current);
+			//Not tied to a watch (wd is -1)
+			if (event->mask & IN_Q_OVERFLOW) {
+				*overflowed = true;
+			}
+			auto it = watchedDirectories.find(event->wd);
+			if (event->len > 0 && it != watchedDirectories.end()) {
+				files.push_back(it->second + event->name);
+			}
+			current += sizeof(inotify_event) + event->len;
+		}
+	}
+#endif
+	return files;
+}
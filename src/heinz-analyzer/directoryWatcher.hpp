@@ -0,0 +1,39 @@
+/*
+ * directoryWatcher.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_DIRECTORYWATCHER_HPP_
+#define SRC_HEINZ_ANALYZER_DIRECTORYWATCHER_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Reports the files written (closed after writing, or moved in) in a set of
+// directories. Uses inotify on Linux ; elsewhere, or if inotify is not
+// available, isPolling() is true and the caller has to look for itself.
+class DirectoryWatcher {
+public:
+	DirectoryWatcher(const std::vector<std::string> &directories,
+			bool forcePolling = false);
+	~DirectoryWatcher();
+	DirectoryWatcher(const DirectoryWatcher &) = delete;
+	DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+	bool isPolling() const {
+		return inotifyDescriptor < 0;
+	}
+	//Blocks at most timeoutMilliseconds ; returns full paths. overflowed is
+	//set when the kernel queue overflowed : events were lost and the
+	//directories should be scanned again.
+	std::vector<std::string> waitForFiles(int timeoutMilliseconds,
+			bool *overflowed);
+
+private:
+	int inotifyDescriptor;
+	std::map<int, std::string> watchedDirectories;
+};
+
+#endif /* SRC_HEINZ_ANALYZER_DIRECTORYWATCHER_HPP_ */
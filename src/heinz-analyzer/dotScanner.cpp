@@ -0,0 +1,110 @@
+/*
+ * dotScanner.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "dotScanner.hpp"
+
+#include <cstring>
+
+namespace {
+
+inline bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+inline bool isNameChar(char c) {
+	return (c >= 'A' && c <= 'Z') || isDigit(c) || c == '-';
+}
+
+inline bool isValueChar(char c) {
+	return isDigit(c) || c == '-' || c == '.';
+}
+
+//Consumes the longest run of characters satisfying the predicate
+template<typename Predicate>
+inline const char *skipWhile(const char *p, const char *end,
+		Predicate predicate) {
+	while (p != end && predicate(*p)) {
+		++p;
+	}
+	return p;
+}
+
+inline const char *skipLiteral(const char *p, const char *end,
+		const char *literal, std::size_t length) {
+	if ((std::size_t) (end - p) < length || std::memcmp(p, literal, length) != 0) {
+		return nullptr;
+	}
+	return p + length;
+}
+
+}
+
+// Every sub-pattern is followed by a character it cannot match, so the
+// greedy run is the only candidate and no backtracking is needed. A match
+// starting inside a run of digits would also match from the start of that
+// run, hence only run starts have to be tried to find the leftmost match.
+
+bool HeinzDotScanner::scanNode(const char *begin, const char *end,
+		Node *node) {
+	static const char labelLiteral[] = " [label=\"";
+	static const char newlineLiteral[] = "\\n";
+	const char *p = begin;
+	while (p != end) {
+		if (!isDigit(*p)) {
+			++p;
+			continue;
+		}
+		const char *idEnd = skipWhile(p, end, isDigit);
+		const char *q = skipLiteral(idEnd, end, labelLiteral,
+				sizeof(labelLiteral) - 1);
+		if (q != nullptr) {
+			const char *nameEnd = skipWhile(q, end, isNameChar);
+			const char *r =
+					(nameEnd != q) ?
+							skipLiteral(nameEnd, end, newlineLiteral,
+									sizeof(newlineLiteral) - 1) :
+							nullptr;
+			if (r != nullptr) {
+				const char *valueEnd = skipWhile(r, end, isValueChar);
+				if (valueEnd != r
+						&& skipLiteral(valueEnd, end, newlineLiteral,
+								sizeof(newlineLiteral) - 1) != nullptr) {
+					node->heinzId = Token(p, idEnd);
+					node->name = Token(q, nameEnd);
+					node->value = Token(r, valueEnd);
+					return true;
+				}
+			}
+		}
+		p = idEnd;
+	}
+	return false;
+}
+
+bool HeinzDotScanner::scanEdge(const char *begin, const char *end,
+		Edge *edge) {
+	static const char edgeLiteral[] = " -- ";
+	const char *p = begin;
+	while (p != end) {
+		if (!isDigit(*p)) {
+			++p;
+			continue;
+		}
+		const char *idEnd = skipWhile(p, end, isDigit);
+		const char *q = skipLiteral(idEnd, end, edgeLiteral,
+				sizeof(edgeLiteral) - 1);
+		if (q != nullptr) {
+			const char *id2End = skipWhile(q, end, isDigit);
+			if (id2End != q) {
+				edge->heinzId1 = Token(p, idEnd);
+				edge->heinzId2 = Token(q, id2End);
+				return true;
+			}
+		}
+		p = idEnd;
+	}
+	return false;
+}
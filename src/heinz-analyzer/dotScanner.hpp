@@ -0,0 +1,41 @@
+/*
+ * dotScanner.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_DOTSCANNER_HPP_
+#define SRC_HEINZ_ANALYZER_DOTSCANNER_HPP_
+
+#include <string>
+#include <utility>
+
+// Scanner for the node and edge lines of the DOT files written by Heinz.
+// Tokens point into the scanned line : nothing is copied.
+class HeinzDotScanner {
+public:
+	typedef std::pair<const char *, const char *> Token;
+
+	struct Node {
+		Token heinzId;
+		Token name;
+		Token value;
+	};
+
+	struct Edge {
+		Token heinzId1;
+		Token heinzId2;
+	};
+
+	// Same as std::regex_search with
+	// ([0-9]+) \[label="([A-Z0-9\-]+)\\n([-.0-9]+)\\n
+	static bool scanNode(const char *begin, const char *end, Node *node);
+	// Same as std::regex_search with ([0-9]+) -- ([0-9]+)
+	static bool scanEdge(const char *begin, const char *end, Edge *edge);
+
+	static std::string toString(const Token &token) {
+		return std::string(token.first, token.second);
+	}
+};
+
+#endif /* SRC_HEINZ_ANALYZER_DOTSCANNER_HPP_ */
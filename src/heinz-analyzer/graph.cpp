@@ -10,10 +10,121 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <functional>
+#include <cctype>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "graph.hpp"
 #include "../config.hpp"
+#include "../utilities.hpp"
+#include "../exportWriter.hpp"
+#include "../tcga-analyzer/typedefs.hpp"
+#include "../trace.hpp"
 
-PPIGraph::NodeIDType PPIGraph::getNodeId(const NodeNameType &name) {
+namespace {
+
+//In-memory storage of a frozen graph
+struct GraphArrays {
+	std::vector<char> nameTable;
+	std::vector<unsigned int> nameOffsets;
+	std::vector<PPIGraph::NodeIDType> idsSortedByName;
+	std::vector<PPIGraph::NodeValueType> values;
+	std::vector<unsigned int> offsets;
+	std::vector<PPIGraph::NodeIDType> neighbors;
+};
+
+//Read-only mapping of a whole file
+class MappedFile {
+public:
+	MappedFile(const std::string &filename) :
+			address(nullptr), length(0) {
+		int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return;
+		}
+		struct stat status;
+		if (fstat(fd, &status) == 0 && status.st_size > 0) {
+			void *p = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd,
+					0);
+			if (p != MAP_FAILED) {
+				address = p;
+				length = status.st_size;
+			}
+		}
+		close(fd);
+	}
+	~MappedFile() {
+		if (address != nullptr) {
+			munmap(address, length);
+		}
+	}
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+	const char *data() const {
+		return static_cast<const char *>(address);
+	}
+	std::size_t size() const {
+		return length;
+	}
+private:
+	void *address;
+	std::size_t length;
+};
+
+//Snapshot layout : header, then 8-byte aligned sections (values,
+//nameOffsets, idsSortedByName, offsets, neighbors, nameTable)
+const char SNAPSHOT_MAGIC[8] = { 'P', 'P', 'I', 'G', 'S', 'N', 'A', 'P' };
+const std::uint32_t SNAPSHOT_VERSION = 1;
+
+struct SourceFileStamp {
+	std::int64_t size;
+	std::int64_t modificationSeconds;
+	std::int64_t modificationNanoseconds;
+};
+
+struct SnapshotHeader {
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t labelledGraph;
+	std::uint32_t numberOfNodes;
+	std::uint32_t numberOfEdges;
+	std::uint64_t numberOfNeighbors;
+	std::uint64_t nameTableSize;
+	SourceFileStamp nodesFileStamp;
+	SourceFileStamp edgesFileStamp;
+};
+
+bool getFileStamp(const std::string &filename, SourceFileStamp *stamp) {
+	struct stat status;
+	if (stat(filename.c_str(), &status) != 0) {
+		return false;
+	}
+	stamp->size = status.st_size;
+	stamp->modificationSeconds = status.st_mtim.tv_sec;
+	stamp->modificationNanoseconds = status.st_mtim.tv_nsec;
+	return true;
+}
+
+bool operator==(const SourceFileStamp &a, const SourceFileStamp &b) {
+	return a.size == b.size && a.modificationSeconds == b.modificationSeconds
+			&& a.modificationNanoseconds == b.modificationNanoseconds;
+}
+
+std::size_t alignedSize(std::size_t size) {
+	return (size + 7) & ~(std::size_t) 7;
+}
+
+}
+
+PPIGraphBuilder::NodeIDType PPIGraphBuilder::getNodeId(
+		const NodeNameType &name) const {
 	auto it = nameToId.find(name);
 	if (it == nameToId.end()) {
 		throw std::invalid_argument("The node is not in the graph.");
@@ -21,112 +132,359 @@ PPIGraph::NodeIDType PPIGraph::getNodeId(const NodeNameType &name) {
 	return it->second;
 }
 
-void PPIGraph::addNode(const NodeNameType &name, NodeValueType value) {
+void PPIGraphBuilder::addNode(const NodeNameType &name, NodeValueType value) {
 	if (nameToId.find(name) == nameToId.end()) {
 		NodeIDType id = nodes.size();
 		nodes.push_back( { name, value });
 		nameToId.insert( { name, id });
-		adjacencyList.push_back(std::set<NodeIDType>());
 	}
 }
 
-void PPIGraph::addEdge(const NodeNameType &name1, const NodeNameType &name2) {
-	NodeIDType id1 = getNodeId(name1);
-	NodeIDType id2 = getNodeId(name2);
-	adjacencyList[id1].insert(id2);
-	adjacencyList[id2].insert(id1);
+void PPIGraphBuilder::addEdge(const NodeNameType &name1,
+		const NodeNameType &name2) {
+	edges.push_back( { getNodeId(name1), getNodeId(name2) });
 }
 
-unsigned int PPIGraph::getOutDegree(const NodeNameType &name) {
-	NodeIDType id = getNodeId(name);
-	return adjacencyList[id].size();
+unsigned int PPIGraphBuilder::size() const {
+	return nodes.size();
 }
 
-PPIGraph::NodeValueType PPIGraph::getNodeValue(const NodeNameType &name) {
-	NodeIDType id = getNodeId(name);
-	return nodes[id].second;
+std::shared_ptr<PPIGraph> PPIGraphBuilder::build() const {
+	std::shared_ptr<GraphArrays> arrays = std::make_shared<GraphArrays>();
+	GraphArrays &graph = *arrays;
+	unsigned int N = nodes.size();
+
+	//Names and values
+	graph.nameOffsets.reserve(N + 1);
+	graph.nameOffsets.push_back(0);
+	graph.values.reserve(N);
+	for (const auto &node : nodes) {
+		graph.nameTable.insert(graph.nameTable.end(), node.first.begin(),
+				node.first.end());
+		graph.nameOffsets.push_back(graph.nameTable.size());
+		graph.values.push_back(node.second);
+	}
+	graph.idsSortedByName.resize(N);
+	for (NodeIDType id = 0; id < N; ++id) {
+		graph.idsSortedByName[id] = id;
+	}
+	std::sort(graph.idsSortedByName.begin(), graph.idsSortedByName.end(),
+			[&](NodeIDType a, NodeIDType b) {
+				return nodes[a].first < nodes[b].first;
+			});
+
+	//Adjacency : count, fill, then sort and remove duplicate edges
+	std::vector<unsigned int> degrees(N + 1, 0);
+	for (const auto &edge : edges) {
+		++degrees[edge.first];
+		if (edge.first != edge.second) {
+			++degrees[edge.second];
+		}
+	}
+	std::vector<unsigned int> rawOffsets(N + 1, 0);
+	for (unsigned int i = 0; i < N; ++i) {
+		rawOffsets[i + 1] = rawOffsets[i] + degrees[i];
+	}
+	std::vector<NodeIDType> rawNeighbors(rawOffsets[N]);
+	std::vector<unsigned int> position(rawOffsets.begin(), rawOffsets.end() - 1);
+	for (const auto &edge : edges) {
+		rawNeighbors[position[edge.first]++] = edge.second;
+		if (edge.first != edge.second) {
+			rawNeighbors[position[edge.second]++] = edge.first;
+		}
+	}
+
+	graph.offsets.resize(N + 1);
+	graph.offsets[0] = 0;
+	graph.neighbors.reserve(rawNeighbors.size());
+	for (unsigned int i = 0; i < N; ++i) {
+		auto begin = rawNeighbors.begin() + rawOffsets[i];
+		auto end = rawNeighbors.begin() + rawOffsets[i + 1];
+		std::sort(begin, end);
+		graph.neighbors.insert(graph.neighbors.end(), begin,
+				std::unique(begin, end));
+		graph.offsets[i + 1] = graph.neighbors.size();
+	}
+	graph.neighbors.shrink_to_fit();
+
+	std::shared_ptr<PPIGraph> graphPtr = std::make_shared<PPIGraph>();
+	graphPtr->nameTable = graph.nameTable.data();
+	graphPtr->nameOffsets = graph.nameOffsets.data();
+	graphPtr->idsSortedByName = graph.idsSortedByName.data();
+	graphPtr->values = graph.values.data();
+	graphPtr->offsets = graph.offsets.data();
+	graphPtr->neighbors = graph.neighbors.data();
+	graphPtr->numberOfNodes = N;
+	graphPtr->numberOfEdges = graph.neighbors.size() / 2;
+	graphPtr->storage = arrays;
+	return graphPtr;
 }
 
-unsigned int PPIGraph::size() {
-	return nodes.size();
+bool PPIGraph::findNode(const NodeNameType &name, NodeIDType *id) const {
+	auto compare = [&](NodeIDType a, const NodeNameType &b) {
+		const char *aBegin = nameTable + nameOffsets[a];
+		std::size_t aLength = nameOffsets[a + 1] - nameOffsets[a];
+		int c = std::memcmp(aBegin, b.data(), std::min(aLength, b.size()));
+		return c < 0 || (c == 0 && aLength < b.size());
+	};
+	const NodeIDType *end = idsSortedByName + numberOfNodes;
+	const NodeIDType *it = std::lower_bound(idsSortedByName, end, name,
+			compare);
+	if (it == end || getNodeName(*it) != name) {
+		return false;
+	}
+	*id = *it;
+	return true;
 }
 
-unsigned int PPIGraph::edgeCount() {
-	unsigned int count = 0;
-	std::for_each(adjacencyList.cbegin(), adjacencyList.cend(),
-			[&](const std::set<NodeIDType> &s) {
-				count += s.size();
-			});
-	return count / 2;
+bool PPIGraph::hasNode(const NodeNameType &name) const {
+	NodeIDType id;
+	return findNode(name, &id);
+}
+
+PPIGraph::NodeIDType PPIGraph::getNodeId(const NodeNameType &name) const {
+	NodeIDType id;
+	if (!findNode(name, &id)) {
+		throw std::invalid_argument("The node is not in the graph.");
+	}
+	return id;
 }
 
-void PPIGraph::printDegreeStatistics() {
+PPIGraph::NodeNameType PPIGraph::getNodeName(NodeIDType id) const {
+	return NodeNameType(nameTable + nameOffsets[id],
+			nameOffsets[id + 1] - nameOffsets[id]);
+}
+
+unsigned int PPIGraph::getOutDegree(const NodeNameType &name) const {
+	return getOutDegree(getNodeId(name));
+}
+
+PPIGraph::NodeValueType PPIGraph::getNodeValue(const NodeNameType &name) const {
+	return getNodeValue(getNodeId(name));
+}
+
+void PPIGraph::printDegreeStatistics() const {
 	std::map<int, int> degrees;
-	std::for_each(adjacencyList.cbegin(), adjacencyList.cend(),
-			[&](const std::set<NodeIDType> &s) {
-				++degrees[s.size()];
-			});
+	for (NodeIDType id = 0; id < size(); ++id) {
+		++degrees[getOutDegree(id)];
+	}
 	std::for_each(degrees.cbegin(), degrees.cend(),
 			[](const std::pair<int, int> &p) {
 				std::cout << p.first << " " << p.second << std::endl;
 			});
 }
 
-void PPIGraph::printNodes() {
-	std::for_each(nodes.cbegin(), nodes.cend(),
-			[](const std::pair<NodeNameType, NodeValueType> &pair) {
-				std::cout << "{" << pair.first << ", " << pair.second << "}" << std::endl;
-			});
+void PPIGraph::printNodes() const {
+	for (NodeIDType id = 0; id < size(); ++id) {
+		std::cout << "{" << getNodeName(id) << ", " << getNodeValue(id) << "}"
+				<< std::endl;
+	}
+}
+
+void PPIGraph::printNodesToFile(const std::string &filename) const {
+	ExportStream output(filename);
+	for (NodeIDType id = 0; id < size(); ++id) {
+		output << getNodeName(id) << " " << getNodeValue(id) << std::endl;
+	}
 }
 
 std::shared_ptr<PPIGraph> PPIGraph::buildFromFile(const std::string &nodesFile,
 		const std::string &edgesFile, bool labelledGraph) {
-	std::shared_ptr<PPIGraph> graphPtr = std::make_shared<PPIGraph>();
+	ScopedTimer timer("graph/load");
+	std::string snapshotFile = edgesFile + ".snapshot";
+	std::shared_ptr<PPIGraph> graphPtr = loadSnapshot(snapshotFile, nodesFile,
+			edgesFile, labelledGraph);
+
+	if (graphPtr) {
+		std::cout << "Loaded graph snapshot with " << graphPtr->size()
+				<< " nodes and " << graphPtr->edgeCount() << " edges."
+				<< std::endl;
+	} else {
+		graphPtr = buildFromTextFiles(nodesFile, edgesFile, labelledGraph);
+		graphPtr->saveSnapshot(snapshotFile, nodesFile, edgesFile,
+				labelledGraph);
+		std::cout << "Built graph with " << graphPtr->size() << " nodes and "
+				<< graphPtr->edgeCount() << " edges." << std::endl;
+	}
 
-	std::ifstream inputFileNodes(nodesFile);
-	std::string line;
-
-	while (std::getline(inputFileNodes, line)) {
-		std::stringstream ss(line);
-		NodeValueType value = NodeValueType();
-		NodeNameType nodeName;
-		if (labelledGraph) {
-			ss >> nodeName >> value;
-		} else {
-			ss >> nodeName;
+	return graphPtr;
+}
+
+std::shared_ptr<PPIGraph> PPIGraph::buildFromTextFiles(
+		const std::string &nodesFile, const std::string &edgesFile,
+		bool labelledGraph) {
+	PPIGraphBuilder builder;
+
+	//Same as reading each line with operator>> : missing fields are empty
+	auto forEachLine = [](const std::string &content,
+			const std::function<void(const std::vector<std::string> &)> &f) {
+		std::vector<std::string> fields;
+		const char *current = content.data();
+		const char *end = current + content.size();
+		while (current < end) {
+			const char *lineEnd = static_cast<const char *>(std::memchr(current,
+					'\n', end - current));
+			if (lineEnd == nullptr) {
+				lineEnd = end;
+			}
+			fields.clear();
+			const char *p = current;
+			while (fields.size() < 2) {
+				while (p != lineEnd && std::isspace((unsigned char) *p)) {
+					++p;
+				}
+				const char *tokenBegin = p;
+				while (p != lineEnd && !std::isspace((unsigned char) *p)) {
+					++p;
+				}
+				fields.push_back(std::string(tokenBegin, p));
+			}
+			f(fields);
+			current = lineEnd + 1;
 		}
+	};
 
-		graphPtr->addNode(nodeName, value);
-	}
+	forEachLine(readFileContent(nodesFile),
+			[&](const std::vector<std::string> &fields) {
+				NodeValueType value = NodeValueType();
+				if (labelledGraph && !fields[1].empty()) {
+					value = std::strtod(fields[1].c_str(), nullptr);
+				}
+				builder.addNode(fields[0], value);
+			});
 
-	std::ifstream inputFileEdges(edgesFile);
-	while (std::getline(inputFileEdges, line)) {
-		std::stringstream ss(line);
-		NodeNameType node1;
-		NodeNameType node2;
-		ss >> node1 >> node2;
-		graphPtr->addEdge(node1, node2);
+	forEachLine(readFileContent(edgesFile),
+			[&](const std::vector<std::string> &fields) {
+				builder.addEdge(fields[0], fields[1]);
+			});
+
+	return builder.build();
+}
+
+void PPIGraph::saveSnapshot(const std::string &snapshotFile,
+		const std::string &nodesFile, const std::string &edgesFile,
+		bool labelledGraph) const {
+	SnapshotHeader header;
+	std::memset(&header, 0, sizeof(header));
+	if (!getFileStamp(nodesFile, &header.nodesFileStamp)
+			|| !getFileStamp(edgesFile, &header.edgesFileStamp)) {
+		return;
 	}
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.version = SNAPSHOT_VERSION;
+	header.labelledGraph = labelledGraph;
+	header.numberOfNodes = numberOfNodes;
+	header.numberOfEdges = numberOfEdges;
+	header.numberOfNeighbors = offsets[numberOfNodes];
+	header.nameTableSize = nameOffsets[numberOfNodes];
 
-	std::cout << "Built graph with " << graphPtr->size() << " nodes and "
-			<< graphPtr->edgeCount() << " edges." << std::endl;
+	//Written next to the final file, then renamed : readers never see a
+	//partial snapshot
+	std::string temporaryFile = temporaryFilename(snapshotFile);
+	std::ofstream output(temporaryFile, std::ios::binary);
+	const char padding[8] = { 0 };
+	auto writeSection = [&](const void *data, std::size_t size) {
+		output.write(static_cast<const char *>(data), size);
+		output.write(padding, alignedSize(size) - size);
+	};
+	writeSection(&header, sizeof(header));
+	writeSection(values, numberOfNodes * sizeof(NodeValueType));
+	writeSection(nameOffsets, (numberOfNodes + 1) * sizeof(unsigned int));
+	writeSection(idsSortedByName, numberOfNodes * sizeof(NodeIDType));
+	writeSection(offsets, (numberOfNodes + 1) * sizeof(unsigned int));
+	writeSection(neighbors, header.numberOfNeighbors * sizeof(NodeIDType));
+	writeSection(nameTable, header.nameTableSize);
+	output.close();
 
-	return graphPtr;
+	if (!output || std::rename(temporaryFile.c_str(), snapshotFile.c_str()) != 0) {
+		std::remove(temporaryFile.c_str());
+		std::cout << "Warning : could not write graph snapshot "
+				<< snapshotFile << "." << std::endl;
+	}
 }
 
-const std::vector<std::pair<PPIGraph::NodeNameType, PPIGraph::NodeValueType>> &PPIGraph::getNodesHandler() const {
-	return nodes;
-}
+std::shared_ptr<PPIGraph> PPIGraph::loadSnapshot(
+		const std::string &snapshotFile, const std::string &nodesFile,
+		const std::string &edgesFile, bool labelledGraph) {
+	std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(
+			snapshotFile);
+	if (file->size() < sizeof(SnapshotHeader)) {
+		return nullptr;
+	}
 
-std::vector<std::pair<PPIGraph::NodeNameType, PPIGraph::NodeValueType>> &PPIGraph::getNodesHandler() {
-	return nodes;
-}
+	SnapshotHeader header;
+	std::memcpy(&header, file->data(), sizeof(header));
+	SourceFileStamp nodesFileStamp;
+	SourceFileStamp edgesFileStamp;
+	if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+			|| header.version != SNAPSHOT_VERSION
+			|| header.labelledGraph != (std::uint32_t) labelledGraph
+			|| !getFileStamp(nodesFile, &nodesFileStamp)
+			|| !getFileStamp(edgesFile, &edgesFileStamp)
+			|| !(header.nodesFileStamp == nodesFileStamp)
+			|| !(header.edgesFileStamp == edgesFileStamp)) {
+		return nullptr;
+	}
 
-void PPIGraph::printNodesToFile(const std::string &filename) {
-	std::ofstream output(filename);
-	std::for_each(nodes.cbegin(), nodes.cend(),
-			[&](const std::pair<NodeNameType, NodeValueType> &pair) {
-				output << pair.first << " " << pair.second << std::endl;
-			});
-}
+	//Counts larger than the file would overflow the section sizes
+	if (header.numberOfNeighbors > file->size() / sizeof(NodeIDType)
+			|| header.nameTableSize > file->size()) {
+		throw tcga_data_exception(
+				"Corrupt graph snapshot " + snapshotFile
+						+ " : section sizes larger than the file.");
+	}
+	std::size_t N = header.numberOfNodes;
+	std::size_t sectionSizes[] = { sizeof(header), N * sizeof(NodeValueType), (N
+			+ 1) * sizeof(unsigned int), N * sizeof(NodeIDType), (N + 1)
+			* sizeof(unsigned int), header.numberOfNeighbors
+			* sizeof(NodeIDType), header.nameTableSize };
+	std::size_t sectionOffsets[7];
+	std::size_t total = 0;
+	for (unsigned int i = 0; i < 7; ++i) {
+		sectionOffsets[i] = total;
+		if (sectionOffsets[i] + sectionSizes[i] > file->size()) {
+			throw tcga_data_exception(
+					"Corrupt graph snapshot " + snapshotFile + " : section "
+							+ std::to_string(i) + " ends after the "
+							+ std::to_string(file->size()) + " bytes of the file.");
+		}
+		total += alignedSize(sectionSizes[i]);
+	}
+
+	std::shared_ptr<PPIGraph> graphPtr = std::make_shared<PPIGraph>();
+	const char *base = file->data();
+	graphPtr->values =
+			reinterpret_cast<const NodeValueType *>(base + sectionOffsets[1]);
+	graphPtr->nameOffsets =
+			reinterpret_cast<const unsigned int *>(base + sectionOffsets[2]);
+	graphPtr->idsSortedByName =
+			reinterpret_cast<const NodeIDType *>(base + sectionOffsets[3]);
+	graphPtr->offsets =
+			reinterpret_cast<const unsigned int *>(base + sectionOffsets[4]);
+	graphPtr->neighbors =
+			reinterpret_cast<const NodeIDType *>(base + sectionOffsets[5]);
+	graphPtr->nameTable = base + sectionOffsets[6];
+	graphPtr->numberOfNodes = header.numberOfNodes;
+	graphPtr->numberOfEdges = header.numberOfEdges;
+	graphPtr->storage = file;
 
+	//Offsets and IDs are followed without checks by the accessors
+	bool valid = graphPtr->offsets[0] == 0
+			&& graphPtr->offsets[N] == header.numberOfNeighbors
+			&& graphPtr->nameOffsets[0] == 0
+			&& graphPtr->nameOffsets[N] == header.nameTableSize;
+	for (std::size_t i = 0; valid && i < N; ++i) {
+		valid = graphPtr->offsets[i] <= graphPtr->offsets[i + 1]
+				&& graphPtr->nameOffsets[i] <= graphPtr->nameOffsets[i + 1]
+				&& graphPtr->idsSortedByName[i] < N;
+	}
+	for (std::size_t i = 0; valid && i < header.numberOfNeighbors; ++i) {
+		valid = graphPtr->neighbors[i] < N;
+	}
+	if (!valid) {
+		throw tcga_data_exception(
+				"Corrupt graph snapshot " + snapshotFile
+						+ " : offsets or node IDs out of range.");
+	}
+	return graphPtr;
+}
@@ -9,44 +9,104 @@
 #define SRC_HEINZ_ANALYZER_GRAPH_HPP_
 
 #include <vector>
-#include <list>
-#include <map>
-#include <set>
+#include <unordered_map>
 #include <string>
 #include <utility>
 #include <memory>
 
-class PPIGraph {
+class PPIGraph;
+
+// Collects nodes and edges, then freezes them into a PPIGraph
+class PPIGraphBuilder {
 public:
 	typedef unsigned int NodeIDType;
 	typedef double NodeValueType;
 	typedef std::string NodeNameType;
 
-	PPIGraph() = default;
+	PPIGraphBuilder() = default;
 
 	void addNode(const NodeNameType &name, NodeValueType value = NodeValueType());
 	void addEdge(const NodeNameType &node1, const NodeNameType &node2);
+	unsigned int size() const;
 
-	unsigned int size();
-	unsigned int edgeCount();
-	unsigned int getOutDegree(const NodeNameType &name);
-	NodeValueType getNodeValue(const NodeNameType &name);
+	std::shared_ptr<PPIGraph> build() const;
 
+private:
+	std::vector<std::pair<NodeNameType, NodeValueType>> nodes;
+	std::unordered_map<NodeNameType, NodeIDType> nameToId;
+	std::vector<std::pair<NodeIDType, NodeIDType>> edges;
+	NodeIDType getNodeId(const NodeNameType &name) const;
+};
+
+// Immutable graph : adjacency in compressed sparse row form, node names
+// interned in a single string table and looked up by binary search.
+// The arrays live either in memory or in a memory-mapped binary snapshot.
+class PPIGraph {
+public:
+	typedef PPIGraphBuilder::NodeIDType NodeIDType;
+	typedef PPIGraphBuilder::NodeValueType NodeValueType;
+	typedef PPIGraphBuilder::NodeNameType NodeNameType;
+
+	unsigned int size() const {
+		return numberOfNodes;
+	}
+	unsigned int edgeCount() const {
+		return numberOfEdges;
+	}
+	unsigned int getOutDegree(NodeIDType id) const {
+		return offsets[id + 1] - offsets[id];
+	}
+	unsigned int getOutDegree(const NodeNameType &name) const;
+	NodeValueType getNodeValue(NodeIDType id) const {
+		return values[id];
+	}
+	NodeValueType getNodeValue(const NodeNameType &name) const;
+	NodeNameType getNodeName(NodeIDType id) const;
+	bool hasNode(const NodeNameType &name) const;
+	//Throws for a name which is not in the graph
+	NodeIDType getNodeId(const NodeNameType &name) const;
+	bool findNode(const NodeNameType &name, NodeIDType *id) const;
+
+	const NodeIDType *neighborsBegin(NodeIDType id) const {
+		return neighbors + offsets[id];
+	}
+	const NodeIDType *neighborsEnd(NodeIDType id) const {
+		return neighbors + offsets[id + 1];
+	}
+
+	//Uses (and refreshes when the text files changed) edgesFile.snapshot
 	static std::shared_ptr<PPIGraph> buildFromFile(const std::string &nodesFile,
 			const std::string &edgesFile, bool labelledGraph = false);
+	static std::shared_ptr<PPIGraph> buildFromTextFiles(
+			const std::string &nodesFile, const std::string &edgesFile,
+			bool labelledGraph = false);
 
-	void printDegreeStatistics();
-	void printNodes();
-	void printNodesToFile(const std::string &filename);
+	//The snapshot records the size and modification time of the text files
+	void saveSnapshot(const std::string &snapshotFile,
+			const std::string &nodesFile, const std::string &edgesFile,
+			bool labelledGraph) const;
+	//Returns nullptr if the snapshot is missing or out of date
+	static std::shared_ptr<PPIGraph> loadSnapshot(
+			const std::string &snapshotFile, const std::string &nodesFile,
+			const std::string &edgesFile, bool labelledGraph);
 
-	const std::vector<std::pair<NodeNameType, NodeValueType>> &getNodesHandler() const;
-	std::vector<std::pair<NodeNameType, NodeValueType>> &getNodesHandler();
+	void printDegreeStatistics() const;
+	void printNodes() const;
+	void printNodesToFile(const std::string &filename) const;
 
 private:
-	std::vector<std::pair<NodeNameType, NodeValueType>> nodes;
-	std::map<NodeNameType, NodeIDType> nameToId;
-	std::vector<std::set<NodeIDType>> adjacencyList;
-	NodeIDType getNodeId(const NodeNameType &name);
+	friend class PPIGraphBuilder;
+
+	const char *nameTable = nullptr;
+	const unsigned int *nameOffsets = nullptr;
+	const NodeIDType *idsSortedByName = nullptr;
+	const NodeValueType *values = nullptr;
+	const unsigned int *offsets = nullptr;
+	const NodeIDType *neighbors = nullptr;
+	unsigned int numberOfNodes = 0;
+	unsigned int numberOfEdges = 0;
+	//Owns the memory the arrays point to
+	std::shared_ptr<const void> storage;
 };
 
 #endif /* SRC_HEINZ_ANALYZER_GRAPH_HPP_ */
@@ -0,0 +1,386 @@
+/*
+ * heinzJobScheduler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "heinzJobScheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#include <stdexcept>
+#include <cstdio>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include "../config.hpp"
+#include "../threads.hpp"
+#include "../trace.hpp"
+#include "../utilities.hpp"
+#include "../tcga-analyzer/TCGADataNormalizer.hpp"
+#include "positiveComponents.hpp"
+
+namespace {
+
+const std::string CHECKPOINT_FILE = HEINZ_DIRECTORY + "checkpoint.txt";
+
+long long fileSize(const std::string &path) {
+	struct stat fileStat;
+	if (stat(path.c_str(), &fileStat) != 0) {
+		return -1;
+	}
+	return fileStat.st_size;
+}
+
+bool writeAll(int descriptor, const std::string &content) {
+	const char *data = content.data();
+	std::size_t remaining = content.size();
+	while (remaining > 0) {
+		ssize_t written = write(descriptor, data, remaining);
+		if (written < 0 && errno == EINTR) {
+			continue;
+		}
+		if (written < 0) {
+			return false;
+		}
+		data += written;
+		remaining -= written;
+	}
+	return true;
+}
+
+//Single-quoted for sh : file names and sample IDs are never interpreted
+std::string quoteForShell(const std::string &value) {
+	std::string quoted = "'";
+	for (char c : value) {
+		if (c == '\'') {
+			quoted += "'\\''";
+		} else {
+			quoted += c;
+		}
+	}
+	return quoted + "'";
+}
+
+void replaceAll(std::string *s, const std::string &pattern,
+		const std::string &value) {
+	std::size_t position = 0;
+	while ((position = s->find(pattern, position)) != std::string::npos) {
+		s->replace(position, pattern.size(), value);
+		position += value.size();
+	}
+}
+
+}
+
+HeinzJobScheduler::HeinzJobScheduler(const std::vector<WeightType> &_weights,
+		const std::vector<std::string> &_patientIDs,
+		const std::string &_solverCommand, const std::string &_edgesFile,
+		unsigned int _numberOfWorkers, unsigned int _timeoutSeconds,
+		bool _resume, bool _verbose) :
+		solverCommand(_solverCommand), edgesFile(_edgesFile), numberOfWorkers(
+				_numberOfWorkers), timeoutSeconds(_timeoutSeconds), resume(
+				_resume), verbose(_verbose), nextJob(0), checkpointDescriptor(
+				-1) {
+	numberOfWorkers = ThreadBudget::getWorkers(numberOfWorkers);
+	for (const auto &weight : _weights) {
+		for (const auto &patientID : _patientIDs) {
+			Job job;
+			job.fileBasename = weight + "_" + patientID;
+			job.weight = weight;
+			job.patientID = patientID;
+			job.inputFile = HEINZ_INPUT_DIRECTORY + job.fileBasename + ".txt";
+			job.outputFile = HEINZ_RAW_OUTPUT_DIRECTORY + weight + "/"
+					+ job.fileBasename + ".txt";
+			jobs.push_back(job);
+		}
+	}
+}
+
+void HeinzJobScheduler::setCompletionCallback(
+		const CompletionCallback &callback) {
+	completionCallback = callback;
+}
+
+std::set<std::string> HeinzJobScheduler::readCheckpoint() const {
+	std::set<std::string> done;
+	std::ifstream checkpoint(CHECKPOINT_FILE);
+	std::string line;
+	while (checkpoint >> line) {
+		done.insert(line);
+	}
+	return done;
+}
+
+void HeinzJobScheduler::appendToCheckpoint(const std::string &fileBasename) {
+	std::lock_guard<std::mutex> lock(checkpointMutex);
+	if (checkpointDescriptor >= 0) {
+		writeAll(checkpointDescriptor, fileBasename + "\n");
+	}
+}
+
+std::string HeinzJobScheduler::buildCommand(const Job &job) const {
+	std::string command = solverCommand;
+	replaceAll(&command, "{input}", quoteForShell(job.inputFile));
+	replaceAll(&command, "{edges}", quoteForShell(edgesFile));
+	replaceAll(&command, "{weight}", quoteForShell(job.weight));
+	replaceAll(&command, "{sample}", quoteForShell(job.patientID));
+	return command;
+}
+
+HeinzJobScheduler::JobStatus HeinzJobScheduler::runJob(const Job &job) const {
+	ScopedTimer timer("heinz/job");
+	//Everything the child needs is prepared before fork() : only
+	//async-signal-safe calls are allowed there since we are multithreaded
+	std::string command = buildCommand(job);
+	std::string temporaryFile = job.outputFile + ".tmp";
+	long maxDescriptor = std::min(sysconf(_SC_OPEN_MAX), 65536L);
+
+	pid_t pid = fork();
+	if (pid < 0) {
+		return FAILED;
+	}
+	if (pid == 0) {
+		//Own process group, so that a timeout kills the whole pipeline
+		setpgid(0, 0);
+		int output = open(temporaryFile.c_str(),
+				O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		int devNull = open("/dev/null", O_WRONLY | O_CLOEXEC);
+		if (output < 0 || devNull < 0) {
+			_exit(127);
+		}
+		dup2(output, STDOUT_FILENO);
+		dup2(devNull, STDERR_FILENO);
+		//Streams opened by the other threads (module readers, exporters)
+		//are not O_CLOEXEC
+#ifdef SYS_close_range
+		if (syscall(SYS_close_range, 3, ~0U, 0) != 0)
+#endif
+		{
+			for (long descriptor = 3; descriptor < maxDescriptor;
+					++descriptor) {
+				close(descriptor);
+			}
+		}
+		execl("/bin/sh", "sh", "-c", command.c_str(), (char *) nullptr);
+		_exit(127);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	auto pollInterval = std::chrono::milliseconds(1);
+	int status = 0;
+	bool timedOut = false;
+	while (true) {
+		pid_t result = waitpid(pid, &status, WNOHANG);
+		if (result == pid || (result < 0 && errno != EINTR)) {
+			break;
+		}
+		if (timeoutSeconds > 0
+				&& std::chrono::steady_clock::now() - start
+						>= std::chrono::seconds(timeoutSeconds)) {
+			kill(-pid, SIGKILL);
+			kill(pid, SIGKILL);
+			waitpid(pid, &status, 0);
+			timedOut = true;
+			break;
+		}
+		std::this_thread::sleep_for(pollInterval);
+		pollInterval = std::min(pollInterval * 2,
+				std::chrono::milliseconds(50));
+	}
+
+	if (timedOut || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		std::remove(temporaryFile.c_str());
+		return timedOut ? TIMED_OUT : FAILED;
+	}
+	//Only complete modules ever appear under their final name
+	if (std::rename(temporaryFile.c_str(), job.outputFile.c_str()) != 0) {
+		return FAILED;
+	}
+	return SUCCEEDED;
+}
+
+HeinzJobScheduler::JobStatus HeinzJobScheduler::writeEmptyModule(
+		const Job &job) const {
+	std::string temporaryFile = job.outputFile + ".tmp";
+	int descriptor = open(temporaryFile.c_str(),
+			O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	bool written = descriptor >= 0 && writeAll(descriptor, "graph G {\n}\n");
+	if (descriptor >= 0 && close(descriptor) != 0) {
+		written = false;
+	}
+	if (!written
+			|| std::rename(temporaryFile.c_str(), job.outputFile.c_str())
+					!= 0) {
+		std::remove(temporaryFile.c_str());
+		return FAILED;
+	}
+	return SKIPPED;
+}
+
+void HeinzJobScheduler::runWorker(ProgressCounter *progress,
+		std::exception_ptr *exception, std::mutex *exceptionMutex) {
+	unsigned int i;
+	while ((i = nextJob++) < jobs.size()) {
+		Job &job = jobs[i];
+		if (job.status == SKIPPED) {
+			job.status = writeEmptyModule(job);
+		} else if (job.status == PENDING) {
+			try {
+				if (job.expandFromPacked) {
+					TCGADataNormalizer::expandPackedFile(packedGenes,
+							job.patientID, 1, -std::stod(job.weight),
+							job.inputFile);
+				}
+				job.status = runJob(job);
+			} catch (...) {
+				job.status = FAILED;
+			}
+			if (job.expandFromPacked) {
+				std::remove(job.inputFile.c_str());
+			}
+			if (job.status == SUCCEEDED) {
+				appendToCheckpoint(job.fileBasename);
+			}
+		}
+		if ((job.status == SUCCEEDED || job.status == CHECKPOINTED
+				|| job.status == SKIPPED) && completionCallback) {
+			try {
+				completionCallback(job.fileBasename);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(*exceptionMutex);
+				if (!*exception) {
+					*exception = std::current_exception();
+				}
+			}
+		}
+		progress->increment();
+	}
+}
+
+void HeinzJobScheduler::run() {
+	makeDirectory(HEINZ_RAW_OUTPUT_DIRECTORY);
+	std::set<WeightType> weights;
+	for (const auto &job : jobs) {
+		weights.insert(job.weight);
+	}
+	for (const auto &weight : weights) {
+		makeDirectory(HEINZ_RAW_OUTPUT_DIRECTORY + weight);
+	}
+
+	std::set<std::string> done;
+	if (resume) {
+		done = readCheckpoint();
+	}
+	checkpointDescriptor = open(CHECKPOINT_FILE.c_str(),
+			O_WRONLY | O_CREAT | O_CLOEXEC | (resume ? O_APPEND : O_TRUNC),
+			0644);
+	if (checkpointDescriptor < 0) {
+		throw std::runtime_error("Cannot open " + CHECKPOINT_FILE);
+	}
+	std::vector<std::string> skippedList =
+			PositiveComponents::readSkippedSamples(HEINZ_SKIPPED_SAMPLES_LIST);
+	std::set<std::string> skipped(skippedList.begin(), skippedList.end());
+
+	for (auto &job : jobs) {
+		if (done.find(job.fileBasename) != done.end()
+				&& fileSize(job.outputFile) >= 0) {
+			job.status = CHECKPOINTED;
+		} else if (skipped.find(job.patientID) != skipped.end()) {
+			job.status = SKIPPED;
+		} else {
+			job.inputSize = fileSize(job.inputFile);
+			if (job.inputSize < 0) {
+				//Packed export : the number of positive genes stands for the size
+				std::string packedFile = HEINZ_INPUT_DIRECTORY + job.patientID
+						+ HEINZ_PACKED_EXTENSION;
+				if (fileSize(packedFile) < 0) {
+					throw std::runtime_error(
+							"Heinz input file " + job.inputFile
+									+ " is missing.");
+				}
+				if (packedGenes.empty()) {
+					packedGenes = TCGADataNormalizer::readPackedGeneList();
+				}
+				job.expandFromPacked = true;
+				job.inputSize = 0;
+				for (unsigned char byte : readFileContent(packedFile)) {
+					job.inputSize += __builtin_popcount(byte);
+				}
+			}
+		}
+	}
+
+	//Checkpointed and skipped modules are only (re-)read, then the largest
+	//inputs go first so that the longest jobs do not end up alone at the tail
+	//of the run
+	std::stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) {
+		return a.inputSize > b.inputSize;
+	});
+	std::stable_partition(jobs.begin(), jobs.end(), [](const Job &job) {
+		return job.status == CHECKPOINTED || job.status == SKIPPED;
+	});
+
+	if (verbose) {
+		std::cout << "Running " << jobs.size() << " Heinz jobs on "
+				<< numberOfWorkers << " workers ("
+				<< std::count_if(jobs.begin(), jobs.end(), [](const Job &job) {
+					return job.status == CHECKPOINTED;
+				}) << " already done, "
+				<< std::count_if(jobs.begin(), jobs.end(), [](const Job &job) {
+					return job.status == SKIPPED;
+				}) << " skipped)... " << std::endl;
+	}
+
+	std::exception_ptr exception = nullptr;
+	std::mutex exceptionMutex;
+	ProgressCounter progress(jobs.size(), "jobs", verbose);
+	nextJob = 0;
+	std::vector<std::thread> workers;
+	for (unsigned int t = 0; t < numberOfWorkers; ++t) {
+		workers.emplace_back(&HeinzJobScheduler::runWorker, this, &progress,
+				&exception, &exceptionMutex);
+	}
+	for (auto &worker : workers) {
+		worker.join();
+	}
+	progress.finish();
+	close(checkpointDescriptor);
+	checkpointDescriptor = -1;
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+	if (verbose) {
+		printSummary();
+	}
+}
+
+unsigned int HeinzJobScheduler::getNumberOfFailedJobs() const {
+	return std::count_if(jobs.begin(), jobs.end(), [](const Job &job) {
+		return job.status == FAILED || job.status == TIMED_OUT;
+	});
+}
+
+void HeinzJobScheduler::printSummary(std::ostream &output) const {
+	unsigned int counts[6] = { 0, 0, 0, 0, 0, 0 };
+	for (const auto &job : jobs) {
+		++counts[job.status];
+	}
+	output << "Heinz jobs : " << counts[SUCCEEDED] << " solved, "
+			<< counts[CHECKPOINTED] << " resumed, " << counts[SKIPPED]
+			<< " skipped, " << counts[FAILED]
+			<< " failed, " << counts[TIMED_OUT] << " timed out" << std::endl;
+	for (const auto &job : jobs) {
+		if (job.status == FAILED) {
+			output << "\tFailed : " << job.fileBasename << std::endl;
+		} else if (job.status == TIMED_OUT) {
+			output << "\tTimed out : " << job.fileBasename << std::endl;
+		}
+	}
+}
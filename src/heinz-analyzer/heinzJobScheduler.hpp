@@ -0,0 +1,88 @@
+/*
+ * heinzJobScheduler.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_HEINZJOBSCHEDULER_HPP_
+#define SRC_HEINZ_ANALYZER_HEINZJOBSCHEDULER_HPP_
+
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <exception>
+#include "typedefs.hpp"
+#include "../utilities.hpp"
+
+// Runs the external solver on every (weight, sample) input file written by
+// TCGADataNormalizer::exportToFile, with a bounded pool of worker threads.
+// The command is a template run by /bin/sh : {input}, {edges}, {weight} and
+// {sample} are substituted as single-quoted words, and the standard output is
+// the module.
+// Samples listed in HEINZ_SKIPPED_SAMPLES_LIST are not solved : their module
+// is empty.
+class HeinzJobScheduler {
+public:
+	//Called from the worker threads with the basename of every module
+	//available in HEINZ_RAW_OUTPUT_DIRECTORY (solved now or before a resume)
+	typedef std::function<void(const std::string &)> CompletionCallback;
+
+	HeinzJobScheduler(const std::vector<WeightType> &_weights,
+			const std::vector<std::string> &_patientIDs,
+			const std::string &_solverCommand, const std::string &_edgesFile,
+			unsigned int _numberOfWorkers = 0, unsigned int _timeoutSeconds = 0,
+			bool _resume = true, bool _verbose = true);
+	void setCompletionCallback(const CompletionCallback &callback);
+	void run();
+	void printSummary(std::ostream &output = std::cout) const;
+	unsigned int getNumberOfFailedJobs() const;
+
+private:
+	enum JobStatus {
+		PENDING, CHECKPOINTED, SUCCEEDED, FAILED, TIMED_OUT, SKIPPED
+	};
+
+	struct Job {
+		std::string fileBasename;
+		WeightType weight;
+		std::string patientID;
+		std::string inputFile;
+		std::string outputFile;
+		long long inputSize = -1;
+		//The input is written from the packed export just before solving
+		bool expandFromPacked = false;
+		JobStatus status = PENDING;
+	};
+
+	std::vector<Job> jobs;
+	std::string solverCommand;
+	std::string edgesFile;
+	unsigned int numberOfWorkers;
+	unsigned int timeoutSeconds;
+	bool resume;
+	bool verbose;
+	CompletionCallback completionCallback;
+	std::vector<std::string> packedGenes;
+
+	std::atomic<unsigned int> nextJob;
+	std::mutex checkpointMutex;
+	//Descriptors are opened with O_CLOEXEC : the forked solvers must not
+	//inherit them
+	int checkpointDescriptor;
+
+	std::set<std::string> readCheckpoint() const;
+	void appendToCheckpoint(const std::string &fileBasename);
+	std::string buildCommand(const Job &job) const;
+	JobStatus runJob(const Job &job) const;
+	//Module of a sample left without positive genes by the prefilter
+	JobStatus writeEmptyModule(const Job &job) const;
+	void runWorker(ProgressCounter *progress, std::exception_ptr *exception,
+			std::mutex *exceptionMutex);
+};
+
+#endif /* SRC_HEINZ_ANALYZER_HEINZJOBSCHEDULER_HPP_ */
@@ -8,78 +8,97 @@
 #include "heinzModuleAnalyzer.hpp"
 
 #include <iostream>
-#include <regex>
+#include <cstring>
 #include <fstream>
 #include <algorithm>
+#include <unordered_map>
+#include "dotScanner.hpp"
 #include "../config.hpp"
 #include "../tcga-analyzer/TCGADataLoader.hpp"
 #include "../utilities.hpp"
+#include "../trace.hpp"
 
-HeinzModuleAnalyzer::HeinzModuleAnalyzer(const std::string &_fileBasename) :
+HeinzModuleAnalyzer::HeinzModuleAnalyzer(const std::string &_fileBasename,
+		const std::shared_ptr<const PPIGraph> &_graph) :
 		fileBasename(_fileBasename) {
-	std::vector<std::string> v = split(_fileBasename, { '_' });
-	heinzClass = HeinzClass(v[0], v[1], (v[2] == "Tumor"));
-	patientID = v[3];
-	module = std::make_shared<PPIGraph>();
+	parseFileBasename();
+	module = std::make_shared<PPIModule>(_graph);
 	buildModule();
 }
 
+HeinzModuleAnalyzer::HeinzModuleAnalyzer(const std::string &_fileBasename,
+		const std::shared_ptr<PPIModule> &_module) :
+		fileBasename(_fileBasename), module(_module) {
+	parseFileBasename();
+}
+
+void HeinzModuleAnalyzer::parseFileBasename() {
+	heinzClass = HeinzStatistics::parseClass(fileBasename);
+	patientID = split(fileBasename, { '_' })[3];
+}
+
 void HeinzModuleAnalyzer::buildModule() {
-	std::ifstream inputStream(
+	ScopedTimer timer("heinz/module");
+	std::string content = readFileContent(
 			HEINZ_RAW_OUTPUT_DIRECTORY + std::get<0>(heinzClass) + "/"
 					+ fileBasename + ".txt");
-	std::string line;
-	std::smatch match;
-	std::string regexNodePattern =
-			"([0-9]+) \\[label=\"([A-Z0-9\\-]+)\\\\n([-.0-9]+)\\\\n";
-	std::string regexEdgePattern = "([0-9]+) -- ([0-9]+)";
-	std::regex regexNode(regexNodePattern);
-	std::regex regexEdge(regexEdgePattern);
-	std::map<std::string, std::string> heinz2Hgnc;
+	Trace::count("modules", 1);
+	Trace::count("module bytes", content.size());
+	std::unordered_map<std::string, std::string> heinz2Hgnc;
+	HeinzDotScanner::Node node;
+	HeinzDotScanner::Edge edge;
 
 	bool readingNodes = false;
 	bool readingEdges = false;
 
-	std::map<std::string, std::string> heinzToHGNC;
+	const char *current = content.data();
+	const char *end = current + content.size();
+	while (current < end) {
+		const char *lineEnd = static_cast<const char *>(std::memchr(current,
+				'\n', end - current));
+		if (lineEnd == nullptr) {
+			lineEnd = end;
+		}
 
-	while (getline(inputStream, line)) {
-		if (!readingEdges && std::regex_search(line, match, regexNode)) {
+		if (!readingEdges
+				&& HeinzDotScanner::scanNode(current, lineEnd, &node)) {
 			readingNodes = true;
-			std::string heinzName = match[1];
-			std::string hgncName = match[2];
-			heinz2Hgnc[heinzName] = hgncName;
-			double value = std::stod(match[3]);
+			std::string hgncName = HeinzDotScanner::toString(node.name);
+			heinz2Hgnc[HeinzDotScanner::toString(node.heinzId)] = hgncName;
+			double value = std::stod(HeinzDotScanner::toString(node.value));
 			module->addNode(hgncName, value);
 		}
 
-		else if (readingNodes && std::regex_search(line, match, regexEdge)) {
+		else if (readingNodes
+				&& HeinzDotScanner::scanEdge(current, lineEnd, &edge)) {
 			readingEdges = true;
-			std::string heinzName1 = match[1];
-			std::string heinzName2 = match[2];
-			module->addEdge(heinz2Hgnc.at(heinzName1),
-					heinz2Hgnc.at(heinzName2));
+			module->addEdge(
+					heinz2Hgnc.at(HeinzDotScanner::toString(edge.heinzId1)),
+					heinz2Hgnc.at(HeinzDotScanner::toString(edge.heinzId2)));
 		}
+
+		current = lineEnd + 1;
 	}
 	//std::cout << "Done building module, size : " << module->size() << std::endl;
 }
 
-void HeinzModuleAnalyzer::analyze(ClassCount *classCount,
-		NegativeGeneCount *negativeGeneCount,
-		DegreeStatistics *degreeStatistics) {
-	++(*classCount)[heinzClass];
-	std::for_each(module->getNodesHandler().cbegin(),
+void HeinzModuleAnalyzer::analyze(HeinzStatistics *statistics,
+		bool recordMeanDegree) {
+	HeinzStatistics::ClassIDType classId = statistics->getClassId(heinzClass);
+	statistics->addModule(classId, *module);
+	//Count negative nodes in module
+	negatives = std::count_if(module->getNodesHandler().cbegin(),
 			module->getNodesHandler().cend(),
-			[&](const std::pair<PPIGraph::NodeNameType, PPIGraph::NodeValueType> &pair) {
-				if(pair.second<0) {
-					++(*negativeGeneCount)[heinzClass][pair.first];
-					++negatives;
-				}
+			[](const std::pair<PPIModule::NodeIDType, PPIModule::NodeValueType> &pair) {
+				return pair.second < 0;
 			});
-	//Count negative nodes in module
 	positives = module->size() - negatives;
 	//Count mean degree
-	meanDegree = (float) module->edgeCount() / module->size();
-	(*degreeStatistics)[heinzClass].push_back(meanDegree);
+	meanDegree = module->size() == 0 ?
+			0 : (float) module->edgeCount() / module->size();
+	if (recordMeanDegree) {
+		statistics->addMeanDegree(classId, meanDegree);
+	}
 }
 
 void HeinzModuleAnalyzer::printModule(){
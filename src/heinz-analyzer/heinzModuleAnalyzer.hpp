@@ -11,21 +11,39 @@
 #include <memory>
 #include <string>
 #include "graph.hpp"
+#include "ppiModule.hpp"
+#include "heinzStatistics.hpp"
 #include "typedefs.hpp"
 
 class HeinzModuleAnalyzer {
 public:
-	HeinzModuleAnalyzer(const std::string &_fileBasename);
+	//Module nodes are looked up in the (whole) graph given to Heinz
+	HeinzModuleAnalyzer(const std::string &_fileBasename,
+			const std::shared_ptr<const PPIGraph> &_graph);
+	//Module already in memory (native solver)
+	HeinzModuleAnalyzer(const std::string &_fileBasename,
+			const std::shared_ptr<PPIModule> &_module);
 	void printModule();
-	void analyze(ClassCount *classCount, NegativeGeneCount *negativeGeneCount, DegreeStatistics *degreeStatistics);
+	//Without recordMeanDegree, the caller collects getMeanDegree() itself
+	void analyze(HeinzStatistics *statistics, bool recordMeanDegree = true);
+	const HeinzClass &getHeinzClass() const {
+		return heinzClass;
+	}
+	float getMeanDegree() const {
+		return meanDegree;
+	}
+	const PPIModule &getModule() const {
+		return *module;
+	}
 private:
 	std::string fileBasename;
 	HeinzClass heinzClass;
 	std::string patientID;
-	std::shared_ptr<PPIGraph> module;
+	std::shared_ptr<PPIModule> module;
 	int positives = 0;
 	int negatives = 0;
 	float meanDegree = 0;
+	void parseFileBasename();
 	void buildModule();
 };
 
@@ -0,0 +1,92 @@
+/*
+ * heinzModuleSearch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "heinzModuleSearch.hpp"
+
+#include <cmath>
+#include <exception>
+#include "../utilities.hpp"
+#include "../trace.hpp"
+
+HeinzModuleSearch::HeinzModuleSearch(TCGAData *_ptrToData,
+		const std::shared_ptr<const PPIGraph> &_graph,
+		const std::vector<double> &_negativeWeights, double _positiveValue,
+		unsigned int _numberOfSeeds, bool _verbose) :
+		ptrToData(_ptrToData), graph(_graph), negativeWeights(
+				_negativeWeights), positiveValue(_positiveValue), numberOfSeeds(
+				_numberOfSeeds), verbose(_verbose), dataRows(_graph->size(), -1) {
+	ptrToData->buildDataMatrix();
+	const auto &geneList = ptrToData->getGeneListHandler();
+	for (unsigned int j = 0; j < geneList.size(); ++j) {
+		if (graph->hasNode(geneList[j].first)) {
+			dataRows[graph->getNodeId(geneList[j].first)] = j;
+		}
+	}
+}
+
+std::vector<WeightType> HeinzModuleSearch::toWeightStrings(
+		const std::vector<double> &negativeWeights) {
+	//Same names as the files written by exportToFile
+	std::vector<WeightType> weights;
+	for (double d : negativeWeights) {
+		weights.push_back(removeTrailingZeros(std::to_string(std::fabs(d))));
+	}
+	return weights;
+}
+
+std::vector<std::string> HeinzModuleSearch::getPatientIDs() const {
+	std::vector<std::string> patientIDs;
+	for (const auto &patient : ptrToData->getPatientsHandler()) {
+		patientIDs.push_back(patient.toString());
+	}
+	return patientIDs;
+}
+
+void HeinzModuleSearch::run(HeinzOutputAnalyzer *analyzer) {
+	ScopedTimer timer("heinz/module-search");
+	const Eigen::MatrixXd &dataMatrix = ptrToData->getDataMatrixHandler();
+	std::vector<WeightType> weights = toWeightStrings(negativeWeights);
+	std::vector<std::string> patientIDs = getPatientIDs();
+	unsigned int numberOfPatients = patientIDs.size();
+	unsigned int numberOfJobs = weights.size() * numberOfPatients;
+	unsigned int numberOfNodes = graph->size();
+	MWCSSolver solver(graph, numberOfSeeds);
+	std::exception_ptr exception = nullptr;
+	ProgressCounter progress(numberOfJobs, "modules", verbose);
+
+#pragma omp parallel
+	{
+		std::vector<double> scores(numberOfNodes);
+#pragma omp for schedule(dynamic)
+		for (unsigned int job = 0; job < numberOfJobs; ++job) {
+			unsigned int w = job / numberOfPatients;
+			unsigned int i = job % numberOfPatients;
+			//Genes missing from the data are scored as not expressed
+			double negativeValue = -std::fabs(negativeWeights[w]);
+			for (unsigned int u = 0; u < numberOfNodes; ++u) {
+				int row = dataRows[u];
+				scores[u] =
+						(row >= 0 && dataMatrix(row, i) > 0.5) ?
+								positiveValue : negativeValue;
+			}
+			try {
+				analyzer->analyzeModule(weights[w] + "_" + patientIDs[i],
+						solver.solve(scores));
+			} catch (...) {
+#pragma omp critical
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+			progress.increment();
+		}
+	}
+	progress.finish();
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
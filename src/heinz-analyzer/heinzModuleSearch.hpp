@@ -0,0 +1,44 @@
+/*
+ * heinzModuleSearch.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_HEINZMODULESEARCH_HPP_
+#define SRC_HEINZ_ANALYZER_HEINZMODULESEARCH_HPP_
+
+#include <vector>
+#include <memory>
+#include "graph.hpp"
+#include "mwcsSolver.hpp"
+#include "heinzOutputAnalyzer.hpp"
+#include "../tcga-analyzer/TCGAData.hpp"
+
+// In-process replacement for exportToFile + heinz : the node scores of
+// every (weight, sample) pair are built from the normalized data and solved
+// with MWCSSolver, in parallel over the samples.
+class HeinzModuleSearch {
+public:
+	HeinzModuleSearch(TCGAData *_ptrToData,
+			const std::shared_ptr<const PPIGraph> &_graph,
+			const std::vector<double> &_negativeWeights,
+			double _positiveValue = 1, unsigned int _numberOfSeeds = 5,
+			bool _verbose = true);
+	//Every module is handed to the analyzer as soon as it is solved
+	void run(HeinzOutputAnalyzer *analyzer);
+	static std::vector<WeightType> toWeightStrings(
+			const std::vector<double> &negativeWeights);
+	std::vector<std::string> getPatientIDs() const;
+
+private:
+	TCGAData *ptrToData;
+	std::shared_ptr<const PPIGraph> graph;
+	std::vector<double> negativeWeights;
+	double positiveValue;
+	unsigned int numberOfSeeds;
+	bool verbose;
+	//Row of the data matrix of each graph node, -1 if the gene is unknown
+	std::vector<int> dataRows;
+};
+
+#endif /* SRC_HEINZ_ANALYZER_HEINZMODULESEARCH_HPP_ */
@@ -7,44 +7,311 @@
 
 #include "heinzOutputAnalyzer.hpp"
 #include "heinzModuleAnalyzer.hpp"
+#include "directoryWatcher.hpp"
 #include "../config.hpp"
 #include "../utilities.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
 #include <fstream>
 #include <iostream>
+#include <exception>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <algorithm>
+#include <sys/stat.h>
 
-HeinzOutputAnalyzer::HeinzOutputAnalyzer(const std::string &weightsFilename,
-		const std::string &patientIDsFilename) {
-	std::string line;
-	std::ifstream weightsFile(HEINZ_DIRECTORY + weightsFilename);
-	while (weightsFile >> line) {
-		weights.push_back(line);
+namespace {
+
+//Heinz writes the closing brace of the DOT graph last
+bool isCompleteModuleFile(const std::string &filename) {
+	std::ifstream inputStream(filename, std::ios::binary | std::ios::ate);
+	if (!inputStream) {
+		return false;
 	}
-	std::ifstream samplesFile(HEINZ_DIRECTORY + patientIDsFilename);
-	while (samplesFile >> line) {
-		patientIDs.push_back(line);
+	std::streamoff size = inputStream.tellg();
+	std::streamoff tailSize = std::min<std::streamoff>(size, 64);
+	std::string tail(tailSize, '\0');
+	inputStream.seekg(size - tailSize);
+	inputStream.read(&tail[0], tailSize);
+	std::size_t last = tail.find_last_not_of(" \t\r\n");
+	return last != std::string::npos && tail[last] == '}';
+}
+
+//In inotify mode, everything pending is still scanned at this interval, as a
+//safety net against events that were never delivered
+const std::chrono::seconds FULL_RESCAN_INTERVAL(60);
+
+std::vector<std::string> readWords(const std::string &filename) {
+	std::vector<std::string> words;
+	std::ifstream inputStream(filename);
+	std::string word;
+	while (inputStream >> word) {
+		words.push_back(word);
 	}
+	return words;
+}
+
+}
+
+HeinzOutputAnalyzer::HeinzOutputAnalyzer(const std::string &weightsFilename,
+		const std::string &patientIDsFilename,
+		const std::string &graphNodesFilename,
+		const std::string &graphEdgesFilename, bool _verbose) :
+		HeinzOutputAnalyzer(readWords(HEINZ_DIRECTORY + weightsFilename),
+				readWords(HEINZ_DIRECTORY + patientIDsFilename),
+				//The graph is loaded once and shared by all modules
+				PPIGraph::buildFromFile(GRAPH_DATA_DIRECTORY + graphNodesFilename,
+						GRAPH_DATA_DIRECTORY + graphEdgesFilename), _verbose) {
+}
+
+HeinzOutputAnalyzer::HeinzOutputAnalyzer(
+		const std::vector<WeightType> &_weights,
+		const std::vector<std::string> &_patientIDs,
+		const std::shared_ptr<const PPIGraph> &_graph, bool _verbose) :
+		weights(_weights), patientIDs(_patientIDs), verbose(_verbose), graph(
+				_graph), statistics(
+				HeinzStatistics::buildClasses(_weights, _patientIDs), _graph) {
 }
 
 void HeinzOutputAnalyzer::analyze() {
-	for (unsigned int i = 0; i < weights.size(); ++i) {
-		for (unsigned int j = 0; j < patientIDs.size(); ++j) {
-			std::cout << patientIDs[j] << std::endl;
-			HeinzModuleAnalyzer hma(weights[i] + "_" + patientIDs[j]);
-			//hma.printModule();
-			hma.analyze(&classCount, &negativeGeneCount, &degreeStatistics);
-		}
-	}
-
-	for (const auto &kv : negativeGeneCount) {
-		unsigned int count = classCount[kv.first];
-		std::cout << kv.first << " (" << count << " samples)" << std::endl;
-		for (const auto &kv2 : kv.second) {
-			float p = (float) kv2.second / count;
-			if (p >= 0.05) {
-				std::cout << "\t" << kv2.first << " " << (100*p) << "%"
-						<< std::endl;
+	ScopedTimer timer("heinz/analysis");
+	MemoryStage memoryStage("heinz/analysis");
+	unsigned int numberOfPatients = patientIDs.size();
+	unsigned int numberOfJobs = weights.size() * numberOfPatients;
+	std::vector<HeinzStatistics::ClassIDType> jobClasses(numberOfJobs);
+	std::vector<float> jobMeanDegrees(numberOfJobs);
+	std::exception_ptr exception = nullptr;
+	ProgressCounter progress(numberOfJobs, "modules", verbose);
+
+	//Jobs are ordered by class, and a thread merges its statistics whenever it
+	//moves on to another class : its copy only ever holds the row of one
+	//class, and no thread waits for the others at class boundaries
+	std::vector<unsigned int> jobs(numberOfJobs);
+	for (unsigned int job = 0; job < numberOfJobs; ++job) {
+		jobs[job] = job;
+		jobClasses[job] = statistics.getClassId(
+				HeinzStatistics::parseClass(
+						weights[job / numberOfPatients] + "_"
+								+ patientIDs[job % numberOfPatients]));
+	}
+	std::stable_sort(jobs.begin(), jobs.end(),
+			[&jobClasses](unsigned int a, unsigned int b) {
+				return jobClasses[a] < jobClasses[b];
+			});
+	//Copy of the (empty) statistics which shares the class table
+	const HeinzStatistics emptyStatistics(statistics);
+
+#pragma omp parallel
+	{
+		HeinzStatistics threadStatistics(emptyStatistics);
+		bool used = false;
+		HeinzStatistics::ClassIDType threadClass = 0;
+		//Counts are integers : the merge order does not change the result
+		auto mergeThreadStatistics = [&]() {
+			if (used) {
+				std::lock_guard<std::mutex> lock(statisticsMutex);
+				statistics.merge(threadStatistics);
+				threadStatistics = emptyStatistics;
+				used = false;
+			}
+		};
+		//Jobs are handed out one chunk at a time to whichever thread is free
+#pragma omp for schedule(dynamic, 4) nowait
+		for (unsigned int i = 0; i < numberOfJobs; ++i) {
+			unsigned int job = jobs[i];
+			if (jobClasses[job] != threadClass) {
+				mergeThreadStatistics();
+				threadClass = jobClasses[job];
+			}
+			used = true;
+			try {
+				HeinzModuleAnalyzer hma(
+						weights[job / numberOfPatients] + "_"
+								+ patientIDs[job % numberOfPatients], graph);
+				//hma.printModule();
+				hma.analyze(&threadStatistics, false);
+				jobMeanDegrees[job] = hma.getMeanDegree();
+			} catch (...) {
+#pragma omp critical
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+			progress.increment();
+		}
+		mergeThreadStatistics();
+	}
+	progress.finish();
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+
+	//Degree statistics in job order
+	for (unsigned int job = 0; job < numberOfJobs; ++job) {
+		statistics.addMeanDegree(jobClasses[job], jobMeanDegrees[job]);
+	}
+
+	printReport();
+}
+
+void HeinzOutputAnalyzer::analyzeModule(const std::string &fileBasename) {
+	//Parsing is done outside of the lock, only the merge is serialized
+	HeinzModuleAnalyzer hma(fileBasename, graph);
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	hma.analyze(&statistics, true);
+}
+
+void HeinzOutputAnalyzer::analyzeModule(const std::string &fileBasename,
+		const std::shared_ptr<PPIModule> &module) {
+	HeinzModuleAnalyzer hma(fileBasename, module);
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	hma.analyze(&statistics, true);
+}
+
+void HeinzOutputAnalyzer::watch(unsigned int reportIntervalSeconds,
+		unsigned int idleTimeoutSeconds, bool forcePolling) {
+	//Module file -> basename, for the modules not analyzed yet
+	std::map<std::string, std::string> pending;
+	std::vector<std::string> directories;
+	makeDirectory(HEINZ_RAW_OUTPUT_DIRECTORY);
+	makeDirectory(HEINZ_OUTPUT_DIRECTORY);
+	for (const auto &weight : weights) {
+		std::string directory = HEINZ_RAW_OUTPUT_DIRECTORY + weight + "/";
+		makeDirectory(directory);
+		directories.push_back(directory);
+		for (const auto &patientID : patientIDs) {
+			std::string fileBasename = weight + "_" + patientID;
+			pending[directory + fileBasename + ".txt"] = fileBasename;
+		}
+	}
+
+	//Watch before the first scan, so that no file is missed in between
+	DirectoryWatcher watcher(directories, forcePolling);
+	if (verbose) {
+		std::cout << "Watching " << directories.size() << " directories ("
+				<< (watcher.isPolling() ? "polling" : "inotify") << ")... "
+				<< std::endl;
+	}
+	ProgressCounter progress(pending.size(), "modules", verbose);
+	//Files notified while still incomplete : no further event may come for
+	//them, so they are checked again at every wake-up
+	std::set<std::string> incomplete;
+	auto tryToAnalyze = [&](const std::string &filename) {
+		auto it = pending.find(filename);
+		if (it == pending.end()) {
+			return false;
+		}
+		if (!isCompleteModuleFile(filename)) {
+			incomplete.insert(filename);
+			return false;
+		}
+		incomplete.erase(filename);
+		try {
+			analyzeModule(it->second);
+		} catch (const std::exception &e) {
+			std::cerr << "Skipping " << filename << " : " << e.what()
+					<< std::endl;
+		}
+		pending.erase(it);
+		progress.increment();
+		return true;
+	};
+	auto scanPending = [&]() {
+		bool analyzed = false;
+		std::vector<std::string> filenames;
+		for (const auto &kv : pending) {
+			filenames.push_back(kv.first);
+		}
+		for (const auto &filename : filenames) {
+			analyzed = tryToAnalyze(filename) || analyzed;
+		}
+		return analyzed;
+	};
+
+	const std::string reportFilename = HEINZ_OUTPUT_DIRECTORY
+			+ "partial-report.txt";
+	auto lastActivity = std::chrono::steady_clock::now();
+	auto lastReport = lastActivity;
+	auto lastScan = lastActivity;
+	scanPending();
+	while (!pending.empty()) {
+		bool overflowed;
+		std::vector<std::string> filenames = watcher.waitForFiles(1000,
+				&overflowed);
+		bool analyzed = false;
+		if (watcher.isPolling() || overflowed
+				|| std::chrono::steady_clock::now() - lastScan
+						>= FULL_RESCAN_INTERVAL) {
+			analyzed = scanPending();
+			lastScan = std::chrono::steady_clock::now();
+		} else {
+			filenames.insert(filenames.end(), incomplete.begin(),
+					incomplete.end());
+			for (const auto &filename : filenames) {
+				analyzed = tryToAnalyze(filename) || analyzed;
 			}
 		}
+
+		auto now = std::chrono::steady_clock::now();
+		if (analyzed) {
+			lastActivity = now;
+		}
+		if (now - lastReport >= std::chrono::seconds(reportIntervalSeconds)) {
+			writePartialReport(reportFilename);
+			lastReport = now;
+		}
+		if (idleTimeoutSeconds > 0
+				&& now - lastActivity
+						>= std::chrono::seconds(idleTimeoutSeconds)) {
+			break;
+		}
+	}
+	progress.finish();
+
+	writePartialReport(reportFilename);
+	if (!pending.empty()) {
+		std::cout << pending.size() << " modules were not produced."
+				<< std::endl;
+	}
+	printReport();
+}
+
+void HeinzOutputAnalyzer::printReport(std::ostream &output) const {
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	statistics.printReport(output);
+}
+
+void HeinzOutputAnalyzer::writePartialReport(const std::string &filename) const {
+	//Written aside then renamed, so that readers never see half a report
+	std::string temporaryFilename = filename + ".tmp";
+	{
+		std::ofstream outputStream(temporaryFilename);
+		std::lock_guard<std::mutex> lock(statisticsMutex);
+		unsigned int analyzed = 0;
+		for (unsigned int c = 0; c < statistics.getNumberOfClasses(); ++c) {
+			analyzed += statistics.getClassCount(c);
+		}
+		outputStream << "Modules analyzed : " << analyzed << "/"
+				<< weights.size() * patientIDs.size() << std::endl;
+		statistics.printReport(outputStream);
+		outputStream.close();
+		if (!outputStream) {
+			throw std::runtime_error("Cannot write " + temporaryFilename);
+		}
+	}
+	if (std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+		throw std::runtime_error("Cannot rename " + temporaryFilename + " to "
+				+ filename);
 	}
 }
 
+void HeinzOutputAnalyzer::exportFrequencyMatrix(
+		const std::string &filename) const {
+	ScopedTimer timer("export/frequency-matrix");
+	std::lock_guard<std::mutex> lock(statisticsMutex);
+	statistics.exportFrequencyMatrix(filename);
+}
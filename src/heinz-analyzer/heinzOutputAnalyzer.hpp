@@ -8,18 +8,57 @@
 #ifndef SRC_HEINZ_ANALYZER_HEINZOUTPUTANALYZER_HPP_
 #define SRC_HEINZ_ANALYZER_HEINZOUTPUTANALYZER_HPP_
 
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include "graph.hpp"
+#include "ppiModule.hpp"
+#include "heinzStatistics.hpp"
 #include "typedefs.hpp"
 
 class HeinzOutputAnalyzer{
 public:
-	HeinzOutputAnalyzer(const std::string &weightsFilename, const std::string &patientIDsFilename);
+	HeinzOutputAnalyzer(const std::string &weightsFilename, const std::string &patientIDsFilename,
+			const std::string &graphNodesFilename, const std::string &graphEdgesFilename, bool _verbose = true);
+	//Modules are not read from files but given to analyzeModule()
+	HeinzOutputAnalyzer(const std::vector<WeightType> &_weights,
+			const std::vector<std::string> &_patientIDs,
+			const std::shared_ptr<const PPIGraph> &_graph, bool _verbose = true);
 	void analyze();
+	//Adds one module to the statistics as soon as it is available ;
+	//safe to call from several threads
+	void analyzeModule(const std::string &fileBasename);
+	void analyzeModule(const std::string &fileBasename,
+			const std::shared_ptr<PPIModule> &module);
+	//Analyzes the modules as they appear in HEINZ_RAW_OUTPUT_DIRECTORY, until
+	//all of them are done or nothing new came for idleTimeoutSeconds (0 to
+	//wait until every module is there, however long it takes). The partial
+	//report is rewritten every reportIntervalSeconds.
+	void watch(unsigned int reportIntervalSeconds = 30,
+			unsigned int idleTimeoutSeconds = 3600, bool forcePolling = false);
+	void printReport(std::ostream &output = std::cout) const;
+	//Report of the modules analyzed so far ; safe to call at any time
+	void writePartialReport(const std::string &filename) const;
+	void exportFrequencyMatrix(const std::string &filename) const;
+	const HeinzStatistics &getStatistics() const {
+		return statistics;
+	}
+	const std::vector<WeightType> &getWeights() const {
+		return weights;
+	}
+	const std::vector<std::string> &getPatientIDs() const {
+		return patientIDs;
+	}
+	const std::shared_ptr<const PPIGraph> &getGraph() const {
+		return graph;
+	}
 private:
 	std::vector<WeightType> weights;
 	std::vector<std::string> patientIDs;
-	ClassCount classCount;
-	NegativeGeneCount negativeGeneCount;
-	DegreeStatistics degreeStatistics;
+	bool verbose;
+	std::shared_ptr<const PPIGraph> graph;
+	HeinzStatistics statistics;
+	mutable std::mutex statisticsMutex;
 };
 
 
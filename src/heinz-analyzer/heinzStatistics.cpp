@@ -0,0 +1,171 @@
+/*
+ * heinzStatistics.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "heinzStatistics.hpp"
+
+#include <set>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include "../config.hpp"
+#include "../exportWriter.hpp"
+#include "../utilities.hpp"
+
+HeinzStatistics::HeinzStatistics(const std::vector<HeinzClass> &_classes,
+		const std::shared_ptr<const PPIGraph> &_graph) :
+		graph(_graph), classCount(_classes.size(), 0), negativeGeneCount(
+				_classes.size()), meanDegrees(_classes.size()) {
+	auto ids = std::make_shared<std::map<HeinzClass, ClassIDType>>();
+	for (ClassIDType c = 0; c < _classes.size(); ++c) {
+		(*ids)[_classes[c]] = c;
+	}
+	if (ids->size() != _classes.size()) {
+		throw std::invalid_argument("Heinz classes should be unique.");
+	}
+	classes = std::make_shared<const std::vector<HeinzClass>>(_classes);
+	classIds = ids;
+}
+
+HeinzClass HeinzStatistics::parseClass(const std::string &fileBasename) {
+	std::vector<std::string> v = split(fileBasename, { '_' });
+	if (v.size() < 4) {
+		throw std::invalid_argument(
+				"Invalid Heinz file basename '" + fileBasename + "'.");
+	}
+	return HeinzClass(v[0], v[1], (v[2] == "Tumor"));
+}
+
+std::vector<HeinzClass> HeinzStatistics::buildClasses(
+		const std::vector<WeightType> &weights,
+		const std::vector<std::string> &patientIDs) {
+	std::set<HeinzClass> classes;
+	for (const auto &weight : weights) {
+		for (const auto &patientID : patientIDs) {
+			classes.insert(parseClass(weight + "_" + patientID));
+		}
+	}
+	return std::vector<HeinzClass>(classes.begin(), classes.end());
+}
+
+HeinzStatistics::ClassIDType HeinzStatistics::getClassId(
+		const HeinzClass &heinzClass) const {
+	auto it = classIds->find(heinzClass);
+	if (it == classIds->end()) {
+		throw std::invalid_argument("Unknown Heinz class.");
+	}
+	return it->second;
+}
+
+std::vector<HeinzStatistics::CountType> &HeinzStatistics::getRow(
+		ClassIDType classId) {
+	std::vector<CountType> &row = negativeGeneCount[classId];
+	if (row.empty()) {
+		row.assign(graph->size(), 0);
+	}
+	return row;
+}
+
+void HeinzStatistics::addModule(ClassIDType classId, const PPIModule &module) {
+	++classCount[classId];
+	CountType *row = getRow(classId).data();
+	for (const auto &node : module.getNodesHandler()) {
+		if (node.second < 0) {
+			++row[node.first];
+		}
+	}
+}
+
+void HeinzStatistics::addMeanDegree(ClassIDType classId, float meanDegree) {
+	meanDegrees[classId].push_back(meanDegree);
+}
+
+void HeinzStatistics::merge(const HeinzStatistics &other) {
+	if (other.classes != classes && *other.classes != *classes) {
+		throw std::invalid_argument(
+				"Cannot merge Heinz statistics over different classes.");
+	}
+	unsigned int numberOfGenes = graph->size();
+	for (ClassIDType c = 0; c < classCount.size(); ++c) {
+		classCount[c] += other.classCount[c];
+		const std::vector<CountType> &otherRow = other.negativeGeneCount[c];
+		if (!otherRow.empty()) {
+			CountType *row = getRow(c).data();
+			const CountType *source = otherRow.data();
+			for (unsigned int g = 0; g < numberOfGenes; ++g) {
+				row[g] += source[g];
+			}
+		}
+		meanDegrees[c].insert(meanDegrees[c].end(),
+				other.meanDegrees[c].begin(), other.meanDegrees[c].end());
+	}
+}
+
+void HeinzStatistics::printReport(std::ostream &output,
+		float minimumFrequency) const {
+	for (ClassIDType c = 0; c < classCount.size(); ++c) {
+		const std::vector<CountType> &row = negativeGeneCount[c];
+		//Classes without any negative gene are not reported
+		if (std::find_if(row.begin(), row.end(), [](CountType count) {
+			return count > 0;
+		}) == row.end()) {
+			continue;
+		}
+		unsigned int count = classCount[c];
+		output << getClass(c) << " (" << count << " samples)" << std::endl;
+		std::vector<std::pair<std::string, float>> genes;
+		for (PPIGraph::NodeIDType g = 0; g < row.size(); ++g) {
+			float p = (float) row[g] / count;
+			if (row[g] > 0 && p >= minimumFrequency) {
+				genes.push_back( { graph->getNodeName(g), p });
+			}
+		}
+		std::sort(genes.begin(), genes.end());
+		for (const auto &gene : genes) {
+			output << "\t" << gene.first << " " << (100 * gene.second) << "%"
+					<< std::endl;
+		}
+	}
+}
+
+void HeinzStatistics::exportFrequencyMatrix(const std::string &filename) const {
+	std::uint32_t numberOfClasses = classCount.size();
+	std::uint32_t numberOfGenes = graph->size();
+	std::vector<float> frequencies((std::size_t) numberOfClasses * numberOfGenes,
+			0.0f);
+	for (ClassIDType c = 0; c < numberOfClasses; ++c) {
+		const std::vector<CountType> &row = negativeGeneCount[c];
+		if (!row.empty() && classCount[c] > 0) {
+			float *destination = frequencies.data()
+					+ (std::size_t) c * numberOfGenes;
+			float scale = 1.0f / classCount[c];
+			for (unsigned int g = 0; g < numberOfGenes; ++g) {
+				destination[g] = row[g] * scale;
+			}
+		}
+	}
+
+	ExportStream binaryOutput(filename + ".bin");
+	binaryOutput.write("HZFREQ01", 8);
+	binaryOutput.write(reinterpret_cast<const char *>(&numberOfClasses),
+			sizeof(numberOfClasses));
+	binaryOutput.write(reinterpret_cast<const char *>(&numberOfGenes),
+			sizeof(numberOfGenes));
+	binaryOutput.write(reinterpret_cast<const char *>(frequencies.data()),
+			frequencies.size() * sizeof(float));
+
+	ExportStream classesOutput(filename + "-classes.txt");
+	for (ClassIDType c = 0; c < numberOfClasses; ++c) {
+		const HeinzClass &heinzClass = getClass(c);
+		classesOutput << std::get<0>(heinzClass) << "\t"
+				<< std::get<1>(heinzClass) << "\t"
+				<< (std::get<2>(heinzClass) ? "Tumor" : "Control") << "\t"
+				<< classCount[c] << "\n";
+	}
+	ExportStream genesOutput(filename + "-genes.txt");
+	for (unsigned int g = 0; g < numberOfGenes; ++g) {
+		genesOutput << graph->getNodeName(g) << "\n";
+	}
+}
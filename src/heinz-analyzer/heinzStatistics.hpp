@@ -0,0 +1,83 @@
+/*
+ * heinzStatistics.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_HEINZSTATISTICS_HPP_
+#define SRC_HEINZ_ANALYZER_HEINZSTATISTICS_HPP_
+
+#include <map>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+#include <iostream>
+#include "graph.hpp"
+#include "ppiModule.hpp"
+#include "typedefs.hpp"
+
+// Module statistics per Heinz class. Classes are interned to dense IDs (in
+// HeinzClass order) and genes are the node IDs of the graph, so that the
+// counters are flat arrays : one row of gene counts per class.
+class HeinzStatistics {
+public:
+	typedef unsigned int ClassIDType;
+	typedef std::uint32_t CountType;
+
+	HeinzStatistics(const std::vector<HeinzClass> &_classes,
+			const std::shared_ptr<const PPIGraph> &_graph);
+	//fileBasename is weight_CANCER_Tumor|Control_patient
+	static HeinzClass parseClass(const std::string &fileBasename);
+	//Every class of the (weight, sample) modules, sorted
+	static std::vector<HeinzClass> buildClasses(
+			const std::vector<WeightType> &weights,
+			const std::vector<std::string> &patientIDs);
+
+	ClassIDType getClassId(const HeinzClass &heinzClass) const;
+	const HeinzClass &getClass(ClassIDType classId) const {
+		return (*classes)[classId];
+	}
+	unsigned int getNumberOfClasses() const {
+		return classCount.size();
+	}
+
+	//Counts the module and its negative genes
+	void addModule(ClassIDType classId, const PPIModule &module);
+	void addMeanDegree(ClassIDType classId, float meanDegree);
+	//other must have the same classes and graph
+	void merge(const HeinzStatistics &other);
+
+	CountType getClassCount(ClassIDType classId) const {
+		return classCount[classId];
+	}
+	CountType getNegativeGeneCount(ClassIDType classId,
+			PPIGraph::NodeIDType gene) const {
+		return negativeGeneCount[classId].empty() ?
+				0 : negativeGeneCount[classId][gene];
+	}
+	const std::vector<float> &getMeanDegrees(ClassIDType classId) const {
+		return meanDegrees[classId];
+	}
+
+	//Negative genes found in at least minimumFrequency of the class modules
+	void printReport(std::ostream &output = std::cout,
+			float minimumFrequency = 0.05) const;
+	//Frequency of every negative gene in every class, as a float32 matrix
+	//(classes x genes) in filename.bin, labels in filename-classes.txt and
+	//filename-genes.txt
+	void exportFrequencyMatrix(const std::string &filename) const;
+
+private:
+	std::shared_ptr<const std::vector<HeinzClass>> classes;
+	std::shared_ptr<const std::map<HeinzClass, ClassIDType>> classIds;
+	std::shared_ptr<const PPIGraph> graph;
+	std::vector<CountType> classCount;
+	//Rows are only allocated for the classes seen
+	std::vector<std::vector<CountType>> negativeGeneCount;
+	std::vector<std::vector<float>> meanDegrees;
+
+	std::vector<CountType> &getRow(ClassIDType classId);
+};
+
+#endif /* SRC_HEINZ_ANALYZER_HEINZSTATISTICS_HPP_ */
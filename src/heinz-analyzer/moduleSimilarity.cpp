@@ -0,0 +1,190 @@
+/*
+ * moduleSimilarity.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "moduleSimilarity.hpp"
+
+#include <fstream>
+#include <stdexcept>
+#include <exception>
+#include <utility>
+#include "heinzModuleAnalyzer.hpp"
+#include "../utilities.hpp"
+#include "../exportWriter.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
+
+ModuleSimilarity::ModuleSimilarity(
+		const std::shared_ptr<const PPIGraph> &_graph) :
+		graph(_graph) {
+	rowStart.push_back(0);
+}
+
+unsigned int ModuleSimilarity::addModule(const PPIModule &module) {
+	if (module.getGraph() != graph) {
+		throw std::invalid_argument(
+				"Modules of different graphs cannot be compared.");
+	}
+	const std::vector<WordType> &bits = module.getBits();
+	for (std::uint32_t w = 0; w < bits.size(); ++w) {
+		if (bits[w] != 0) {
+			wordIndices.push_back(w);
+			words.push_back(bits[w]);
+		}
+	}
+	rowStart.push_back(words.size());
+	moduleSizes.push_back(module.size());
+	return moduleSizes.size() - 1;
+}
+
+void ModuleSimilarity::addHeinzOutput(const WeightType &weight,
+		const std::vector<std::string> &patientIDs, bool verbose) {
+	ScopedTimer timer("heinz/module-similarity/read");
+	MemoryStage memoryStage("heinz/module-similarity/read");
+	std::vector<std::shared_ptr<PPIModule>> modules(patientIDs.size());
+	std::exception_ptr exception = nullptr;
+	ProgressCounter progress(patientIDs.size(), "modules", verbose);
+
+#pragma omp parallel for schedule(dynamic, 4)
+	for (unsigned int i = 0; i < patientIDs.size(); ++i) {
+		try {
+			HeinzModuleAnalyzer hma(weight + "_" + patientIDs[i], graph);
+			modules[i] = std::make_shared<PPIModule>(hma.getModule());
+		} catch (...) {
+#pragma omp critical
+			if (!exception) {
+				exception = std::current_exception();
+			}
+		}
+		progress.increment();
+	}
+	progress.finish();
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+	for (const auto &module : modules) {
+		addModule(*module);
+	}
+}
+
+void ModuleSimilarity::addModules(const ModuleSimilarity &other) {
+	if (other.graph != graph) {
+		throw std::invalid_argument(
+				"Modules of different graphs cannot be compared.");
+	}
+	std::size_t offset = words.size();
+	wordIndices.insert(wordIndices.end(), other.wordIndices.begin(),
+			other.wordIndices.end());
+	words.insert(words.end(), other.words.begin(), other.words.end());
+	for (unsigned int i = 1; i < other.rowStart.size(); ++i) {
+		rowStart.push_back(offset + other.rowStart[i]);
+	}
+	moduleSizes.insert(moduleSizes.end(), other.moduleSizes.begin(),
+			other.moduleSizes.end());
+}
+
+unsigned int ModuleSimilarity::intersectionSize(unsigned int module1,
+		unsigned int module2) const {
+	std::size_t a = rowStart[module1];
+	std::size_t aEnd = rowStart[module1 + 1];
+	std::size_t b = rowStart[module2];
+	std::size_t bEnd = rowStart[module2 + 1];
+	unsigned int count = 0;
+	//Both rows are sorted by word index
+	while (a < aEnd && b < bEnd) {
+		if (wordIndices[a] < wordIndices[b]) {
+			++a;
+		} else if (wordIndices[b] < wordIndices[a]) {
+			++b;
+		} else {
+			count += __builtin_popcountll(words[a] & words[b]);
+			++a;
+			++b;
+		}
+	}
+	return count;
+}
+
+template<typename MatrixType>
+void ModuleSimilarity::computeJaccard(MatrixType *matrix, bool distance) const {
+	ScopedTimer timer("heinz/module-similarity");
+	MemoryStage memoryStage("heinz/module-similarity");
+	typedef typename MatrixType::Scalar Scalar;
+	unsigned int numberOfModules = getNumberOfModules();
+	matrix->resize(numberOfModules, numberOfModules);
+	MemoryMonitor::track("similarityMatrix",
+			(unsigned long long) numberOfModules * numberOfModules
+					* sizeof(Scalar));
+
+	//Upper triangle of blocks : the rows of both blocks stay in cache while
+	//all their pairs are computed
+	unsigned int numberOfBlocks = (numberOfModules + BLOCK_SIZE - 1)
+			/ BLOCK_SIZE;
+	std::vector<std::pair<unsigned int, unsigned int>> blockPairs;
+	for (unsigned int b1 = 0; b1 < numberOfBlocks; ++b1) {
+		for (unsigned int b2 = b1; b2 < numberOfBlocks; ++b2) {
+			blockPairs.emplace_back(b1, b2);
+		}
+	}
+
+#pragma omp parallel for schedule(dynamic)
+	for (unsigned int p = 0; p < blockPairs.size(); ++p) {
+		unsigned int begin1 = blockPairs[p].first * BLOCK_SIZE;
+		unsigned int end1 = std::min(begin1 + BLOCK_SIZE, numberOfModules);
+		unsigned int begin2 = blockPairs[p].second * BLOCK_SIZE;
+		unsigned int end2 = std::min(begin2 + BLOCK_SIZE, numberOfModules);
+		for (unsigned int i = begin1; i < end1; ++i) {
+			for (unsigned int j = std::max(begin2, i); j < end2; ++j) {
+				unsigned int intersection = intersectionSize(i, j);
+				unsigned int unionSize = moduleSizes[i] + moduleSizes[j]
+						- intersection;
+				Scalar jaccard =
+						unionSize == 0 ?
+								Scalar(1) :
+								Scalar(intersection) / Scalar(unionSize);
+				if (distance) {
+					jaccard = Scalar(1) - jaccard;
+				}
+				(*matrix)(i, j) = jaccard;
+				(*matrix)(j, i) = jaccard;
+			}
+		}
+	}
+}
+
+Eigen::MatrixXf ModuleSimilarity::computeJaccardSimilarity() const {
+	Eigen::MatrixXf similarity;
+	computeJaccard(&similarity, false);
+	return similarity;
+}
+
+Eigen::MatrixXd ModuleSimilarity::computeJaccardDistance() const {
+	Eigen::MatrixXd distanceMatrix;
+	computeJaccard(&distanceMatrix, true);
+	return distanceMatrix;
+}
+
+void ModuleSimilarity::exportSimilarityMatrix(
+		const Eigen::MatrixXf &similarity,
+		const std::vector<std::string> &labels, const std::string &filename) {
+	std::uint32_t numberOfModules = similarity.rows();
+	if (labels.size() != numberOfModules) {
+		throw std::invalid_argument(
+				"One label per module is needed to export the similarity matrix.");
+	}
+	//Symmetric, so the column-major storage is also row-major
+	ExportStream binaryOutput(filename + ".bin");
+	binaryOutput.write("HZJACC01", 8);
+	binaryOutput.write(reinterpret_cast<const char *>(&numberOfModules),
+			sizeof(numberOfModules));
+	binaryOutput.write(reinterpret_cast<const char *>(similarity.data()),
+			(std::size_t) numberOfModules * numberOfModules * sizeof(float));
+
+	ExportStream labelsOutput(filename + "-modules.txt");
+	for (const auto &label : labels) {
+		labelsOutput << label << "\n";
+	}
+}
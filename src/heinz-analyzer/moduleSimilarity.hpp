@@ -0,0 +1,71 @@
+/*
+ * moduleSimilarity.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_MODULESIMILARITY_HPP_
+#define SRC_HEINZ_ANALYZER_MODULESIMILARITY_HPP_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <Eigen/Dense>
+#include "graph.hpp"
+#include "ppiModule.hpp"
+#include "typedefs.hpp"
+
+// All-pairs Jaccard similarity between modules of the same graph. Modules
+// are stored as their non-zero bitset words only (modules are small compared
+// to the graph), and pairs are computed by blocks of modules in parallel,
+// counting the common nodes with popcount on the matching words.
+class ModuleSimilarity {
+public:
+	typedef PPIModule::WordType WordType;
+
+	ModuleSimilarity(const std::shared_ptr<const PPIGraph> &_graph);
+
+	//Returns the index of the module in the matrices
+	unsigned int addModule(const PPIModule &module);
+	//Adds the weight_patientID modules of HEINZ_RAW_OUTPUT_DIRECTORY, read in
+	//parallel ; a missing module is empty
+	void addHeinzOutput(const WeightType &weight,
+			const std::vector<std::string> &patientIDs, bool verbose = true);
+	//Appends all the modules of other (same graph), in order
+	void addModules(const ModuleSimilarity &other);
+
+	unsigned int getNumberOfModules() const {
+		return moduleSizes.size();
+	}
+	unsigned int getModuleSize(unsigned int module) const {
+		return moduleSizes[module];
+	}
+	unsigned int intersectionSize(unsigned int module1,
+			unsigned int module2) const;
+
+	//Two empty modules are identical
+	Eigen::MatrixXf computeJaccardSimilarity() const;
+	//1 - Jaccard, to be given to the distance matrix clusterers
+	Eigen::MatrixXd computeJaccardDistance() const;
+	//float32 matrix (modules x modules) in filename.bin, with one label per
+	//module in filename-modules.txt
+	static void exportSimilarityMatrix(const Eigen::MatrixXf &similarity,
+			const std::vector<std::string> &labels,
+			const std::string &filename);
+
+	static const unsigned int BLOCK_SIZE = 64;
+
+private:
+	std::shared_ptr<const PPIGraph> graph;
+	//Compressed rows : module i owns the words in [rowStart[i], rowStart[i+1])
+	std::vector<std::size_t> rowStart;
+	std::vector<std::uint32_t> wordIndices;
+	std::vector<WordType> words;
+	std::vector<unsigned int> moduleSizes;
+
+	template<typename MatrixType>
+	void computeJaccard(MatrixType *matrix, bool distance) const;
+};
+
+#endif /* SRC_HEINZ_ANALYZER_MODULESIMILARITY_HPP_ */
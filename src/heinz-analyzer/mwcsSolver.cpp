@@ -0,0 +1,458 @@
+/*
+ * mwcsSolver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "mwcsSolver.hpp"
+
+#include <queue>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include "../trace.hpp"
+
+namespace {
+
+const double EPSILON = 1e-9;
+const unsigned int NO_NODE = std::numeric_limits<unsigned int>::max();
+
+unsigned int findRoot(std::vector<unsigned int> *parent, unsigned int u) {
+	while ((*parent)[u] != u) {
+		(*parent)[u] = (*parent)[(*parent)[u]];
+		u = (*parent)[u];
+	}
+	return u;
+}
+
+}
+
+//Buffers of size |V| are allocated once per solve and reset incrementally
+struct MWCSSolver::Workspace {
+	//Positive components
+	std::vector<int> componentOf;
+	std::vector<std::vector<NodeIDType>> componentMembers;
+	std::vector<double> componentPrize;
+	std::vector<char> componentInModule;
+	std::vector<unsigned int> componentReached;
+
+	//Current module
+	std::vector<char> inModule;
+	std::vector<NodeIDType> moduleNodes;
+
+	//Shortest paths and spanning trees
+	std::vector<double> distance;
+	std::vector<NodeIDType> predecessor;
+	std::vector<double> value;
+	std::vector<unsigned int> visited;
+	unsigned int stamp = 0;
+
+	//Cut nodes
+	std::vector<unsigned int> discovery;
+	std::vector<unsigned int> low;
+	std::vector<double> separatedScore;
+	std::vector<double> bestPartScore;
+	std::vector<NodeIDType> bestPartStart;
+
+	Workspace(unsigned int numberOfNodes) :
+			componentOf(numberOfNodes, -1), inModule(numberOfNodes, 0), distance(
+					numberOfNodes, std::numeric_limits<double>::infinity()), predecessor(
+					numberOfNodes, NO_NODE), value(numberOfNodes, 0.0), visited(
+					numberOfNodes, 0), discovery(numberOfNodes), low(
+					numberOfNodes), separatedScore(numberOfNodes), bestPartScore(
+					numberOfNodes), bestPartStart(numberOfNodes) {
+	}
+
+	void addNode(NodeIDType u) {
+		if (!inModule[u]) {
+			inModule[u] = 1;
+			moduleNodes.push_back(u);
+			if (componentOf[u] >= 0) {
+				componentInModule[componentOf[u]] = 1;
+			}
+		}
+	}
+
+	void addComponent(int c) {
+		for (NodeIDType u : componentMembers[c]) {
+			addNode(u);
+		}
+	}
+};
+
+MWCSSolver::MWCSSolver(const std::shared_ptr<const PPIGraph> &_graph,
+		unsigned int _numberOfSeeds) :
+		graph(_graph), numberOfSeeds(std::max(1u, _numberOfSeeds)) {
+}
+
+double MWCSSolver::computeScore(const std::vector<NodeIDType> &nodes,
+		const std::vector<double> &scores) {
+	double score = 0.0;
+	for (NodeIDType u : nodes) {
+		score += scores[u];
+	}
+	return score;
+}
+
+void MWCSSolver::setModule(const std::vector<NodeIDType> &nodes,
+		Workspace *workspace) const {
+	for (NodeIDType u : workspace->moduleNodes) {
+		workspace->inModule[u] = 0;
+	}
+	std::fill(workspace->componentInModule.begin(),
+			workspace->componentInModule.end(), 0);
+	workspace->moduleNodes.clear();
+	for (NodeIDType u : nodes) {
+		workspace->addNode(u);
+	}
+}
+
+void MWCSSolver::growFromSeed(unsigned int seed,
+		const std::vector<double> &scores, Workspace *workspace) const {
+	Workspace &ws = *workspace;
+	setModule( { }, workspace);
+	ws.addComponent(seed);
+
+	typedef std::pair<double, NodeIDType> QueueItem;
+	std::vector<NodeIDType> touched;
+	std::vector<NodeIDType> path;
+	while (true) {
+		//No component can pay for a path longer than the largest prize left
+		double maximumPrize = 0.0;
+		for (unsigned int c = 0; c < ws.componentPrize.size(); ++c) {
+			if (!ws.componentInModule[c]) {
+				maximumPrize = std::max(maximumPrize, ws.componentPrize[c]);
+			}
+		}
+		if (maximumPrize <= 0.0) {
+			break;
+		}
+
+		//Multi-source Dijkstra from the module, entering a node costs -score
+		++ws.stamp;
+		std::priority_queue<QueueItem, std::vector<QueueItem>,
+				std::greater<QueueItem>> queue;
+		for (NodeIDType u : ws.moduleNodes) {
+			ws.distance[u] = 0.0;
+			touched.push_back(u);
+			queue.push( { 0.0, u });
+		}
+		std::vector<std::pair<double, NodeIDType>> candidates;
+		while (!queue.empty()) {
+			double d = queue.top().first;
+			NodeIDType u = queue.top().second;
+			queue.pop();
+			if (d > ws.distance[u]) {
+				continue;
+			}
+			if (d >= maximumPrize) {
+				break;
+			}
+			int c = ws.componentOf[u];
+			if (!ws.inModule[u] && c >= 0 && ws.componentReached[c] != ws.stamp) {
+				ws.componentReached[c] = ws.stamp;
+				double gain = ws.componentPrize[c] - d;
+				if (gain > EPSILON) {
+					candidates.push_back( { gain, u });
+				}
+			}
+			for (const NodeIDType *it = graph->neighborsBegin(u);
+					it != graph->neighborsEnd(u); ++it) {
+				NodeIDType v = *it;
+				if (ws.inModule[v]) {
+					continue;
+				}
+				double newDistance = d + std::max(0.0, -scores[v]);
+				if (newDistance < ws.distance[v]) {
+					if (ws.distance[v] == std::numeric_limits<double>::infinity()) {
+						touched.push_back(v);
+					}
+					ws.distance[v] = newDistance;
+					ws.predecessor[v] = u;
+					queue.push( { newDistance, v });
+				}
+			}
+		}
+
+		//Connect the components by decreasing gain, along their path and with
+		//every positive component the path goes through. A path can only get
+		//cheaper as the module grows, so every gain stays positive.
+		std::stable_sort(candidates.begin(), candidates.end(),
+				[](const std::pair<double, NodeIDType> &a,
+						const std::pair<double, NodeIDType> &b) {
+					return a.first > b.first;
+				});
+		for (const auto &candidate : candidates) {
+			path.clear();
+			for (NodeIDType v = candidate.second; !ws.inModule[v];
+					v = ws.predecessor[v]) {
+				path.push_back(v);
+			}
+			for (NodeIDType v : path) {
+				if (ws.componentOf[v] >= 0) {
+					ws.addComponent(ws.componentOf[v]);
+				} else {
+					ws.addNode(v);
+				}
+			}
+		}
+
+		for (NodeIDType u : touched) {
+			ws.distance[u] = std::numeric_limits<double>::infinity();
+		}
+		touched.clear();
+
+		if (candidates.empty()) {
+			break;
+		}
+	}
+}
+
+void MWCSSolver::pruneOnSpanningTree(const std::vector<double> &scores,
+		Workspace *workspace) const {
+	Workspace &ws = *workspace;
+	if (ws.moduleNodes.empty()) {
+		return;
+	}
+
+	//BFS tree rooted at the best node
+	NodeIDType root = *std::max_element(ws.moduleNodes.begin(),
+			ws.moduleNodes.end(), [&](NodeIDType a, NodeIDType b) {
+				return scores[a] < scores[b];
+			});
+	++ws.stamp;
+	std::vector<NodeIDType> order = { root };
+	ws.visited[root] = ws.stamp;
+	ws.predecessor[root] = NO_NODE;
+	for (unsigned int i = 0; i < order.size(); ++i) {
+		NodeIDType u = order[i];
+		for (const NodeIDType *it = graph->neighborsBegin(u);
+				it != graph->neighborsEnd(u); ++it) {
+			NodeIDType v = *it;
+			if (ws.inModule[v] && ws.visited[v] != ws.stamp) {
+				ws.visited[v] = ws.stamp;
+				ws.predecessor[v] = u;
+				order.push_back(v);
+			}
+		}
+	}
+
+	//Best subtree hanging from each node, children before parents
+	for (NodeIDType u : order) {
+		ws.value[u] = scores[u];
+	}
+	for (unsigned int i = order.size() - 1; i > 0; --i) {
+		NodeIDType u = order[i];
+		if (ws.value[u] > 0) {
+			ws.value[ws.predecessor[u]] += ws.value[u];
+		}
+	}
+	NodeIDType top = *std::max_element(order.begin(), order.end(),
+			[&](NodeIDType a, NodeIDType b) {
+				return ws.value[a] < ws.value[b];
+			});
+
+	std::vector<NodeIDType> kept = { top };
+	for (unsigned int i = 0; i < kept.size(); ++i) {
+		NodeIDType u = kept[i];
+		for (const NodeIDType *it = graph->neighborsBegin(u);
+				it != graph->neighborsEnd(u); ++it) {
+			NodeIDType v = *it;
+			if (ws.inModule[v] && ws.visited[v] == ws.stamp
+					&& ws.predecessor[v] == u && v != u && ws.value[v] > 0) {
+				//A node is only kept once, even with parallel edges
+				ws.visited[v] = 0;
+				kept.push_back(v);
+			}
+		}
+	}
+	setModule(kept, workspace);
+}
+
+bool MWCSSolver::removeNegativeCutNode(const std::vector<double> &scores,
+		Workspace *workspace) const {
+	Workspace &ws = *workspace;
+	if (ws.moduleNodes.empty()) {
+		return false;
+	}
+
+	//Iterative Tarjan DFS : for every node, the parts of the module cut off
+	//by its removal are its separated DFS subtrees and the rest
+	++ws.stamp;
+	unsigned int counter = 0;
+	NodeIDType root = ws.moduleNodes[0];
+	std::vector<std::pair<NodeIDType, const NodeIDType *>> stack;
+	auto visit = [&](NodeIDType u, NodeIDType parent) {
+		ws.visited[u] = ws.stamp;
+		ws.discovery[u] = ws.low[u] = counter++;
+		ws.predecessor[u] = parent;
+		ws.value[u] = scores[u];
+		ws.separatedScore[u] = 0.0;
+		ws.bestPartScore[u] = -std::numeric_limits<double>::infinity();
+		ws.bestPartStart[u] = NO_NODE;
+		stack.push_back( { u, graph->neighborsBegin(u) });
+	};
+	visit(root, NO_NODE);
+	while (!stack.empty()) {
+		NodeIDType u = stack.back().first;
+		if (stack.back().second != graph->neighborsEnd(u)) {
+			NodeIDType v = *stack.back().second++;
+			if (!ws.inModule[v] || v == u) {
+				continue;
+			}
+			if (ws.visited[v] != ws.stamp) {
+				visit(v, u);
+			} else if (v != ws.predecessor[u]) {
+				ws.low[u] = std::min(ws.low[u], ws.discovery[v]);
+			}
+		} else {
+			stack.pop_back();
+			NodeIDType p = ws.predecessor[u];
+			if (p != NO_NODE) {
+				ws.low[p] = std::min(ws.low[p], ws.low[u]);
+				ws.value[p] += ws.value[u];
+				if (ws.low[u] >= ws.discovery[p]) {
+					ws.separatedScore[p] += ws.value[u];
+					if (ws.value[u] > ws.bestPartScore[p]) {
+						ws.bestPartScore[p] = ws.value[u];
+						ws.bestPartStart[p] = u;
+					}
+				}
+			}
+		}
+	}
+
+	double currentScore = ws.value[root];
+	double bestScore = currentScore + EPSILON;
+	NodeIDType bestRemoved = NO_NODE;
+	NodeIDType bestStart = NO_NODE;
+	for (NodeIDType u : ws.moduleNodes) {
+		if (scores[u] >= 0) {
+			continue;
+		}
+		if (ws.bestPartScore[u] > bestScore) {
+			bestScore = ws.bestPartScore[u];
+			bestRemoved = u;
+			bestStart = ws.bestPartStart[u];
+		}
+		if (u != root) {
+			double rest = currentScore - scores[u] - ws.separatedScore[u];
+			if (rest > bestScore) {
+				bestScore = rest;
+				bestRemoved = u;
+				bestStart = ws.predecessor[u];
+			}
+		}
+	}
+	if (bestRemoved == NO_NODE) {
+		return false;
+	}
+
+	//Keep the best connected part of the module without this node
+	++ws.stamp;
+	ws.visited[bestRemoved] = ws.stamp;
+	ws.visited[bestStart] = ws.stamp;
+	std::vector<NodeIDType> part = { bestStart };
+	for (unsigned int i = 0; i < part.size(); ++i) {
+		NodeIDType u = part[i];
+		for (const NodeIDType *it = graph->neighborsBegin(u);
+				it != graph->neighborsEnd(u); ++it) {
+			NodeIDType v = *it;
+			if (ws.inModule[v] && ws.visited[v] != ws.stamp) {
+				ws.visited[v] = ws.stamp;
+				part.push_back(v);
+			}
+		}
+	}
+	setModule(part, workspace);
+	return true;
+}
+
+std::shared_ptr<PPIModule> MWCSSolver::solve(
+		const std::vector<double> &scores) const {
+	ScopedTimer timer("heinz/solver");
+	unsigned int N = graph->size();
+	if (scores.size() != N) {
+		throw std::invalid_argument(
+				"MWCS solver : there should be one score per graph node.");
+	}
+	Workspace ws(N);
+
+	//Connected components of positive nodes
+	std::vector<unsigned int> parent(N);
+	std::iota(parent.begin(), parent.end(), 0);
+	for (NodeIDType u = 0; u < N; ++u) {
+		if (scores[u] > 0) {
+			for (const NodeIDType *it = graph->neighborsBegin(u);
+					it != graph->neighborsEnd(u); ++it) {
+				if (scores[*it] > 0) {
+					parent[findRoot(&parent, u)] = findRoot(&parent, *it);
+				}
+			}
+		}
+	}
+	std::vector<int> componentOfRoot(N, -1);
+	for (NodeIDType u = 0; u < N; ++u) {
+		if (scores[u] > 0) {
+			unsigned int root = findRoot(&parent, u);
+			if (componentOfRoot[root] < 0) {
+				componentOfRoot[root] = ws.componentMembers.size();
+				ws.componentMembers.emplace_back();
+				ws.componentPrize.push_back(0.0);
+			}
+			int c = componentOfRoot[root];
+			ws.componentOf[u] = c;
+			ws.componentMembers[c].push_back(u);
+			ws.componentPrize[c] += scores[u];
+		}
+	}
+	unsigned int C = ws.componentMembers.size();
+	ws.componentInModule.assign(C, 0);
+	ws.componentReached.assign(C, 0);
+
+	std::shared_ptr<PPIModule> module = std::make_shared<PPIModule>(graph);
+	if (C == 0) {
+		return module;
+	}
+
+	//Grow from the largest prizes and keep the best module
+	std::vector<unsigned int> seeds(C);
+	std::iota(seeds.begin(), seeds.end(), 0);
+	std::stable_sort(seeds.begin(), seeds.end(),
+			[&](unsigned int a, unsigned int b) {
+				return ws.componentPrize[a] > ws.componentPrize[b];
+			});
+	seeds.resize(std::min(C, numberOfSeeds));
+
+	std::vector<NodeIDType> bestNodes;
+	double bestScore = -std::numeric_limits<double>::infinity();
+	for (unsigned int seed : seeds) {
+		growFromSeed(seed, scores, &ws);
+		pruneOnSpanningTree(scores, &ws);
+		while (removeNegativeCutNode(scores, &ws)) {
+		}
+		pruneOnSpanningTree(scores, &ws);
+		double score = computeScore(ws.moduleNodes, scores);
+		if (score > bestScore + EPSILON) {
+			bestScore = score;
+			bestNodes = ws.moduleNodes;
+		}
+	}
+
+	//Same content as a Heinz output : nodes and induced edges
+	std::sort(bestNodes.begin(), bestNodes.end());
+	setModule(bestNodes, &ws);
+	for (NodeIDType u : bestNodes) {
+		module->addNode(u, scores[u]);
+	}
+	for (NodeIDType u : bestNodes) {
+		for (const NodeIDType *it = graph->neighborsBegin(u);
+				it != graph->neighborsEnd(u); ++it) {
+			if (*it > u && ws.inModule[*it]) {
+				module->addEdge(u, *it);
+			}
+		}
+	}
+	return module;
+}
@@ -0,0 +1,49 @@
+/*
+ * mwcsSolver.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_MWCSSOLVER_HPP_
+#define SRC_HEINZ_ANALYZER_MWCSSOLVER_HPP_
+
+#include <vector>
+#include <memory>
+#include "graph.hpp"
+#include "ppiModule.hpp"
+
+// Heuristic for the maximum-weight connected subgraph problem solved by Heinz.
+// Positive nodes are merged into components, which are joined greedily
+// along cheapest paths (prize-collecting Steiner tree style) starting from
+// the best components ; the result is then pruned on a spanning tree and
+// improved by removing negative cut nodes.
+// solve() is const and may be called from several threads.
+class MWCSSolver {
+public:
+	typedef PPIGraph::NodeIDType NodeIDType;
+
+	MWCSSolver(const std::shared_ptr<const PPIGraph> &_graph,
+			unsigned int _numberOfSeeds = 5);
+
+	//scores[id] is the weight of graph node id
+	std::shared_ptr<PPIModule> solve(const std::vector<double> &scores) const;
+	static double computeScore(const std::vector<NodeIDType> &nodes,
+			const std::vector<double> &scores);
+
+private:
+	struct Workspace;
+
+	std::shared_ptr<const PPIGraph> graph;
+	unsigned int numberOfSeeds;
+
+	void growFromSeed(unsigned int seed, const std::vector<double> &scores,
+			Workspace *workspace) const;
+	void pruneOnSpanningTree(const std::vector<double> &scores,
+			Workspace *workspace) const;
+	bool removeNegativeCutNode(const std::vector<double> &scores,
+			Workspace *workspace) const;
+	void setModule(const std::vector<NodeIDType> &nodes,
+			Workspace *workspace) const;
+};
+
+#endif /* SRC_HEINZ_ANALYZER_MWCSSOLVER_HPP_ */
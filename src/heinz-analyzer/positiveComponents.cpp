@@ -0,0 +1,282 @@
+/*
+ * positiveComponents.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "positiveComponents.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include "../utilities.hpp"
+#include "../trace.hpp"
+
+namespace {
+
+unsigned int findRoot(std::vector<unsigned int> *parent, unsigned int k) {
+	while ((*parent)[k] != k) {
+		(*parent)[k] = (*parent)[(*parent)[k]];
+		k = (*parent)[k];
+	}
+	return k;
+}
+
+void unite(std::vector<unsigned int> *parent, unsigned int k1,
+		unsigned int k2) {
+	k1 = findRoot(parent, k1);
+	k2 = findRoot(parent, k2);
+	if (k1 < k2) {
+		(*parent)[k2] = k1;
+	} else if (k2 < k1) {
+		(*parent)[k1] = k2;
+	}
+}
+
+double median(std::vector<unsigned int> values) {
+	if (values.empty()) {
+		return 0;
+	}
+	std::size_t middle = values.size() / 2;
+	std::nth_element(values.begin(), values.begin() + middle, values.end());
+	if (values.size() % 2 == 1) {
+		return values[middle];
+	}
+	return (values[middle]
+			+ *std::max_element(values.begin(), values.begin() + middle))
+			/ 2.0;
+}
+
+}
+
+PositiveComponents::PositiveComponents(TCGAData *_ptrToData,
+		const std::shared_ptr<const PPIGraph> &_graph, bool _verbose) :
+		ptrToData(_ptrToData), graph(_graph), verbose(_verbose), dataRows(
+				_graph->size(), -1) {
+	ptrToData->buildDataMatrix();
+	const auto &geneList = ptrToData->getGeneListHandler();
+	for (unsigned int j = 0; j < geneList.size(); ++j) {
+		if (graph->hasNode(geneList[j].first)) {
+			dataRows[graph->getNodeId(geneList[j].first)] = j;
+		}
+	}
+}
+
+void PositiveComponents::compute() {
+	ScopedTimer timer("heinz/positive-components");
+	const Eigen::MatrixXd &dataMatrix = ptrToData->getDataMatrixHandler();
+	unsigned int numberOfSamples = dataMatrix.cols();
+	unsigned int numberOfGenes = dataMatrix.rows();
+	std::vector<int> graphNodes(numberOfGenes, -1);
+	for (unsigned int u = 0; u < graph->size(); ++u) {
+		if (dataRows[u] >= 0) {
+			graphNodes[dataRows[u]] = u;
+		}
+	}
+	positiveGenes.assign(numberOfSamples, { });
+	componentSizes.assign(numberOfSamples, { });
+	ProgressCounter progress(numberOfSamples, "samples", verbose);
+
+#pragma omp parallel
+	{
+		//Union-find index of every positive gene of the sample, -1 otherwise
+		std::vector<int> localIndex(numberOfGenes, -1);
+		std::vector<unsigned int> rows;
+		std::vector<unsigned int> parent;
+		std::vector<unsigned int> sizes;
+#pragma omp for schedule(dynamic)
+		for (unsigned int i = 0; i < numberOfSamples; ++i) {
+			rows.clear();
+			parent.clear();
+			for (unsigned int j = 0; j < numberOfGenes; ++j) {
+				if (dataMatrix(j, i) > 0.5) {
+					localIndex[j] = rows.size();
+					parent.push_back(rows.size());
+					rows.push_back(j);
+				}
+			}
+			for (unsigned int k = 0; k < rows.size(); ++k) {
+				int u = graphNodes[rows[k]];
+				if (u < 0) {
+					continue;
+				}
+				for (auto it = graph->neighborsBegin(u);
+						it != graph->neighborsEnd(u); ++it) {
+					int row = dataRows[*it];
+					if (row >= 0 && localIndex[row] >= 0) {
+						unite(&parent, k, localIndex[row]);
+					}
+				}
+			}
+
+			sizes.assign(rows.size(), 0);
+			for (unsigned int k = 0; k < rows.size(); ++k) {
+				++sizes[findRoot(&parent, k)];
+			}
+			for (unsigned int k = 0; k < rows.size(); ++k) {
+				positiveGenes[i].emplace_back(rows[k],
+						sizes[findRoot(&parent, k)]);
+				if (parent[k] == k) {
+					componentSizes[i].push_back(sizes[k]);
+				}
+				localIndex[rows[k]] = -1;
+			}
+			std::sort(componentSizes[i].begin(), componentSizes[i].end(),
+					std::greater<unsigned int>());
+			progress.increment();
+		}
+	}
+	progress.finish();
+}
+
+void PositiveComponents::printReport(std::ostream &output) const {
+	unsigned int numberOfSamples = componentSizes.size();
+	if (numberOfSamples == 0) {
+		output << "No positive components (compute() was not called)."
+				<< std::endl;
+		return;
+	}
+
+	//Size classes 1, 2, 3-4, 5-8...
+	std::vector<unsigned long> componentsPerBin;
+	std::vector<unsigned long> genesPerBin;
+	unsigned long totalGenes = 0;
+	std::vector<unsigned int> largest(numberOfSamples);
+	std::vector<unsigned int> positives(numberOfSamples);
+	std::vector<unsigned int> components(numberOfSamples);
+	for (unsigned int i = 0; i < numberOfSamples; ++i) {
+		for (unsigned int size : componentSizes[i]) {
+			unsigned int bin = 0;
+			while ((1u << bin) < size) {
+				++bin;
+			}
+			if (bin >= componentsPerBin.size()) {
+				componentsPerBin.resize(bin + 1, 0);
+				genesPerBin.resize(bin + 1, 0);
+			}
+			++componentsPerBin[bin];
+			genesPerBin[bin] += size;
+			totalGenes += size;
+		}
+		largest[i] = componentSizes[i].empty() ? 0 : componentSizes[i][0];
+		positives[i] = positiveGenes[i].size();
+		components[i] = componentSizes[i].size();
+	}
+
+	auto mean = [](const std::vector<unsigned int> &values,
+			const std::vector<int> &indices) {
+		double sum = 0;
+		for (int i : indices) {
+			sum += values[i];
+		}
+		return indices.empty() ? 0.0 : sum / indices.size();
+	};
+	std::vector<int> allSamples(numberOfSamples);
+	for (unsigned int i = 0; i < numberOfSamples; ++i) {
+		allSamples[i] = i;
+	}
+
+	std::streamsize precision = output.precision();
+	output << std::fixed << std::setprecision(2);
+	output << "Positive components of " << numberOfSamples << " samples :"
+			<< std::endl;
+	output << "* Positive genes per sample : " << mean(positives, allSamples)
+			<< std::endl;
+	output << "* Components per sample : " << mean(components, allSamples)
+			<< std::endl;
+	output << "* Largest component : mean " << mean(largest, allSamples)
+			<< ", median " << median(largest) << ", min "
+			<< *std::min_element(largest.begin(), largest.end()) << ", max "
+			<< *std::max_element(largest.begin(), largest.end()) << std::endl;
+
+	output << std::endl << "Size\tComponents\tGenes (%)" << std::endl;
+	for (unsigned int bin = 0; bin < componentsPerBin.size(); ++bin) {
+		unsigned int low = bin == 0 ? 1 : (1u << (bin - 1)) + 1;
+		unsigned int high = 1u << bin;
+		output << low;
+		if (high != low) {
+			output << "-" << high;
+		}
+		output << "\t" << componentsPerBin[bin] << "\t"
+				<< (totalGenes == 0 ?
+						0.0 : 100.0 * genesPerBin[bin] / totalGenes)
+				<< std::endl;
+	}
+
+	output << std::endl
+			<< "Class\tSamples\tPositive genes\tComponents\tLargest component"
+			<< std::endl;
+	for (const auto &kv : ptrToData->getClassMapHandler()) {
+		output << kv.first << "\t" << kv.second.size() << "\t"
+				<< mean(positives, kv.second) << "\t"
+				<< mean(components, kv.second) << "\t"
+				<< mean(largest, kv.second) << std::endl;
+	}
+	output << std::defaultfloat << std::setprecision(precision);
+}
+
+unsigned long PositiveComponents::shrink(unsigned int minimumSize) {
+	Eigen::MatrixXd &dataMatrix = ptrToData->getDataMatrixHandler();
+	RNASeqData &data = ptrToData->getDataHandler();
+	unsigned int numberOfSamples = positiveGenes.size();
+	unsigned long demoted = 0;
+
+#pragma omp parallel for schedule(dynamic) reduction(+:demoted)
+	for (unsigned int i = 0; i < numberOfSamples; ++i) {
+		auto &genes = positiveGenes[i];
+		for (const auto &gene : genes) {
+			if (gene.second < minimumSize) {
+				//The matrix and the raw data are kept in sync
+				dataMatrix(gene.first, i) = 0.0;
+				data[gene.first][i] = 0.0;
+				++demoted;
+			}
+		}
+		genes.erase(
+				std::remove_if(genes.begin(), genes.end(),
+						[minimumSize](const std::pair<unsigned int, unsigned int> &gene) {
+							return gene.second < minimumSize;
+						}), genes.end());
+		auto &sizes = componentSizes[i];
+		sizes.erase(std::remove_if(sizes.begin(), sizes.end(),
+				[minimumSize](unsigned int size) {
+					return size < minimumSize;
+				}), sizes.end());
+	}
+	return demoted;
+}
+
+std::vector<std::string> PositiveComponents::getEmptySamples() const {
+	std::vector<std::string> samples;
+	for (unsigned int i = 0; i < positiveGenes.size(); ++i) {
+		if (positiveGenes[i].empty()) {
+			samples.push_back(ptrToData->getPatientsHandler()[i].toString());
+		}
+	}
+	return samples;
+}
+
+void PositiveComponents::writeSkippedSamples(
+		const std::vector<std::string> &samples, const std::string &filename) {
+	//Synchronous : the job scheduler reads it back
+	std::ofstream outputStream(filename);
+	for (const auto &sample : samples) {
+		outputStream << sample << "\n";
+	}
+	outputStream.close();
+	if (!outputStream) {
+		throw std::runtime_error("Cannot write " + filename);
+	}
+}
+
+std::vector<std::string> PositiveComponents::readSkippedSamples(
+		const std::string &filename) {
+	std::vector<std::string> samples;
+	std::ifstream inputStream(filename);
+	std::string sample;
+	while (inputStream >> sample) {
+		samples.push_back(sample);
+	}
+	return samples;
+}
@@ -0,0 +1,62 @@
+/*
+ * positiveComponents.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_POSITIVECOMPONENTS_HPP_
+#define SRC_HEINZ_ANALYZER_POSITIVECOMPONENTS_HPP_
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <utility>
+#include <iostream>
+#include "graph.hpp"
+#include "../tcga-analyzer/TCGAData.hpp"
+
+// Connected components of the positive genes of every sample in the PPI
+// graph (the binarized data : a gene is positive above 0.5). Genes which are
+// not in the graph are components of their own. Samples whose positive genes
+// are only small scattered components give Heinz little to work with : they
+// can be shrunk to their large components before exporting the solver input,
+// and skipped altogether when nothing is left.
+class PositiveComponents {
+public:
+	PositiveComponents(TCGAData *_ptrToData,
+			const std::shared_ptr<const PPIGraph> &_graph, bool _verbose = true);
+
+	//Union-find over the edges between positive genes, one sample per thread
+	void compute();
+	//Component size distribution over all samples and per class
+	void printReport(std::ostream &output = std::cout) const;
+	//Sets to 0 in the data the positive genes of the components smaller than
+	//minimumSize ; returns the number of (gene, sample) entries changed
+	unsigned long shrink(unsigned int minimumSize);
+
+	//Sizes of the components of a sample, largest first
+	const std::vector<unsigned int> &getComponentSizes(
+			unsigned int sample) const {
+		return componentSizes[sample];
+	}
+	//Samples (as in the Heinz file names) without any positive gene
+	std::vector<std::string> getEmptySamples() const;
+	//One sample per line ; an empty list is written too, so that no stale
+	//list from a previous export is used
+	static void writeSkippedSamples(const std::vector<std::string> &samples,
+			const std::string &filename);
+	static std::vector<std::string> readSkippedSamples(
+			const std::string &filename);
+
+private:
+	TCGAData *ptrToData;
+	std::shared_ptr<const PPIGraph> graph;
+	bool verbose;
+	//Row of the data matrix of each graph node, -1 if the gene is unknown
+	std::vector<int> dataRows;
+	//Per sample : (data row, size of its component) of every positive gene
+	std::vector<std::vector<std::pair<unsigned int, unsigned int>>> positiveGenes;
+	std::vector<std::vector<unsigned int>> componentSizes;
+};
+
+#endif /* SRC_HEINZ_ANALYZER_POSITIVECOMPONENTS_HPP_ */
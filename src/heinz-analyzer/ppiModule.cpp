@@ -0,0 +1,91 @@
+/*
+ * ppiModule.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "ppiModule.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include "../exportWriter.hpp"
+
+namespace {
+
+std::mutex warningsMutex;
+std::set<std::string> unknownGenes;
+
+//Heinz outputs may name genes missing from the graph : warn once per gene
+void warnUnknownGene(const std::string &name) {
+	std::lock_guard<std::mutex> lock(warningsMutex);
+	if (unknownGenes.insert(name).second) {
+		std::cerr << "Gene " << name
+				<< " is not in the PPI graph, skipped in the modules."
+				<< std::endl;
+	}
+}
+
+}
+
+PPIModule::PPIModule(const std::shared_ptr<const PPIGraph> &_graph) :
+		graph(_graph), bits((_graph->size() + WORD_BITS - 1) / WORD_BITS, 0), edgesSorted(
+				true), selfLoops(0) {
+}
+
+void PPIModule::addNode(NodeIDType id, NodeValueType value) {
+	if (!contains(id)) {
+		bits[id / WORD_BITS] |= (WordType) 1 << (id % WORD_BITS);
+		nodes.push_back( { id, value });
+	}
+}
+
+void PPIModule::addNode(const NodeNameType &name, NodeValueType value) {
+	NodeIDType id;
+	if (graph->findNode(name, &id)) {
+		addNode(id, value);
+	} else {
+		warnUnknownGene(name);
+	}
+}
+
+void PPIModule::addEdge(NodeIDType id1, NodeIDType id2) {
+	edges.push_back(
+			((std::uint64_t) std::min(id1, id2) << 32) | std::max(id1, id2));
+	edgesSorted = false;
+}
+
+void PPIModule::addEdge(const NodeNameType &name1, const NodeNameType &name2) {
+	NodeIDType id1, id2;
+	if (graph->findNode(name1, &id1) && graph->findNode(name2, &id2)) {
+		addEdge(id1, id2);
+	}
+}
+
+unsigned int PPIModule::edgeCount() const {
+	sortEdges();
+	return (2 * (edges.size() - selfLoops) + selfLoops) / 2;
+}
+
+void PPIModule::sortEdges() const {
+	if (edgesSorted) {
+		return;
+	}
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	selfLoops = std::count_if(edges.begin(), edges.end(),
+			[](std::uint64_t key) {
+				return (key >> 32) == (key & 0xffffffffULL);
+			});
+	edgesSorted = true;
+}
+
+void PPIModule::printNodesToFile(const std::string &filename) const {
+	ExportStream output(filename);
+	for (const auto &node : nodes) {
+		output << graph->getNodeName(node.first) << " " << node.second
+				<< std::endl;
+	}
+}
@@ -0,0 +1,67 @@
+/*
+ * ppiModule.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_HEINZ_ANALYZER_PPIMODULE_HPP_
+#define SRC_HEINZ_ANALYZER_PPIMODULE_HPP_
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "graph.hpp"
+
+// Connected subgraph of a PPIGraph : node membership is a bitset over the
+// node IDs of the whole graph
+class PPIModule {
+public:
+	typedef PPIGraph::NodeIDType NodeIDType;
+	typedef PPIGraph::NodeValueType NodeValueType;
+	typedef PPIGraph::NodeNameType NodeNameType;
+	typedef std::uint64_t WordType;
+
+	PPIModule(const std::shared_ptr<const PPIGraph> &_graph);
+
+	void addNode(NodeIDType id, NodeValueType value);
+	//Genes which are not in the graph are skipped, with a warning
+	void addNode(const NodeNameType &name, NodeValueType value);
+	void addEdge(NodeIDType id1, NodeIDType id2);
+	void addEdge(const NodeNameType &name1, const NodeNameType &name2);
+
+	unsigned int size() const {
+		return nodes.size();
+	}
+	//Same convention as PPIGraph : a self loop counts for half an edge
+	unsigned int edgeCount() const;
+	bool contains(NodeIDType id) const {
+		return (bits[id / WORD_BITS] >> (id % WORD_BITS)) & 1;
+	}
+
+	const std::shared_ptr<const PPIGraph> &getGraph() const {
+		return graph;
+	}
+	//Nodes in insertion order, with their value in this module
+	const std::vector<std::pair<NodeIDType, NodeValueType>> &getNodesHandler() const {
+		return nodes;
+	}
+	const std::vector<WordType> &getBits() const {
+		return bits;
+	}
+
+	void printNodesToFile(const std::string &filename) const;
+
+	static const unsigned int WORD_BITS = 64;
+private:
+	std::shared_ptr<const PPIGraph> graph;
+	std::vector<WordType> bits;
+	std::vector<std::pair<NodeIDType, NodeValueType>> nodes;
+	//Appended as they come, sorted and deduplicated when counted
+	mutable std::vector<std::uint64_t> edges;
+	mutable bool edgesSorted;
+	mutable unsigned int selfLoops;
+
+	void sortEdges() const;
+};
+
+#endif /* SRC_HEINZ_ANALYZER_PPIMODULE_HPP_ */
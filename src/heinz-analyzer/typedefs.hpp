@@ -11,7 +11,6 @@
 #include <string>
 #include <vector>
 #include <tuple>
-#include <map>
 
 using WeightType = std::string;
 using CancerNameType = std::string;
@@ -19,8 +18,4 @@ using IsTumorType = bool;
 
 using HeinzClass = std::tuple<WeightType, CancerNameType, IsTumorType>;
 
-using NegativeGeneCount = std::map<HeinzClass, std::map<std::string, unsigned int>>;
-using DegreeStatistics = std::map<HeinzClass, std::vector<float>>;
-using ClassCount = std::map<HeinzClass, unsigned int>;
-
 #endif /* SRC_HEINZ_ANALYZER_TYPEDEFS_HPP_ */
@@ -21,8 +21,4 @@ int main(int argc, char *argv[]) {
 
 	CommandLineProcessor clp(argc, argv);
 	clp.runProgram();
-	/*
-	 HeinzOutputAnalyzer outputAnalyzer("negative-weights.txt", "samples.txt");
-	 outputAnalyzer.analyze();
-	 */
 }
@@ -0,0 +1,224 @@
+/*
+ * memory.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "memory.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct StageRecord {
+	const char *name;
+	unsigned int depth;
+	unsigned long long startRSS;
+	unsigned long long endRSS;
+	unsigned long long peakRSS;
+	//Ran while a stage of another thread was open : the peak is the one of
+	//the whole process over that time
+	bool overlapping;
+	std::vector<std::pair<const char *, unsigned long long>> tracked;
+};
+
+std::mutex stagesMutex;
+std::vector<StageRecord> stages;
+//Indices in stages of the open stages of all threads
+std::vector<unsigned int> openStages;
+//Those of the current thread, innermost last
+thread_local std::vector<unsigned int> threadStages;
+unsigned long long runPeakRSS = 0;
+
+//Value of a "Key:   1234 kB" line, in bytes
+unsigned long long readProcValue(const std::string &filename,
+		const std::string &key) {
+	std::ifstream input(filename);
+	std::string line;
+	while (std::getline(input, line)) {
+		if (line.compare(0, key.size(), key) == 0) {
+			std::istringstream ss(line.substr(key.size()));
+			unsigned long long value = 0;
+			ss >> value;
+			return value * 1024;
+		}
+	}
+	return 0;
+}
+
+//The peak is reset so that the next stage starts from the current RSS (the
+//peaks of the open stages are folded before). Only done when no other thread
+//has a stage open, whose peak would be lost.
+void foldPeak() {
+	unsigned long long peak = MemoryMonitor::getPeakRSS();
+	runPeakRSS = std::max(runPeakRSS, peak);
+	for (unsigned int stage : openStages) {
+		stages[stage].peakRSS = std::max(stages[stage].peakRSS, peak);
+	}
+}
+
+void resetPeak() {
+	std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+}
+
+bool MemoryMonitor::enabled = false;
+unsigned long long MemoryMonitor::limit = 0;
+
+unsigned long long MemoryMonitor::getCurrentRSS() {
+	return readProcValue("/proc/self/status", "VmRSS:");
+}
+
+unsigned long long MemoryMonitor::getPeakRSS() {
+	return readProcValue("/proc/self/status", "VmHWM:");
+}
+
+unsigned long long MemoryMonitor::getAvailableMemory() {
+	return readProcValue("/proc/meminfo", "MemAvailable:");
+}
+
+void MemoryMonitor::setLimit(unsigned long long bytes) {
+	limit = bytes;
+}
+
+unsigned long long MemoryMonitor::getLimit() {
+	if (limit > 0) {
+		return limit;
+	}
+	unsigned long long available = getAvailableMemory();
+	return available == 0 ? 0 : available + getCurrentRSS();
+}
+
+void MemoryMonitor::checkEstimate(unsigned long long requiredBytes) {
+	unsigned long long currentLimit = getLimit();
+	requiredBytes += getCurrentRSS();
+	if (currentLimit > 0 && requiredBytes > currentLimit) {
+		throw memory_limit_exception(
+				"This run needs about " + formatBytes(requiredBytes)
+						+ " of memory but only " + formatBytes(currentLimit)
+						+ " are available. Lower -maxtumor / -maxcontrol, "
+								"use fewer cancers or raise -memlimit.");
+	}
+}
+
+void MemoryMonitor::enable() {
+	enabled = true;
+}
+
+void MemoryMonitor::track(const char *container, unsigned long long bytes) {
+	if (!enabled) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	if (!threadStages.empty()) {
+		stages[threadStages.back()].tracked.push_back( { container, bytes });
+	}
+}
+
+unsigned int MemoryMonitor::beginStage(const char *name) {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	foldPeak();
+	bool overlapping = openStages.size() > threadStages.size();
+	if (overlapping) {
+		for (unsigned int stage : openStages) {
+			stages[stage].overlapping = true;
+		}
+	} else {
+		resetPeak();
+	}
+	StageRecord record;
+	record.name = name;
+	record.depth = threadStages.size();
+	record.startRSS = getCurrentRSS();
+	record.endRSS = 0;
+	record.peakRSS = record.startRSS;
+	record.overlapping = overlapping;
+	stages.push_back(record);
+	openStages.push_back(stages.size() - 1);
+	threadStages.push_back(stages.size() - 1);
+	return stages.size() - 1;
+}
+
+void MemoryMonitor::endStage(unsigned int stage) {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	foldPeak();
+	stages[stage].endRSS = getCurrentRSS();
+	openStages.erase(std::find(openStages.begin(), openStages.end(), stage));
+	threadStages.erase(
+			std::find(threadStages.begin(), threadStages.end(), stage));
+}
+
+void MemoryMonitor::printReport(std::ostream &output) {
+	std::lock_guard<std::mutex> lock(stagesMutex);
+	foldPeak();
+	std::ios::fmtflags flags = output.flags();
+	output << std::left << std::setw(32) << "Stage" << std::setw(12) << "Start"
+			<< std::setw(12) << "End" << std::setw(12) << "Peak" << "Tracked"
+			<< std::endl;
+	bool overlapping = false;
+	for (const auto &stage : stages) {
+		overlapping = overlapping || stage.overlapping;
+		std::string tracked;
+		for (const auto &container : stage.tracked) {
+			tracked += (tracked.empty() ? "" : ", ")
+					+ std::string(container.first) + " "
+					+ formatBytes(container.second);
+		}
+		output << std::setw(32)
+				<< std::string(2 * stage.depth, ' ') + stage.name
+						+ (stage.overlapping ? " (*)" : "")
+				<< std::setw(12) << formatBytes(stage.startRSS) << std::setw(12)
+				<< formatBytes(stage.endRSS) << std::setw(12)
+				<< formatBytes(stage.peakRSS) << tracked << std::endl;
+	}
+	if (overlapping) {
+		output << "(*) Ran alongside stages of other threads : the peak is "
+				"the one of the whole process" << std::endl;
+	}
+	output << "* Peak RSS of the run : " << formatBytes(runPeakRSS)
+			<< std::endl;
+	output.flags(flags);
+}
+
+std::string MemoryMonitor::formatBytes(unsigned long long bytes) {
+	std::ostringstream ss;
+	ss << std::fixed << std::setprecision(1);
+	if (bytes >= (1ULL << 30)) {
+		ss << bytes / (double) (1ULL << 30) << " GB";
+	} else if (bytes >= (1ULL << 20)) {
+		ss << bytes / (double) (1ULL << 20) << " MB";
+	} else {
+		ss << bytes / 1024.0 << " kB";
+	}
+	return ss.str();
+}
+
+MemoryStage::MemoryStage(const char *name) :
+		recorded(MemoryMonitor::isEnabled()), stage(0) {
+	if (MemoryMonitor::limit > 0) {
+		unsigned long long rss = MemoryMonitor::getCurrentRSS();
+		if (rss > MemoryMonitor::limit) {
+			throw memory_limit_exception(
+					"Memory limit exceeded before stage '" + std::string(name)
+							+ "' : " + MemoryMonitor::formatBytes(rss)
+							+ " resident, limit is "
+							+ MemoryMonitor::formatBytes(MemoryMonitor::limit)
+							+ ".");
+		}
+	}
+	if (recorded) {
+		stage = MemoryMonitor::beginStage(name);
+	}
+}
+
+MemoryStage::~MemoryStage() {
+	if (recorded) {
+		MemoryMonitor::endStage(stage);
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * memory.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_MEMORY_HPP_
+#define SRC_MEMORY_HPP_
+
+#include <string>
+#include <iostream>
+#include <exception>
+
+class memory_limit_exception: public std::exception {
+public:
+	memory_limit_exception(std::string _msg = "Memory limit exceeded") :
+			msg(_msg) {
+	}
+	~memory_limit_exception() throw () {
+	}
+	const char* what() const throw () {
+		return msg.c_str();
+	}
+private:
+	std::string msg;
+};
+
+// Resident memory of the process, read from /proc (all sizes in bytes, 0 when
+// /proc cannot be read), and a per-stage report of the peak RSS.
+class MemoryMonitor {
+public:
+	static unsigned long long getCurrentRSS();
+	static unsigned long long getPeakRSS();
+	//MemAvailable of the system
+	static unsigned long long getAvailableMemory();
+
+	//0 means what is available now : current RSS + MemAvailable
+	static void setLimit(unsigned long long bytes);
+	static unsigned long long getLimit();
+	//Throws if requiredBytes, on top of the current RSS, is above the limit
+	static void checkEstimate(unsigned long long requiredBytes);
+
+	//Stages are only recorded once enabled
+	static void enable();
+	static bool isEnabled() {
+		return enabled;
+	}
+	//Size of a container allocated in the innermost stage of the calling thread
+	static void track(const char *container, unsigned long long bytes);
+	static void printReport(std::ostream &output = std::cout);
+
+	static std::string formatBytes(unsigned long long bytes);
+
+private:
+	friend class MemoryStage;
+	static bool enabled;
+	static unsigned long long limit;
+
+	static unsigned int beginStage(const char *name);
+	static void endStage(unsigned int stage);
+};
+
+//Peak RSS between construction and destruction. Stages nest per thread ; one
+//running alongside stages of other threads gets the peak of the whole process
+//and is reported as such. Also fails before the stage starts when an explicit
+//limit is already exceeded.
+class MemoryStage {
+public:
+	explicit MemoryStage(const char *name);
+	~MemoryStage();
+	MemoryStage(const MemoryStage &) = delete;
+	MemoryStage &operator=(const MemoryStage &) = delete;
+
+private:
+	bool recorded;
+	unsigned int stage;
+};
+
+#endif /* SRC_MEMORY_HPP_ */
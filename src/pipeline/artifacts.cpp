@@ -0,0 +1,61 @@
+/*
+ * artifacts.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "artifacts.hpp"
+
+#include "../utilities.hpp"
+
+void writeArtifact(std::ostream &output, const TCGAData &data) {
+	data.save(output);
+}
+
+void readArtifact(std::istream &input, TCGAData *data) {
+	data->load(input);
+	data->buildDataMatrix();
+}
+
+void writeArtifact(std::ostream &output, const Eigen::MatrixXd &matrix) {
+	writeBinary(output, (unsigned int) matrix.rows());
+	writeBinary(output, (unsigned int) matrix.cols());
+	output.write(reinterpret_cast<const char *>(matrix.data()),
+			matrix.size() * sizeof(double));
+}
+
+void readArtifact(std::istream &input, Eigen::MatrixXd *matrix) {
+	unsigned int rows = 0;
+	unsigned int cols = 0;
+	readBinary(input, &rows);
+	readBinary(input, &cols);
+	if (!input) {
+		throw tcga_data_exception("Truncated matrix artifact");
+	}
+	matrix->resize(rows, cols);
+	input.read(reinterpret_cast<char *>(matrix->data()),
+			matrix->size() * sizeof(double));
+	if (!input) {
+		throw tcga_data_exception("Truncated matrix artifact");
+	}
+}
+
+void writeArtifact(std::ostream &output, const std::vector<int> &clusters) {
+	writeBinary(output, (unsigned int) clusters.size());
+	output.write(reinterpret_cast<const char *>(clusters.data()),
+			clusters.size() * sizeof(int));
+}
+
+void readArtifact(std::istream &input, std::vector<int> *clusters) {
+	unsigned int size = 0;
+	readBinary(input, &size);
+	if (!input) {
+		throw tcga_data_exception("Truncated clustering artifact");
+	}
+	clusters->resize(size);
+	input.read(reinterpret_cast<char *>(clusters->data()),
+			size * sizeof(int));
+	if (!input) {
+		throw tcga_data_exception("Truncated clustering artifact");
+	}
+}
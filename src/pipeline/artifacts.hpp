@@ -0,0 +1,24 @@
+/*
+ * artifacts.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_PIPELINE_ARTIFACTS_HPP_
+#define SRC_PIPELINE_ARTIFACTS_HPP_
+
+#include <iostream>
+#include <vector>
+#include <Eigen/Dense>
+#include "../tcga-analyzer/TCGAData.hpp"
+
+//Binary forms of the pipeline artifacts. Readers throw tcga_data_exception
+//on a truncated or foreign file.
+void writeArtifact(std::ostream &output, const TCGAData &data);
+void readArtifact(std::istream &input, TCGAData *data);
+void writeArtifact(std::ostream &output, const Eigen::MatrixXd &matrix);
+void readArtifact(std::istream &input, Eigen::MatrixXd *matrix);
+void writeArtifact(std::ostream &output, const std::vector<int> &clusters);
+void readArtifact(std::istream &input, std::vector<int> *clusters);
+
+#endif /* SRC_PIPELINE_ARTIFACTS_HPP_ */
@@ -0,0 +1,242 @@
+/*
+ * pipeline.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <mutex>
+#include <cerrno>
+#include <sys/stat.h>
+#include "../threads.hpp"
+#include "../utilities.hpp"
+
+namespace {
+
+std::mutex outputMutex;
+
+}
+
+Pipeline::Pipeline(const std::string &_cacheDirectory, bool _useCache,
+		bool _verbose) :
+		cacheDirectory(_cacheDirectory), useCache(_useCache), verbose(
+				_verbose) {
+	if (useCache && mkdir(cacheDirectory.c_str(), 0755) != 0
+			&& errno != EEXIST) {
+		throw std::runtime_error("Cannot create directory " + cacheDirectory);
+	}
+}
+
+unsigned int Pipeline::addStage(const std::string &name,
+		const std::vector<std::string> &inputs,
+		const std::string &parameters) {
+	if (stageIds.count(name)) {
+		throw std::invalid_argument("Duplicate pipeline stage '" + name + "'");
+	}
+	Stage stage;
+	stage.name = name;
+	std::string keyContent = name + "\n" + parameters + "\n";
+	for (const auto &input : inputs) {
+		auto it = stageIds.find(input);
+		if (it == stageIds.end()) {
+			throw std::invalid_argument(
+					"Stage '" + name + "' needs '" + input
+							+ "', which should be added before it");
+		}
+		stage.inputs.push_back(it->second);
+		keyContent += stages[it->second].key + "\n";
+	}
+	stage.key = toHexString(hashBytes(keyContent));
+	stages.push_back(stage);
+	stageIds[name] = stages.size() - 1;
+	return stages.size() - 1;
+}
+
+const Pipeline::Stage &Pipeline::getStage(const std::string &name) const {
+	auto it = stageIds.find(name);
+	if (it == stageIds.end()) {
+		throw std::invalid_argument("Unknown pipeline stage '" + name + "'");
+	}
+	return stages[it->second];
+}
+
+std::string Pipeline::getArtifactFile(const Stage &stage) const {
+	return cacheDirectory + stage.name + "-" + stage.key + ".bin";
+}
+
+void Pipeline::run(const std::vector<std::string> &targets) {
+	//Consumers come after their inputs : walking backwards, whether a stage
+	//is needed is known before its own inputs are looked at
+	std::vector<bool> needed(stages.size(), false);
+	for (const auto &target : targets) {
+		getStage(target);
+		needed[stageIds.at(target)] = true;
+	}
+	for (int i = stages.size() - 1; i >= 0; --i) {
+		Stage &stage = stages[i];
+		if (!needed[i] || stage.artifact) {
+			continue;
+		}
+		if (useCache && std::ifstream(getArtifactFile(stage)).good()) {
+			stage.status = CACHED;
+		} else {
+			stage.status = COMPUTED;
+			for (unsigned int input : stage.inputs) {
+				needed[input] = true;
+			}
+		}
+	}
+
+	//Stages of the same level (longest chain of computed inputs) may run at
+	//the same time
+	std::vector<unsigned int> levels(stages.size(), 0);
+	std::map<unsigned int, unsigned int> levelWidths;
+	for (unsigned int i = 0; i < stages.size(); ++i) {
+		if (!needed[i] || stages[i].artifact || stages[i].status != COMPUTED) {
+			continue;
+		}
+		for (unsigned int input : stages[i].inputs) {
+			if (needed[input] && !stages[input].artifact
+					&& stages[input].status == COMPUTED) {
+				levels[i] = std::max(levels[i], levels[input] + 1);
+			}
+		}
+		++levelWidths[levels[i]];
+	}
+	unsigned int numberOfSlices = 1;
+	for (const auto &kv : levelWidths) {
+		numberOfSlices = std::max(numberOfSlices, kv.second);
+	}
+	takenSlices.assign(std::min(numberOfSlices, ThreadBudget::getThreads()),
+			false);
+
+	std::vector<std::shared_future<void>> futures(stages.size());
+	for (unsigned int i = 0; i < stages.size(); ++i) {
+		if (needed[i] && !stages[i].artifact) {
+			futures[i] = std::async(std::launch::async, [this, i, &futures]() {
+				runStage(i, futures);
+			}).share();
+		}
+	}
+
+	std::exception_ptr exception = nullptr;
+	for (auto &future : futures) {
+		if (future.valid()) {
+			try {
+				future.get();
+			} catch (...) {
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+		}
+	}
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+void Pipeline::runStage(unsigned int id,
+		const std::vector<std::shared_future<void>> &futures) {
+	Stage &stage = stages[id];
+	std::string artifactFile = getArtifactFile(stage);
+	auto start = std::chrono::steady_clock::now();
+
+	if (stage.status == CACHED) {
+		std::ifstream input(artifactFile, std::ios::binary);
+		try {
+			stage.artifact = stage.load(input);
+		} catch (const std::exception &e) {
+			throw tcga_data_exception(
+					"Cannot read cached artifact " + artifactFile + " ("
+							+ e.what() + "), remove it to recompute the stage");
+		}
+	} else {
+		Inputs inputs;
+		for (unsigned int input : stage.inputs) {
+			//Rethrows the failure of an input
+			if (futures[input].valid()) {
+				futures[input].get();
+			}
+			inputs.artifacts.push_back(stages[input].artifact);
+		}
+		//Not the time spent waiting for the inputs
+		start = std::chrono::steady_clock::now();
+		unsigned int slice = takeSlice();
+		try {
+			ThreadScope threads(slice, takenSlices.size());
+			stage.artifact = stage.compute(inputs);
+		} catch (...) {
+			releaseSlice(slice);
+			throw;
+		}
+		releaseSlice(slice);
+		if (useCache) {
+			//Only complete artifacts ever appear under their final name
+			std::string temporaryFile = temporaryFilename(artifactFile);
+			{
+				std::ofstream output(temporaryFile, std::ios::binary);
+				stage.save(stage.artifact.get(), output);
+				if (!output) {
+					std::remove(temporaryFile.c_str());
+					throw std::runtime_error("Cannot write " + temporaryFile);
+				}
+			}
+			if (std::rename(temporaryFile.c_str(), artifactFile.c_str()) != 0) {
+				std::remove(temporaryFile.c_str());
+				throw std::runtime_error(
+						"Cannot rename " + temporaryFile + " to " + artifactFile);
+			}
+		}
+	}
+
+	stage.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	if (verbose) {
+		std::lock_guard<std::mutex> lock(outputMutex);
+		std::cout << "* " << stage.name << " : "
+				<< (stage.status == CACHED ? "loaded from cache" : "computed")
+				<< " in " << stage.seconds << " s" << std::endl;
+	}
+}
+
+unsigned int Pipeline::takeSlice() {
+	std::unique_lock<std::mutex> lock(slicesMutex);
+	std::vector<bool>::iterator slice;
+	slicesCondition.wait(lock, [this, &slice]() {
+		slice = std::find(takenSlices.begin(), takenSlices.end(), false);
+		return slice != takenSlices.end();
+	});
+	*slice = true;
+	return slice - takenSlices.begin();
+}
+
+void Pipeline::releaseSlice(unsigned int slice) {
+	{
+		std::lock_guard<std::mutex> lock(slicesMutex);
+		takenSlices[slice] = false;
+	}
+	slicesCondition.notify_one();
+}
+
+void Pipeline::printSummary(std::ostream &output) const {
+	std::ios::fmtflags flags = output.flags();
+	std::streamsize precision = output.precision();
+	output << std::left << std::setw(28) << "Stage" << std::setw(20) << "Key"
+			<< std::setw(12) << "Status" << "Time (s)" << std::endl;
+	output << std::fixed << std::setprecision(3);
+	for (const auto &stage : stages) {
+		output << std::setw(28) << stage.name << std::setw(20) << stage.key
+				<< std::setw(12)
+				<< (stage.status == CACHED ? "cached" :
+					stage.status == COMPUTED ? "computed" : "-")
+				<< stage.seconds << std::endl;
+	}
+	output.flags(flags);
+	output.precision(precision);
+}
@@ -0,0 +1,128 @@
+/*
+ * pipeline.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_PIPELINE_PIPELINE_HPP_
+#define SRC_PIPELINE_PIPELINE_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "artifacts.hpp"
+
+// Stages declare their inputs (earlier stages) and their parameters. The key
+// of a stage hashes its name, its parameters and the keys of its inputs : an
+// artifact saved under that key in the cache directory is reused as long as
+// nothing upstream changed. Stages which do not depend on each other run
+// concurrently : the thread budget is split in fixed slices, as many as the
+// widest level of the stages to compute, and a stage computes on one slice.
+// A stage ready while every slice is taken waits for one, so that the budget
+// is never oversubscribed and pinned slices never overlap.
+class Pipeline {
+public:
+	class Inputs {
+	public:
+		template<typename T>
+		const T &get(unsigned int i) const {
+			return *std::static_pointer_cast<const T>(artifacts.at(i));
+		}
+	private:
+		friend class Pipeline;
+		std::vector<std::shared_ptr<const void>> artifacts;
+	};
+
+	Pipeline(const std::string &_cacheDirectory, bool _useCache,
+			bool _verbose);
+
+	//T needs writeArtifact / readArtifact overloads (see artifacts.hpp)
+	template<typename T>
+	void addStage(const std::string &name,
+			const std::vector<std::string> &inputs,
+			const std::string &parameters,
+			const std::function<std::shared_ptr<T>(const Inputs &)> &compute);
+
+	//Runs what the targets need : cached artifacts are loaded, and their
+	//inputs are neither loaded nor computed
+	void run(const std::vector<std::string> &targets);
+
+	template<typename T>
+	std::shared_ptr<const T> get(const std::string &name) const {
+		const Stage &stage = getStage(name);
+		if (!stage.artifact) {
+			throw std::logic_error("Stage '" + name + "' has not been run");
+		}
+		return std::static_pointer_cast<const T>(stage.artifact);
+	}
+	std::string getKey(const std::string &name) const {
+		return getStage(name).key;
+	}
+
+	void printSummary(std::ostream &output = std::cout) const;
+
+private:
+	enum StageStatus {
+		NOT_NEEDED, CACHED, COMPUTED
+	};
+
+	struct Stage {
+		std::string name;
+		std::vector<unsigned int> inputs;
+		std::string key;
+		std::function<std::shared_ptr<const void>(const Inputs &)> compute;
+		std::function<void(const void *, std::ostream &)> save;
+		std::function<std::shared_ptr<const void>(std::istream &)> load;
+		StageStatus status = NOT_NEEDED;
+		double seconds = 0;
+		std::shared_ptr<const void> artifact;
+	};
+
+	std::string cacheDirectory;
+	bool useCache;
+	bool verbose;
+	std::vector<Stage> stages;
+	std::map<std::string, unsigned int> stageIds;
+	std::mutex slicesMutex;
+	std::condition_variable slicesCondition;
+	//Whether each slice of the thread budget is taken by a running stage
+	std::vector<bool> takenSlices;
+
+	const Stage &getStage(const std::string &name) const;
+	unsigned int addStage(const std::string &name,
+			const std::vector<std::string> &inputs,
+			const std::string &parameters);
+	std::string getArtifactFile(const Stage &stage) const;
+	void runStage(unsigned int id,
+			const std::vector<std::shared_future<void>> &futures);
+	unsigned int takeSlice();
+	void releaseSlice(unsigned int slice);
+};
+
+template<typename T>
+void Pipeline::addStage(const std::string &name,
+		const std::vector<std::string> &inputs, const std::string &parameters,
+		const std::function<std::shared_ptr<T>(const Inputs &)> &compute) {
+	Stage &stage = stages[addStage(name, inputs, parameters)];
+	stage.compute = [compute](const Inputs &stageInputs) {
+		return std::shared_ptr<const void>(compute(stageInputs));
+	};
+	stage.save = [](const void *artifact, std::ostream &output) {
+		writeArtifact(output, *static_cast<const T *>(artifact));
+	};
+	stage.load = [](std::istream &input) {
+		std::shared_ptr<T> artifact = std::make_shared<T>();
+		readArtifact(input, artifact.get());
+		return std::shared_ptr<const void>(artifact);
+	};
+}
+
+#endif /* SRC_PIPELINE_PIPELINE_HPP_ */
@@ -0,0 +1,459 @@
+/*
+ * runConfig.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "runConfig.hpp"
+
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include "utilities.hpp"
+
+namespace {
+
+std::string toString(double value) {
+	std::ostringstream ss;
+	ss << std::setprecision(10) << value;
+	return ss.str();
+}
+
+//Whole value made of digits, between minimum and maximum
+unsigned long long parseInteger(const std::string &optionName,
+		const std::string &optionValue, unsigned long long minimum,
+		unsigned long long maximum = std::numeric_limits<unsigned int>::max()) {
+	bool digits = !optionValue.empty() && optionValue.size() <= 19;
+	for (char c : optionValue) {
+		digits = digits && std::isdigit(static_cast<unsigned char>(c));
+	}
+	unsigned long long value =
+			digits ? std::strtoull(optionValue.c_str(), nullptr, 10) : 0;
+	if (!digits || value < minimum || value > maximum) {
+		throw wrong_usage_exception(
+				optionName + " option value should be an integer "
+						+ (maximum == std::numeric_limits<unsigned int>::max() ?
+								"of at least " + std::to_string(minimum) :
+								"between " + std::to_string(minimum) + " and "
+										+ std::to_string(maximum)) + ".");
+	}
+	return value;
+}
+
+}
+
+void RunConfig::set(const std::string &optionName,
+		const std::string &optionValue) {
+	if (optionName == "-mode") {
+		if (std::isdigit(optionValue[0])) {
+			int i = std::atoi(optionValue.c_str());
+			if (i >= 0 && i <= 10) {
+				programMode = i;
+			} else {
+				throw wrong_usage_exception(
+						"-mode option value should be an integer between 0 and 10.");
+
+			}
+		} else {
+			throw wrong_usage_exception(
+					"-mode option value should be an integer between 0 and 10.");
+		}
+	}
+
+	else if (optionName == "-cancers") {
+		cancers.clear();
+		for (const auto &s : split(optionValue, { ',' })) {
+			if (ALLOWED_CANCERS.find(s) != ALLOWED_CANCERS.end()) {
+				cancers.insert(s);
+			} else {
+				throw wrong_usage_exception(
+						"Error when trying to process cancer with name '" + s
+								+ "'. -cancers must be a subset of "
+								+ implode(ALLOWED_CANCERS.begin(),
+										ALLOWED_CANCERS.end(), ","));
+			}
+		}
+		if (cancers.find("SARCB") != cancers.end()) {
+			if (cancers.size() != 1) {
+				throw wrong_usage_exception(
+						"Cannot mix Bergonie samples and TCGA samples.");
+			}
+			//Use the right graph
+			else {
+				graphNodeFile = GRAPH_NODE_FILE_BERGONIE;
+				graphEdgeFile = GRAPH_EDGE_FILE_BERGONIE;
+				sampleFile = SAMPLE_BERGONIE_FILE;
+			}
+		}
+	}
+
+	else if (optionName == "-clinical") {
+		std::vector<std::string> clinicalAttributes = split(optionValue,
+				{ ',' });
+		for (const auto &attribute : clinicalAttributes) {
+			clinical.insert(attribute);
+		}
+	}
+
+	else if (optionName == "-weights") {
+		weights.clear();
+		std::vector<std::string> weightStrings = split(optionValue, { ',' });
+		for (const auto &s : weightStrings) {
+			double d = std::atof(s.c_str());
+			if (d <= 0) {
+				throw wrong_usage_exception(
+						"Error when trying to process weight '" + s
+								+ "'. -weights should be a comma-separated list of weights (without the minus sign).");
+			}
+			weights.push_back(d);
+		}
+	}
+
+	else if (optionName == "-maxcontrol") {
+		maxControlSamples = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-maxtumor") {
+		maxTumorSamples = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-verbose") {
+		verbose = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-k") {
+		K = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-normalization") {
+		if (std::isdigit(optionValue[0])) {
+			int i = std::atoi(optionValue.c_str());
+			//Default is 1
+			if (i == 0) {
+				normalizationMethod = KMEANS_NORMALIZATION;
+			} else if (i == 2) {
+				normalizationMethod = NO_NORMALIZATION;
+			} else if (i != 1) {
+				throw wrong_usage_exception(
+						"-normalization option value should be a digit between 0 and 2.");
+
+			}
+		} else {
+			throw wrong_usage_exception(
+					"-normalization option value should be a digit between 0 and 2.");
+		}
+	}
+
+	else if (optionName == "-cutpercentage") {
+		binaryQuantileCutPercentage = std::atof(optionValue.c_str());
+		if (binaryQuantileCutPercentage < 0
+				|| binaryQuantileCutPercentage > 1) {
+			throw wrong_usage_exception(
+					"Error while processing " + optionName + " " + optionValue
+							+ ".\n The cut percentage should be between 0 and 1");
+		}
+	}
+
+	else if (optionName == "-metric") {
+		if (ALLOWED_METRICS.find(optionValue) == ALLOWED_METRICS.end()) {
+			throw wrong_usage_exception(
+					"Error while processing " + optionName + " " + optionValue
+							+ ".\n The metric name should be in the following set: \n{ "
+							+ implode(ALLOWED_METRICS.begin(),
+									ALLOWED_METRICS.end(), ", ") + " }");
+		}
+		metricName = optionValue;
+	}
+
+	else if (optionName == "-distancekernels") {
+		if (optionValue == "native") {
+			distanceKernelMode = DistanceKernels::NATIVE;
+		} else if (optionValue == "float") {
+			distanceKernelMode = DistanceKernels::NATIVE_FLOAT;
+		} else if (optionValue == "clusterxx") {
+			distanceKernelMode = DistanceKernels::CLUSTERXX;
+		} else {
+			throw wrong_usage_exception(
+					"-distancekernels option value should be native, float or clusterxx.");
+		}
+	}
+
+	else if (optionName == "-decomparisons") {
+		if (optionValue == "control") {
+			differentialComparisons = TUMOR_VERSUS_CONTROL;
+		} else if (optionValue == "all") {
+			differentialComparisons = ALL_CLASS_PAIRS;
+		} else {
+			throw wrong_usage_exception(
+					"-decomparisons option value should be control or all.");
+		}
+	}
+
+	else if (optionName == "-detest") {
+		if (optionValue == "welch") {
+			differentialTest = WELCH_TEST;
+		} else if (optionValue == "mannwhitney") {
+			differentialTest = MANN_WHITNEY_TEST;
+		} else {
+			throw wrong_usage_exception(
+					"-detest option value should be welch or mannwhitney.");
+		}
+	}
+
+	else if (optionName == "-defdr") {
+		differentialFDR = std::atof(optionValue.c_str());
+		if (differentialFDR <= 0 || differentialFDR > 1) {
+			throw wrong_usage_exception(
+					"-defdr option value should be in ]0, 1].");
+		}
+	}
+
+	else if (optionName == "-clustering") {
+		if (optionValue == "kmeans") {
+			consensusClusteringMethod = KMEANS_CLUSTERING;
+		} else if (optionValue == "spectral") {
+			consensusClusteringMethod = SPECTRAL_CLUSTERING;
+		} else if (optionValue == "hierarchical") {
+			consensusClusteringMethod = HIERARCHICAL_CLUSTERING;
+		} else {
+			throw wrong_usage_exception(
+					"-clustering option value should be one of kmeans, spectral, hierarchical.");
+		}
+	}
+
+	else if (optionName == "-rounds") {
+		consensusRounds = parseInteger(optionName, optionValue, 1);
+	}
+
+	else if (optionName == "-mink") {
+		consensusMinK = parseInteger(optionName, optionValue, 2);
+	}
+
+	else if (optionName == "-maxk") {
+		consensusMaxK = parseInteger(optionName, optionValue, 2);
+	}
+
+	else if (optionName == "-samplefraction" || optionName == "-genefraction") {
+		double fraction = std::atof(optionValue.c_str());
+		if (fraction <= 0 || fraction > 1) {
+			throw wrong_usage_exception(
+					"Error while processing " + optionName + " " + optionValue
+							+ ".\n The fraction should be in ]0, 1]");
+		}
+		if (optionName == "-samplefraction") {
+			consensusSampleFraction = fraction;
+		} else {
+			consensusGeneFraction = fraction;
+		}
+	}
+
+	else if (optionName == "-seed") {
+		consensusSeed = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-packed") {
+		heinzPackedExport = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-watch") {
+		watchHeinzOutput = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-reportinterval") {
+		watchReportInterval = parseInteger(optionName, optionValue, 1);
+	}
+
+	else if (optionName == "-watchtimeout") {
+		watchIdleTimeout = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-solver") {
+		heinzSolverCommand = optionValue;
+	}
+
+	else if (optionName == "-jobs") {
+		heinzJobs = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-timeout") {
+		heinzTimeout = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-resume") {
+		heinzResume = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-seeds") {
+		mwcsSeeds = parseInteger(optionName, optionValue, 1);
+	}
+
+	else if (optionName == "-mincomponent") {
+		minPositiveComponent = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-exportsimilarity") {
+		exportModuleSimilarity = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-trace") {
+		traceFile = optionValue;
+	}
+
+	else if (optionName == "-memreport") {
+		memoryReport = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-memlimit") {
+		memoryLimitMB = parseInteger(optionName, optionValue, 0,
+				std::numeric_limits<unsigned long long>::max() >> 20);
+	}
+
+	else if (optionName == "-asyncexport") {
+		asyncExport = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-exportqueue") {
+		exportQueueMB = parseInteger(optionName, optionValue, 1,
+				std::numeric_limits<unsigned long long>::max() >> 20);
+	}
+
+	else if (optionName == "-exportsync") {
+		exportSync = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-cache") {
+		pipelineCache = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-socket") {
+		serverSocket = optionValue;
+	}
+
+	else if (optionName == "-workers") {
+		serverWorkers = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-experiments") {
+		experimentsFile = optionValue;
+	}
+
+	else if (optionName == "-batchjobs") {
+		batchJobs = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-method") {
+		const std::set<std::string> methods = { "kmeans", "hierarchical",
+				"unnormalized-spectral", "normalized-spectral" };
+		if (methods.find(optionValue) == methods.end()) {
+			throw wrong_usage_exception(
+					"-method option value should be one of "
+							+ implode(methods.begin(), methods.end(), ", ")
+							+ ".");
+		}
+		clusteringMethod = optionValue;
+	}
+
+	else if (optionName == "-transformation") {
+		std::vector<std::string> parts = split(optionValue, { ':' });
+		if (parts.size() == 1 && parts[0] == "none") {
+			graphTransformation = {
+					ClusterXX::SpectralParameters::GraphTransformationMethod::NO_TRANSFORMATION,
+					0 };
+		} else if (parts.size() == 2 && parts[0] == "knn"
+				&& std::atoi(parts[1].c_str()) > 0) {
+			graphTransformation = {
+					ClusterXX::SpectralParameters::GraphTransformationMethod::K_NEAREST_NEIGHBORS,
+					(double) std::atoi(parts[1].c_str()) };
+		} else if (parts.size() == 2 && parts[0] == "gaussian"
+				&& std::atof(parts[1].c_str()) > 0) {
+			graphTransformation = {
+					ClusterXX::SpectralParameters::GraphTransformationMethod::GAUSSIAN_MIXTURE,
+					std::atof(parts[1].c_str()) };
+		} else {
+			throw wrong_usage_exception(
+					"-transformation option value should be knn:<k>, gaussian:<stddev> or none.");
+		}
+	}
+
+	else if (optionName == "-threads") {
+		threads = parseInteger(optionName, optionValue, 0);
+	}
+
+	else if (optionName == "-nested") {
+		if (optionValue == "outer") {
+			nestedPolicy = ThreadBudget::OUTER;
+		} else if (optionValue == "inner") {
+			nestedPolicy = ThreadBudget::INNER;
+		} else {
+			throw wrong_usage_exception(
+					"-nested option value should be outer or inner.");
+		}
+	}
+
+	else if (optionName == "-pin") {
+		pinThreads = std::atoi(optionValue.c_str());
+	}
+
+	else if (optionName == "-f") {
+		workingFile = optionValue;
+	}
+
+	else {
+		throw wrong_usage_exception(
+				"Unknown command line option '" + optionName + "'.");
+	}
+}
+
+std::shared_ptr<ClusterXX::Metric> RunConfig::buildMetric() const {
+	return ClusterXX::buildMetric(metricName);
+}
+
+std::shared_ptr<Normalizer> RunConfig::buildNormalizer() const {
+	if (normalizationMethod == KMEANS_NORMALIZATION) {
+		return std::make_shared<KMeansNormalizer>(kMeansNormalizationK,
+				kMeansMaxIterations);
+	} else if (normalizationMethod == BINARY_QUANTILE_NORMALIZATION) {
+		return std::make_shared<BinaryQuantileNormalizer>(
+				binaryQuantileCutPercentage);
+	}
+	return std::make_shared<NoOperationNormalizer>();
+}
+
+ClusteringSettings RunConfig::getClusteringSettings() const {
+	ClusteringSettings settings;
+	settings.kMeansMaxIterations = kMeansMaxIterations;
+	settings.parallelKMeans = parallelKMeans;
+	settings.linkageMethod = linkageMethod;
+	settings.graphTransformation = graphTransformation;
+	return settings;
+}
+
+std::string RunConfig::describeCohort() const {
+	return implode(cancers.begin(), cancers.end(), ",") + " "
+			+ (clinical.empty() ?
+					std::string("-") :
+					implode(clinical.begin(), clinical.end(), ",")) + " "
+			+ std::to_string(maxControlSamples) + " "
+			+ std::to_string(maxTumorSamples) + " " + sampleFile;
+}
+
+std::string RunConfig::describeNormalization() const {
+	if (normalizationMethod == KMEANS_NORMALIZATION) {
+		return "kmeans:" + std::to_string(kMeansNormalizationK) + ":"
+				+ std::to_string(kMeansMaxIterations);
+	} else if (normalizationMethod == BINARY_QUANTILE_NORMALIZATION) {
+		return "binary-quantile:" + toString(binaryQuantileCutPercentage);
+	}
+	return "none";
+}
+
+std::string RunConfig::describeGraphTransformation() const {
+	switch (graphTransformation.first) {
+	case ClusterXX::SpectralParameters::GraphTransformationMethod::K_NEAREST_NEIGHBORS:
+		return "knn:" + toString(graphTransformation.second);
+	case ClusterXX::SpectralParameters::GraphTransformationMethod::GAUSSIAN_MIXTURE:
+		return "gaussian:" + toString(graphTransformation.second);
+	default:
+		return "none";
+	}
+}
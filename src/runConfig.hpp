@@ -0,0 +1,204 @@
+/*
+ * runConfig.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_RUNCONFIG_HPP_
+#define SRC_RUNCONFIG_HPP_
+
+#include <string>
+#include <vector>
+#include <set>
+#include <memory>
+#include <stdexcept>
+#include <ClusterXX/metrics/metrics.hpp>
+#include <ClusterXX/clustering/clusterer_parameters.hpp>
+#include "config.hpp"
+#include "threads.hpp"
+#include "tcga-analyzer/TCGADataClusterer.hpp"
+#include "tcga-analyzer/TCGADataDifferentialAnalyzer.hpp"
+#include "tcga-analyzer/TCGADataNormalizer.hpp"
+#include "tcga-analyzer/distanceKernels.hpp"
+
+class wrong_usage_exception: public std::exception {
+public:
+	wrong_usage_exception(std::string _msg = "Wrong Usage Exception") :
+			msg(_msg) {
+	}
+	~wrong_usage_exception() throw () {
+	}
+	const char* what() const throw () {
+		return msg.c_str();
+	}
+private:
+	std::string msg;
+};
+
+// Every parameter of a run. A configuration is filled from "-option value"
+// pairs, then only read : runs with their own configurations can share the
+// process.
+struct RunConfig {
+	/* ------------------ General parameters -----------------*/
+	unsigned int programMode = 0;
+	bool verbose = true;
+	std::string workingFile;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Threads -----------------*/
+	//0 means one per CPU the process may run on
+	unsigned int threads = 0;
+	ThreadBudget::NestedPolicy nestedPolicy = ThreadBudget::OUTER;
+	bool pinThreads = false;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Data loader parameters -----------------*/
+	std::set<std::string> cancers = { "BRCA", "LUAD" };
+	unsigned int maxControlSamples = 20;
+	unsigned int maxTumorSamples = 20;
+	std::string sampleFile = SAMPLE_TCGA_FILE;
+	std::set<std::string> clinical = { };
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Normalization parameters -----------------*/
+	UnsupervisedNormalizationMethod normalizationMethod =
+			BINARY_QUANTILE_NORMALIZATION;
+	int kMeansNormalizationK = 2;
+	int kMeansMaxIterations = 1000;
+	double binaryQuantileCutPercentage = 0.995;
+	double minCutPercentage = 0.05;
+	double maxCutPercentage = 1;
+	double stepCutPercentage = 0.025;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Metric parameters -----------------*/
+	std::string metricName = "pearson";
+	DistanceKernels::Mode distanceKernelMode = DistanceKernels::NATIVE;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Clustering parameters -----------------*/
+	unsigned int K = 0;
+	ClusterXX::HierarchicalParameters::LinkageMethod linkageMethod =
+			ClusterXX::HierarchicalParameters::COMPLETE;
+	unsigned int parallelKMeans = 100;
+	std::pair<
+			ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
+			double> graphTransformation = {
+			ClusterXX::SpectralParameters::GraphTransformationMethod::K_NEAREST_NEIGHBORS,
+			3 };
+	//Method of the batch experiments (see buildTCGADataClusterer)
+	std::string clusteringMethod = "kmeans";
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Consensus clustering -----------------*/
+	ClusteringMethod consensusClusteringMethod = KMEANS_CLUSTERING;
+	unsigned int consensusRounds = 100;
+	unsigned int consensusMinK = 2;
+	unsigned int consensusMaxK = 6;
+	double consensusSampleFraction = 0.8;
+	double consensusGeneFraction = 1.0;
+	unsigned int consensusSeed = 0;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Module search -----------------*/
+	std::vector<double> weights = { 0.5, 1.0, 1.5, 2.0, 2.5, 3.0, 4.0, 5.0 };
+	std::string graphNodeFile = GRAPH_NODE_FILE_TCGA;
+	std::string graphEdgeFile = GRAPH_EDGE_FILE_TCGA;
+	//Export one bit per gene and per sample instead of one text file per weight
+	bool heinzPackedExport = false;
+	//Positive genes in smaller PPI components are exported as negative (1 only
+	//reports the components, 0 disables the prefilter). Only meaningful for
+	//the binary quantile normalization, where positive genes are the 1s
+	unsigned int minPositiveComponent = 0;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Heinz job scheduler -----------------*/
+	//{input}, {edges}, {weight} and {sample} are substituted (shell-quoted, so
+	//they should not be quoted again), stdout is the module
+	std::string heinzSolverCommand = "heinz -e {edges} -n {input}";
+	//0 lets the thread budget decide (see ThreadBudget::getWorkers)
+	unsigned int heinzJobs = 0;
+	//In seconds, 0 means no timeout
+	unsigned int heinzTimeout = 0;
+	bool heinzResume = true;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Heinz output watch -----------------*/
+	//Mode 4 analyzes the modules as they are produced
+	bool watchHeinzOutput = false;
+	unsigned int watchReportInterval = 30;
+	//In seconds without new module ; 0 waits until all modules are there,
+	//which never ends if a solver job failed
+	unsigned int watchIdleTimeout = 3600;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Native module search -----------------*/
+	//Number of positive components the heuristic is started from
+	unsigned int mwcsSeeds = 5;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Module clustering -----------------*/
+	//Also export the Jaccard similarity of the modules of all weights together
+	bool exportModuleSimilarity = false;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Differential expression -----------------*/
+	DifferentialComparisons differentialComparisons = TUMOR_VERSUS_CONTROL;
+	//Test ranking the exported genes and giving the Heinz node weights
+	DifferentialTest differentialTest = WELCH_TEST;
+	//Benjamini-Hochberg q-value under which a gene is called
+	double differentialFDR = 0.05;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Profiling -----------------*/
+	//Chrome trace-event file of the stage timings, nothing is recorded if empty
+	std::string traceFile = "";
+	//Peak RSS of each stage
+	bool memoryReport = false;
+	//In MB, 0 means the memory available when the run starts
+	unsigned long long memoryLimitMB = 0;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Exports -----------------*/
+	//Written by a background thread, see ExportWriter
+	bool asyncExport = true;
+	//Formatted files waiting to be written, in MB
+	unsigned long long exportQueueMB = 64;
+	//Flush each batch of written files to disk
+	bool exportSync = false;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Pipeline cache -----------------*/
+	//Reuse the artifacts of CACHE_DIRECTORY whose inputs and parameters match
+	bool pipelineCache = true;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Server -----------------*/
+	std::string serverSocket = "tcga-analyzer.sock";
+	//0 lets the thread budget decide (see ThreadBudget::getWorkers)
+	unsigned int serverWorkers = 0;
+	/*---------------------------------------------------------*/
+
+	/* ------------------ Batch experiments -----------------*/
+	//One experiment per line, see readExperiments
+	std::string experimentsFile = "experiments.txt";
+	//0 lets the thread budget decide (see ThreadBudget::getWorkers)
+	unsigned int batchJobs = 0;
+	/*---------------------------------------------------------*/
+
+	//Throws wrong_usage_exception on an unknown option or a bad value
+	void set(const std::string &optionName, const std::string &optionValue);
+
+	//New objects on every call, never shared between runs
+	std::shared_ptr<ClusterXX::Metric> buildMetric() const;
+	std::shared_ptr<Normalizer> buildNormalizer() const;
+	ClusteringSettings getClusteringSettings() const;
+
+	//What identifies the loaded samples, and their normalization (cache and
+	//memo keys, result tables)
+	std::string describeCohort() const;
+	std::string describeNormalization() const;
+	std::string describeGraphTransformation() const;
+};
+
+#endif /* SRC_RUNCONFIG_HPP_ */
@@ -0,0 +1,530 @@
+/*
+ * analyzerServer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "analyzerServer.hpp"
+
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <ClusterXX/metrics/metrics.hpp>
+#include "../config.hpp"
+#include "../threads.hpp"
+#include "../trace.hpp"
+#include "../tcga-analyzer/TCGA-Analyzer.hpp"
+
+namespace {
+
+const unsigned int MAX_REQUEST_LENGTH = 4096;
+//How often the accepting thread looks at the signals, in milliseconds
+const int POLL_INTERVAL = 200;
+
+volatile std::sig_atomic_t signalReceived = 0;
+
+void handleSignal(int) {
+	signalReceived = 1;
+}
+
+std::mutex outputMutex;
+
+bool sendAll(int connection, const std::string &message) {
+	std::size_t sent = 0;
+	while (sent < message.size()) {
+		ssize_t n = send(connection, message.data() + sent,
+				message.size() - sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		sent += n;
+	}
+	return true;
+}
+
+unsigned int parseCount(const std::string &value, const std::string &name) {
+	if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+		throw std::invalid_argument(
+				name + " should be a non-negative integer, not '" + value
+						+ "'");
+	}
+	return std::atoi(value.c_str());
+}
+
+}
+
+AnalyzerServer::AnalyzerServer(const std::shared_ptr<const TCGAData> &_data,
+		const std::shared_ptr<const PPIGraph> &_graph,
+		const ClusteringSettings &_settings, unsigned int _numberOfWorkers,
+		bool _verbose) :
+		data(_data), graph(_graph), settings(_settings), numberOfWorkers(
+				_numberOfWorkers), verbose(_verbose), stopping(false) {
+	numberOfWorkers = ThreadBudget::getWorkers(numberOfWorkers);
+}
+
+void AnalyzerServer::preload(const std::string &metricName) {
+	getDistanceMatrix(metricName);
+}
+
+std::shared_ptr<const Eigen::MatrixXd> AnalyzerServer::getDistanceMatrix(
+		const std::string &metricName) {
+	if (ALLOWED_METRICS.find(metricName) == ALLOWED_METRICS.end()) {
+		throw std::invalid_argument("Unknown metric '" + metricName + "'");
+	}
+	std::unique_lock<std::mutex> lock(distanceMatricesMutex);
+	auto it = distanceMatrices.find(metricName);
+	if (it != distanceMatrices.end()) {
+		std::shared_future<std::shared_ptr<const Eigen::MatrixXd>> matrix =
+				it->second;
+		lock.unlock();
+		//Others asking for the same metric wait for the first one
+		return matrix.get();
+	}
+	std::promise<std::shared_ptr<const Eigen::MatrixXd>> promise;
+	distanceMatrices[metricName] = promise.get_future().share();
+	lock.unlock();
+
+	try {
+		std::shared_ptr<const Eigen::MatrixXd> matrix = std::make_shared<
+				Eigen::MatrixXd>(
+				TCGADataDistanceMatrixAnalyser::computeDistanceMatrix(*data,
+						metricName, false));
+		promise.set_value(matrix);
+		return matrix;
+	} catch (...) {
+		promise.set_exception(std::current_exception());
+		//A later request retries
+		lock.lock();
+		distanceMatrices.erase(metricName);
+		throw;
+	}
+}
+
+int AnalyzerServer::findSample(const std::string &name) const {
+	const std::vector<TCGAPatientData> &patients = data->getPatientsHandler();
+	for (unsigned int i = 0; i < patients.size(); ++i) {
+		std::string label = patients[i].toString();
+		//Full label (cancer_class_patient) or patient name alone
+		if (label == name
+				|| (label.size() > name.size()
+						&& label.compare(label.size() - name.size(),
+								name.size(), name) == 0
+						&& label[label.size() - name.size() - 1] == '_')) {
+			return i;
+		}
+	}
+	throw std::invalid_argument("Unknown sample '" + name + "'");
+}
+
+std::string AnalyzerServer::handleRequest(const std::string &request) {
+	ScopedTimer timer("server/request");
+	std::istringstream words(request);
+	std::vector<std::string> arguments;
+	std::string word;
+	while (words >> word) {
+		arguments.push_back(word);
+	}
+
+	std::ostringstream output;
+	try {
+		if (arguments.empty()) {
+			throw std::invalid_argument("Empty request");
+		}
+		std::string command = arguments[0];
+		arguments.erase(arguments.begin());
+		if (command == "cluster") {
+			cluster(arguments, output);
+		} else if (command == "classstats") {
+			classStats(arguments, output);
+		} else if (command == "nearest") {
+			nearest(arguments, output);
+		} else if (command == "neighbors") {
+			neighbors(arguments, output);
+		} else if (command == "info") {
+			info(output);
+		} else if (command == "help") {
+			output << "cluster <kmeans|hierarchical|unnormalized-spectral|"
+					<< "normalized-spectral> [metric] [K, 0 = number of classes]"
+					<< std::endl;
+			output << "classstats [metric]" << std::endl;
+			output << "nearest <sample> [metric] [count]" << std::endl;
+			output << "neighbors <gene>" << std::endl;
+			output << "info" << std::endl;
+			output << "quit" << std::endl;
+			output << "shutdown" << std::endl;
+		} else if (command == "shutdown") {
+			stop();
+		} else {
+			throw std::invalid_argument("Unknown command '" + command + "'");
+		}
+	} catch (const std::exception &e) {
+		std::string message = e.what();
+		std::replace(message.begin(), message.end(), '\n', ' ');
+		return "ERROR " + message + "\n";
+	}
+	return "OK\n" + output.str();
+}
+
+void AnalyzerServer::cluster(const std::vector<std::string> &arguments,
+		std::ostream &output) {
+	if (arguments.empty() || arguments.size() > 3) {
+		throw std::invalid_argument(
+				"Usage : cluster <method> [metric] [K]");
+	}
+	const std::string &method = arguments[0];
+	std::string metricName = arguments.size() > 1 ? arguments[1] : "pearson";
+	unsigned int K = arguments.size() > 2 ? parseCount(arguments[2], "K") : 0;
+	std::shared_ptr<const Eigen::MatrixXd> distanceMatrix = getDistanceMatrix(
+			metricName);
+	std::shared_ptr<ClusterXX::Metric> metric = ClusterXX::buildMetric(
+			metricName);
+
+	//The clusterers only read the data, whose matrix is already built
+	TCGAData *ptrToData = const_cast<TCGAData *>(data.get());
+	std::unique_ptr<TCGADataClusterer> clusterer = buildTCGADataClusterer(
+			method, ptrToData, *distanceMatrix, metric, K, settings);
+	clusterer->computeClustering();
+
+	std::vector<int> clusters = clusterer->getClusters();
+	std::vector<std::string> classLabels;
+	std::vector<int> realClusters =
+			TCGADataClusteringEvaluator::buildRealClusters(
+					data->getClassMapHandler(), data->getNumberOfSamples(),
+					&classLabels);
+	TCGADataClusteringEvaluator evaluator(clusters, realClusters,
+			distanceMatrix.get(),
+			DISTANCE_METRICS.find(metricName) == DISTANCE_METRICS.end());
+	ClusteringEvaluation evaluation = evaluator.evaluate();
+	output << evaluation.toTSVRow(method + "_" + metricName) << std::endl;
+	evaluator.printClusteringMatrix(classLabels, output);
+	std::vector<std::string> sampleLabels = data->getPatientLabels();
+	for (unsigned int i = 0; i < clusters.size(); ++i) {
+		output << sampleLabels[i] << "\t" << clusters[i] << std::endl;
+	}
+}
+
+void AnalyzerServer::classStats(const std::vector<std::string> &arguments,
+		std::ostream &output) {
+	if (arguments.size() > 1) {
+		throw std::invalid_argument("Usage : classstats [metric]");
+	}
+	std::shared_ptr<const Eigen::MatrixXd> distanceMatrix = getDistanceMatrix(
+			arguments.empty() ? "pearson" : arguments[0]);
+	TCGADataDistanceMatrixAnalyser::writeClassStats(*data, *distanceMatrix,
+			output);
+}
+
+void AnalyzerServer::nearest(const std::vector<std::string> &arguments,
+		std::ostream &output) {
+	if (arguments.empty() || arguments.size() > 3) {
+		throw std::invalid_argument(
+				"Usage : nearest <sample> [metric] [count]");
+	}
+	int sample = findSample(arguments[0]);
+	std::string metricName = arguments.size() > 1 ? arguments[1] : "pearson";
+	unsigned int count =
+			arguments.size() > 2 ? parseCount(arguments[2], "count") : 10;
+	std::shared_ptr<const Eigen::MatrixXd> distanceMatrix = getDistanceMatrix(
+			metricName);
+	bool isSimilarity = DISTANCE_METRICS.find(metricName)
+			== DISTANCE_METRICS.end();
+
+	std::vector<int> others;
+	for (int i = 0; i < (int) data->getNumberOfSamples(); ++i) {
+		if (i != sample) {
+			others.push_back(i);
+		}
+	}
+	count = std::min(count, (unsigned int) others.size());
+	std::partial_sort(others.begin(), others.begin() + count, others.end(),
+			[&](int i, int j) {
+				double a = (*distanceMatrix)(sample, i);
+				double b = (*distanceMatrix)(sample, j);
+				return isSimilarity ? a > b : a < b;
+			});
+	std::vector<std::string> sampleLabels = data->getPatientLabels();
+	for (unsigned int n = 0; n < count; ++n) {
+		output << sampleLabels[others[n]] << "\t"
+				<< (*distanceMatrix)(sample, others[n]) << std::endl;
+	}
+}
+
+void AnalyzerServer::neighbors(const std::vector<std::string> &arguments,
+		std::ostream &output) {
+	if (arguments.size() != 1) {
+		throw std::invalid_argument("Usage : neighbors <gene>");
+	}
+	if (!graph) {
+		throw std::invalid_argument("No graph loaded");
+	}
+	if (!graph->hasNode(arguments[0])) {
+		throw std::invalid_argument("Unknown gene '" + arguments[0] + "'");
+	}
+	PPIGraph::NodeIDType id = graph->getNodeId(arguments[0]);
+	for (auto it = graph->neighborsBegin(id); it != graph->neighborsEnd(id);
+			++it) {
+		output << graph->getNodeName(*it) << "\t" << graph->getOutDegree(*it)
+				<< std::endl;
+	}
+}
+
+void AnalyzerServer::info(std::ostream &output) {
+	output << "samples\t" << data->getNumberOfSamples() << std::endl;
+	output << "genes\t" << data->getNumberOfGenes() << std::endl;
+	for (const auto &kv : data->getClassMapHandler()) {
+		output << "class\t" << kv.first << "\t" << kv.second.size()
+				<< std::endl;
+	}
+	if (graph) {
+		output << "graph\t" << graph->size() << " nodes\t"
+				<< graph->edgeCount() << " edges" << std::endl;
+	}
+	std::lock_guard<std::mutex> lock(distanceMatricesMutex);
+	for (const auto &kv : distanceMatrices) {
+		output << "metric\t" << kv.first << std::endl;
+	}
+	output << "workers\t" << numberOfWorkers << std::endl;
+}
+
+void AnalyzerServer::run(const std::string &socketPath) {
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+		throw std::invalid_argument("Invalid socket path '" + socketPath + "'");
+	}
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listener < 0) {
+		throw std::runtime_error(
+				"Cannot create socket : " + std::string(std::strerror(errno)));
+	}
+	//A socket file nobody answers on is left over from a previous run
+	if (connect(listener, (sockaddr *) &address, sizeof(address)) == 0) {
+		close(listener);
+		throw std::runtime_error(
+				"A server is already listening on " + socketPath);
+	}
+	close(listener);
+	//Only a stale socket is removed, never a file the path points to by
+	//mistake
+	struct stat socketStat;
+	if (lstat(socketPath.c_str(), &socketStat) == 0) {
+		if (!S_ISSOCK(socketStat.st_mode)) {
+			throw std::runtime_error(
+					socketPath + " exists and is not a socket");
+		}
+		unlink(socketPath.c_str());
+	}
+	listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (listener < 0
+			|| bind(listener, (sockaddr *) &address, sizeof(address)) != 0
+			|| listen(listener, 64) != 0) {
+		std::string error = std::strerror(errno);
+		if (listener >= 0) {
+			close(listener);
+		}
+		throw std::runtime_error(
+				"Cannot listen on " + socketPath + " : " + error);
+	}
+
+	signalReceived = 0;
+	stopping = false;
+	if (pipe2(wakeupPipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+		close(listener);
+		throw std::runtime_error(
+				"Cannot create pipe : " + std::string(std::strerror(errno)));
+	}
+	auto previousInterruptHandler = std::signal(SIGINT, handleSignal);
+	auto previousTerminateHandler = std::signal(SIGTERM, handleSignal);
+
+	std::vector<std::thread> workers;
+	for (unsigned int t = 0; t < numberOfWorkers; ++t) {
+		workers.emplace_back(&AnalyzerServer::runWorker, this, t);
+	}
+	if (verbose) {
+		std::cout << "* Listening on " << socketPath << " with "
+				<< numberOfWorkers << " workers" << std::endl;
+	}
+
+	//Only this thread polls : a connection is either idle here, waiting for
+	//a worker or being served, never two of them at once
+	std::vector<Client> idleClients;
+	std::vector<pollfd> descriptors;
+	while (!stopping) {
+		if (signalReceived) {
+			break;
+		}
+		{
+			std::lock_guard<std::mutex> lock(connectionsMutex);
+			for (auto &client : returnedClients) {
+				idleClients.push_back(std::move(client));
+			}
+			returnedClients.clear();
+		}
+		descriptors.assign( { { listener, POLLIN, 0 }, { wakeupPipe[0], POLLIN,
+				0 } });
+		for (const auto &client : idleClients) {
+			descriptors.push_back( { client.connection, POLLIN, 0 });
+		}
+		if (poll(descriptors.data(), descriptors.size(), POLL_INTERVAL) <= 0) {
+			continue;
+		}
+		if (descriptors[1].revents) {
+			char drain[64];
+			while (read(wakeupPipe[0], drain, sizeof(drain)) > 0) {
+			}
+		}
+
+		std::vector<Client> stillIdle;
+		{
+			std::lock_guard<std::mutex> lock(connectionsMutex);
+			for (unsigned int i = 0; i < idleClients.size(); ++i) {
+				if (descriptors[i + 2].revents) {
+					readyClients.push_back(std::move(idleClients[i]));
+					connectionsCondition.notify_one();
+				} else {
+					stillIdle.push_back(std::move(idleClients[i]));
+				}
+			}
+		}
+		idleClients.swap(stillIdle);
+
+		if (descriptors[0].revents) {
+			int connection = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+			if (connection >= 0) {
+				idleClients.push_back( { connection, std::string() });
+			}
+		}
+	}
+
+	stop();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+	for (const auto &client : idleClients) {
+		close(client.connection);
+	}
+	for (const auto &client : readyClients) {
+		close(client.connection);
+	}
+	for (const auto &client : returnedClients) {
+		close(client.connection);
+	}
+	readyClients.clear();
+	returnedClients.clear();
+	close(wakeupPipe[0]);
+	close(wakeupPipe[1]);
+	wakeupPipe[0] = wakeupPipe[1] = -1;
+	close(listener);
+	unlink(socketPath.c_str());
+	std::signal(SIGINT, previousInterruptHandler);
+	std::signal(SIGTERM, previousTerminateHandler);
+	if (verbose) {
+		std::cout << "* Server stopped" << std::endl;
+	}
+}
+
+void AnalyzerServer::stop() {
+	{
+		//Under the lock, so that no worker misses the notification between
+		//its test of the flag and its wait
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		stopping = true;
+	}
+	connectionsCondition.notify_all();
+	wakeUp();
+}
+
+void AnalyzerServer::wakeUp() {
+	//Non-blocking : when the pipe is full, the accepting thread is woken up
+	//anyway
+	ssize_t written = write(wakeupPipe[1], "", 1);
+	(void) written;
+}
+
+void AnalyzerServer::runWorker(unsigned int worker) {
+	ThreadScope threads(worker, numberOfWorkers);
+	while (true) {
+		Client client;
+		{
+			std::unique_lock<std::mutex> lock(connectionsMutex);
+			connectionsCondition.wait(lock, [this]() {
+				return stopping || !readyClients.empty();
+			});
+			if (stopping) {
+				return;
+			}
+			client = std::move(readyClients.front());
+			readyClients.pop_front();
+		}
+		if (!serveClient(client)) {
+			close(client.connection);
+			continue;
+		}
+		{
+			std::lock_guard<std::mutex> lock(connectionsMutex);
+			returnedClients.push_back(std::move(client));
+		}
+		wakeUp();
+	}
+}
+
+bool AnalyzerServer::serveClient(Client &client) {
+	//The connection was reported readable : this does not block
+	char chunk[4096];
+	ssize_t n = recv(client.connection, chunk, sizeof(chunk), MSG_DONTWAIT);
+	if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK
+			&& errno != EINTR)) {
+		return false;
+	}
+	if (n > 0) {
+		client.buffer.append(chunk, n);
+	}
+
+	std::size_t endOfLine;
+	while (!stopping
+			&& (endOfLine = client.buffer.find('\n')) != std::string::npos) {
+		std::string request = client.buffer.substr(0, endOfLine);
+		client.buffer.erase(0, endOfLine + 1);
+		if (!request.empty() && request.back() == '\r') {
+			request.pop_back();
+		}
+		if (request == "quit") {
+			return false;
+		}
+		auto start = std::chrono::steady_clock::now();
+		std::string response = handleRequest(request);
+		if (verbose) {
+			std::lock_guard<std::mutex> lock(outputMutex);
+			std::cout << "* " << request << " : "
+					<< response.substr(0, response.find('\n')) << " in "
+					<< std::chrono::duration<double, std::milli>(
+							std::chrono::steady_clock::now() - start).count()
+					<< " ms" << std::endl;
+		}
+		if (!sendAll(client.connection, response + ".\n")) {
+			return false;
+		}
+	}
+	if (client.buffer.size() > MAX_REQUEST_LENGTH) {
+		sendAll(client.connection, "ERROR Request too long\n.\n");
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,94 @@
+/*
+ * analyzerServer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_SERVER_ANALYZERSERVER_HPP_
+#define SRC_SERVER_ANALYZERSERVER_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <Eigen/Dense>
+#include "../tcga-analyzer/TCGAData.hpp"
+#include "../tcga-analyzer/TCGADataClusterer.hpp"
+#include "../heinz-analyzer/graph.hpp"
+
+// Serves read-only queries on a loaded cohort over a Unix domain socket.
+// A request is one line of words, the response starts with "OK" or
+// "ERROR <message>" and ends with a line holding a single ".". The accepting
+// thread polls the idle connections and hands those with input to a pool of
+// worker threads, so that idle clients do not hold a worker. Distance
+// matrices are computed once per metric and kept.
+class AnalyzerServer {
+public:
+	//The data matrix of data should be built, samples ordered by class. The
+	//graph is optional.
+	AnalyzerServer(const std::shared_ptr<const TCGAData> &_data,
+			const std::shared_ptr<const PPIGraph> &_graph,
+			const ClusteringSettings &_settings,
+			unsigned int _numberOfWorkers = 0, bool _verbose = true);
+
+	//Computes the distance matrix of a metric ahead of the first request
+	void preload(const std::string &metricName);
+	//Until a "shutdown" request, SIGINT or SIGTERM
+	void run(const std::string &socketPath);
+	//Response to one request line, without the final "."
+	std::string handleRequest(const std::string &request);
+
+private:
+	std::shared_ptr<const TCGAData> data;
+	std::shared_ptr<const PPIGraph> graph;
+	ClusteringSettings settings;
+	unsigned int numberOfWorkers;
+	bool verbose;
+
+	std::mutex distanceMatricesMutex;
+	std::map<std::string, std::shared_future<std::shared_ptr<const Eigen::MatrixXd>>> distanceMatrices;
+
+	//A connection and what it sent beyond its last complete request
+	struct Client {
+		int connection;
+		std::string buffer;
+	};
+
+	std::mutex connectionsMutex;
+	std::condition_variable connectionsCondition;
+	//Connections with input, waiting for a worker
+	std::deque<Client> readyClients;
+	//Connections given back by the workers, to be polled again
+	std::vector<Client> returnedClients;
+	//Written by the workers to wake the accepting thread up
+	int wakeupPipe[2] = { -1, -1 };
+	std::atomic<bool> stopping;
+
+	std::shared_ptr<const Eigen::MatrixXd> getDistanceMatrix(
+			const std::string &metricName);
+	int findSample(const std::string &name) const;
+
+	void cluster(const std::vector<std::string> &arguments,
+			std::ostream &output);
+	void classStats(const std::vector<std::string> &arguments,
+			std::ostream &output);
+	void nearest(const std::vector<std::string> &arguments,
+			std::ostream &output);
+	void neighbors(const std::vector<std::string> &arguments,
+			std::ostream &output);
+	void info(std::ostream &output);
+
+	void stop();
+	void wakeUp();
+	void runWorker(unsigned int worker);
+	//Answers the complete requests received so far, false once the
+	//connection should be closed
+	bool serveClient(Client &client);
+};
+
+#endif /* SRC_SERVER_ANALYZERSERVER_HPP_ */
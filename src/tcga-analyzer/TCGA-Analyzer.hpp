@@ -10,7 +10,11 @@
 
 #include "../tcga-analyzer/TCGAData.hpp"
 #include "../tcga-analyzer/TCGADataClusterer.hpp"
+#include "../tcga-analyzer/TCGADataClusteringEvaluator.hpp"
+#include "../tcga-analyzer/TCGADataConsensusClusterer.hpp"
+#include "../tcga-analyzer/TCGADataDifferentialAnalyzer.hpp"
 #include "../tcga-analyzer/TCGADataDistanceMatrixAnalyzer.hpp"
+#include "../tcga-analyzer/distanceKernels.hpp"
 #include "../tcga-analyzer/TCGADataLoader.hpp"
 #include "../tcga-analyzer/TCGADataNormalizer.hpp"
 
@@ -12,6 +12,8 @@
 #include <set>
 #include "../utilities.hpp"
 #include "../config.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
 
 GeneList & TCGAData::getGeneListHandler() {
 	return geneList;
@@ -86,6 +88,8 @@ void TCGAData::setClinicalAttributes(const std::set<std::string> &attributes) {
 void TCGAData::buildDataMatrix(bool verbose) {
 
 	if (!dataMatrixIsComputed) {
+		ScopedTimer timer("data-matrix");
+		MemoryStage memoryStage("data-matrix");
 		unsigned int numberOfGenes = getNumberOfGenes();
 		unsigned int numberOfSamples = getNumberOfSamples();
 
@@ -95,6 +99,8 @@ void TCGAData::buildDataMatrix(bool verbose) {
 		}
 
 		dataMatrix.resize(numberOfGenes, numberOfSamples);
+		MemoryMonitor::track("dataMatrix",
+				estimateDataMatrixBytes(numberOfGenes, numberOfSamples));
 		classMap.clear();
 
 		//Deal with gene data
@@ -172,3 +178,101 @@ void TCGAData::reorderSamples() {
 	patients = std::move(newPatients);
 	buildDataMatrix();
 }
+
+namespace {
+
+const std::string TCGADATA_MAGIC = "TCGADATA1";
+
+}
+
+void TCGAData::save(std::ostream &output) const {
+	writeBinary(output, TCGADATA_MAGIC);
+	writeBinary(output, (unsigned int) geneList.size());
+	for (const auto &gene : geneList) {
+		writeBinary(output, gene.first);
+		writeBinary(output, gene.second);
+	}
+	writeBinary(output, (unsigned int) clinicalAttributes.size());
+	for (const auto &attribute : clinicalAttributes) {
+		writeBinary(output, attribute);
+	}
+	writeBinary(output, (unsigned int) patients.size());
+	for (const auto &patient : patients) {
+		TCGAPatientData copy = patient;
+		writeBinary(output, copy.getPatientName());
+		writeBinary(output, copy.getCancerName());
+		writeBinary(output, (char) copy.isTumor());
+		writeBinary(output,
+				(unsigned int) patient.getClinicalDataHandler().size());
+		for (const auto &kv : patient.getClinicalDataHandler()) {
+			writeBinary(output, kv.first);
+			writeBinary(output, kv.second);
+		}
+	}
+	for (const auto &geneData : data) {
+		output.write(reinterpret_cast<const char *>(geneData.data()),
+				geneData.size() * sizeof(double));
+	}
+}
+
+void TCGAData::load(std::istream &input) {
+	std::string magic;
+	readBinary(input, &magic);
+	if (!input || magic != TCGADATA_MAGIC) {
+		throw tcga_data_exception("Not a saved TCGAData");
+	}
+	unsigned int size = 0;
+	readBinary(input, &size);
+	geneList.resize(size);
+	for (auto &gene : geneList) {
+		readBinary(input, &gene.first);
+		readBinary(input, &gene.second);
+	}
+	readBinary(input, &size);
+	clinicalAttributes.clear();
+	for (unsigned int i = 0; i < size && input; ++i) {
+		std::string attribute;
+		readBinary(input, &attribute);
+		clinicalAttributes.insert(attribute);
+	}
+	readBinary(input, &size);
+	patients.clear();
+	for (unsigned int i = 0; i < size && input; ++i) {
+		std::string name, cancer;
+		char tumor = 0;
+		unsigned int numberOfClinicalData = 0;
+		readBinary(input, &name);
+		readBinary(input, &cancer);
+		readBinary(input, &tumor);
+		patients.push_back(TCGAPatientData(name, cancer, tumor));
+		readBinary(input, &numberOfClinicalData);
+		for (unsigned int j = 0; j < numberOfClinicalData && input; ++j) {
+			std::string key, value;
+			readBinary(input, &key);
+			readBinary(input, &value);
+			patients.back().setClinicalData(key, value);
+		}
+	}
+	data.assign(geneList.size(), std::vector<double>(patients.size()));
+	for (auto &geneData : data) {
+		input.read(reinterpret_cast<char *>(geneData.data()),
+				geneData.size() * sizeof(double));
+	}
+	if (!input) {
+		throw tcga_data_exception("Truncated saved TCGAData");
+	}
+	dataMatrixIsComputed = false;
+	classMap.clear();
+}
+
+unsigned long long TCGAData::estimateRNASeqDataBytes(unsigned int numberOfGenes,
+		unsigned int numberOfSamples) {
+	//One vector per gene, reserved to the number of samples by the loader
+	return (unsigned long long) numberOfGenes
+			* (sizeof(std::vector<double>) + numberOfSamples * sizeof(double));
+}
+
+unsigned long long TCGAData::estimateDataMatrixBytes(unsigned int numberOfGenes,
+		unsigned int numberOfSamples) {
+	return (unsigned long long) numberOfGenes * numberOfSamples * sizeof(double);
+}
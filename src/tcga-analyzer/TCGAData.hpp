@@ -43,6 +43,17 @@ public:
 
 	void reorderSamples();
 
+	//Binary form of the genes, patients and RNASeq data (the data matrix is
+	//rebuilt on demand)
+	void save(std::ostream &output) const;
+	void load(std::istream &input);
+
+	//Sizes of the containers above for a given data set, in bytes
+	static unsigned long long estimateRNASeqDataBytes(unsigned int numberOfGenes,
+			unsigned int numberOfSamples);
+	static unsigned long long estimateDataMatrixBytes(unsigned int numberOfGenes,
+			unsigned int numberOfSamples);
+
 private:
 	GeneList geneList;
 	std::vector<TCGAPatientData> patients;
@@ -1,8 +1,11 @@
 #include "TCGADataClusterer.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
 
 TCGADataClusterer::TCGADataClusterer(TCGAData *_ptrToData, unsigned int _K,
 		bool _verbose) :
-		ptrToData(_ptrToData), K(_K), verbose(_verbose) {
+		ptrToData(_ptrToData), K(_K), verbose(_verbose), ptrToDistanceMatrix(
+				nullptr) {
 	realClusters.resize(ptrToData->getNumberOfSamples());
 	buildRealClasses();
 	ptrToData->buildDataMatrix();
@@ -16,17 +19,14 @@ TCGADataClusterer::~TCGADataClusterer() {
 }
 
 void TCGADataClusterer::buildRealClasses(){
-	int currentCluster = 0;
-	for(const auto &kv : ptrToData->getClassMapHandler()){
-		realLabels.push_back( kv.first);
-		for(auto i : kv.second){
-			realClusters[i] = currentCluster;
-		}
-		++currentCluster;
-	}
+	realClusters = TCGADataClusteringEvaluator::buildRealClusters(
+			ptrToData->getClassMapHandler(), ptrToData->getNumberOfSamples(),
+			&realLabels);
 }
 
 void TCGADataClusterer::computeClustering() {
+	ScopedTimer timer("clustering");
+	MemoryStage memoryStage("clustering");
 	clusterer->compute();
 }
 
@@ -34,6 +34,15 @@ std::vector<int> TCGADataClusterer::getClusters() {
 	return clusterer->getClusters();
 }
 
+ClusteringEvaluation TCGADataClusterer::evaluate(
+		const Eigen::MatrixXd *distanceMatrix, bool isSimilarity) {
+	ScopedTimer timer("clustering/evaluation");
+	std::vector<int> clusters = getClusters();
+	TCGADataClusteringEvaluator evaluator(clusters, realClusters,
+			distanceMatrix, isSimilarity);
+	return evaluator.evaluate();
+}
+
 void TCGADataClusterer::printClusteringInfo() {
 	clusterer->printClusteringMatrix(realLabels, realClusters);
 	std::cout << std::endl << "Adjusted Rand Index : " << clusterer->computeAdjustedRandIndex(realClusters) << std::endl;
@@ -41,19 +50,29 @@ void TCGADataClusterer::printClusteringInfo() {
 
 TCGADataKMeansClusterer::TCGADataKMeansClusterer(TCGAData *_ptrToData,
 		unsigned int _K, unsigned int _maxIterations, unsigned int _parallel_KMeans, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+		TCGADataClusterer(_ptrToData, _K, _verbose), maxIterations(
+				_maxIterations), parallelKMeans(_parallel_KMeans) {
 	clustererParameters = std::make_shared<ClusterXX::KMeansParameters>(K,
 			_maxIterations, _parallel_KMeans, _verbose);
 	clusterer = std::make_shared<ClusterXX::KMeans_Clusterer>(
 			ptrToData->getDataMatrixHandler(), clustererParameters);
 }
 
+std::shared_ptr<ClusterXX::Clusterer> TCGADataKMeansClusterer::buildClusterer(
+		const Eigen::MatrixXd &matrix, unsigned int _K) const {
+	std::shared_ptr<ClusterXX::ClustererParameters> parameters =
+			std::make_shared<ClusterXX::KMeansParameters>(_K, maxIterations,
+					parallelKMeans, false);
+	return std::make_shared<ClusterXX::KMeans_Clusterer>(matrix, parameters);
+}
+
 TCGADataHierarchicalClusterer::TCGADataHierarchicalClusterer(
 		TCGAData *_ptrToData, const std::shared_ptr<ClusterXX::Metric> &_metric,
 		unsigned int _K,
-		ClusterXX::HierarchicalParameters::LinkageMethod linkageMethod,
+		ClusterXX::HierarchicalParameters::LinkageMethod _linkageMethod,
 		bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, verbose) {
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), linkageMethod(
+				_linkageMethod) {
 	clustererParameters = std::make_shared<ClusterXX::HierarchicalParameters>(K,
 			_metric, linkageMethod, _verbose);
 	clusterer = std::make_shared<ClusterXX::Hierarchical_Clusterer>(
@@ -63,22 +82,36 @@ TCGADataHierarchicalClusterer::TCGADataHierarchicalClusterer(
 TCGADataHierarchicalClusterer::TCGADataHierarchicalClusterer(
 		TCGAData *_ptrToData, const Eigen::MatrixXd &_distanceMatrix,
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
-		ClusterXX::HierarchicalParameters::LinkageMethod linkageMethod,
+		ClusterXX::HierarchicalParameters::LinkageMethod _linkageMethod,
 		bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, verbose) {
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), linkageMethod(
+				_linkageMethod) {
 	clustererParameters = std::make_shared<ClusterXX::HierarchicalParameters>(K,
 			_metric, linkageMethod, _verbose);
 	clusterer = std::make_shared<ClusterXX::Hierarchical_Clusterer>(
 			_distanceMatrix, clustererParameters, true);
+	ptrToDistanceMatrix = &_distanceMatrix;
+}
 
+std::shared_ptr<ClusterXX::Clusterer> TCGADataHierarchicalClusterer::buildClusterer(
+		const Eigen::MatrixXd &matrix, unsigned int _K) const {
+	std::shared_ptr<ClusterXX::ClustererParameters> parameters =
+			std::make_shared<ClusterXX::HierarchicalParameters>(_K, metric,
+					linkageMethod, false);
+	if (usesDistanceMatrix()) {
+		return std::make_shared<ClusterXX::Hierarchical_Clusterer>(matrix, parameters,
+				true);
+	}
+	return std::make_shared<ClusterXX::Hierarchical_Clusterer>(matrix, parameters);
 }
 
 TCGADataUnnormalizedSpectralClusterer::TCGADataUnnormalizedSpectralClusterer(TCGAData *_ptrToData,
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 		std::pair<
 				ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
-				double> transformationParameters, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+				double> _transformationParameters, bool _verbose) :
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), transformationParameters(
+				_transformationParameters) {
 	clustererParameters = std::make_shared<ClusterXX::SpectralParameters>(K,
 			_metric,
 			ClusterXX::SpectralParameters::GraphTransformationMethod(
@@ -93,8 +126,9 @@ TCGADataUnnormalizedSpectralClusterer::TCGADataUnnormalizedSpectralClusterer(TCG
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 		std::pair<
 				ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
-				double> transformationParameters, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+				double> _transformationParameters, bool _verbose) :
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), transformationParameters(
+				_transformationParameters) {
 	clustererParameters = std::make_shared<ClusterXX::SpectralParameters>(K,
 			_metric,
 			ClusterXX::SpectralParameters::GraphTransformationMethod(
@@ -102,14 +136,30 @@ TCGADataUnnormalizedSpectralClusterer::TCGADataUnnormalizedSpectralClusterer(TCG
 					transformationParameters.second), _verbose);
 	clusterer = std::make_shared<ClusterXX::UnnormalizedSpectralClustering>(_distanceMatrix,
 			clustererParameters, true);
+	ptrToDistanceMatrix = &_distanceMatrix;
+}
+
+std::shared_ptr<ClusterXX::Clusterer> TCGADataUnnormalizedSpectralClusterer::buildClusterer(
+		const Eigen::MatrixXd &matrix, unsigned int _K) const {
+	std::shared_ptr<ClusterXX::ClustererParameters> parameters =
+			std::make_shared<ClusterXX::SpectralParameters>(_K, metric,
+					ClusterXX::SpectralParameters::GraphTransformationMethod(
+							transformationParameters.first,
+							transformationParameters.second), false);
+	if (usesDistanceMatrix()) {
+		return std::make_shared<ClusterXX::UnnormalizedSpectralClustering>(matrix, parameters,
+				true);
+	}
+	return std::make_shared<ClusterXX::UnnormalizedSpectralClustering>(matrix, parameters);
 }
 
 TCGADataNormalizedSpectralClusterer::TCGADataNormalizedSpectralClusterer(TCGAData *_ptrToData,
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 		std::pair<
 				ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
-				double> transformationParameters, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+				double> _transformationParameters, bool _verbose) :
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), transformationParameters(
+				_transformationParameters) {
 	clustererParameters = std::make_shared<ClusterXX::SpectralParameters>(K,
 			_metric,
 			ClusterXX::SpectralParameters::GraphTransformationMethod(
@@ -124,8 +174,9 @@ TCGADataNormalizedSpectralClusterer::TCGADataNormalizedSpectralClusterer(TCGADat
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 		std::pair<
 				ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
-				double> transformationParameters, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+				double> _transformationParameters, bool _verbose) :
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), transformationParameters(
+				_transformationParameters) {
 	clustererParameters = std::make_shared<ClusterXX::SpectralParameters>(K,
 			_metric,
 			ClusterXX::SpectralParameters::GraphTransformationMethod(
@@ -133,14 +184,30 @@ TCGADataNormalizedSpectralClusterer::TCGADataNormalizedSpectralClusterer(TCGADat
 					transformationParameters.second), _verbose);
 	clusterer = std::make_shared<ClusterXX::NormalizedSpectralClustering>(_distanceMatrix,
 			clustererParameters, true);
+	ptrToDistanceMatrix = &_distanceMatrix;
+}
+
+std::shared_ptr<ClusterXX::Clusterer> TCGADataNormalizedSpectralClusterer::buildClusterer(
+		const Eigen::MatrixXd &matrix, unsigned int _K) const {
+	std::shared_ptr<ClusterXX::ClustererParameters> parameters =
+			std::make_shared<ClusterXX::SpectralParameters>(_K, metric,
+					ClusterXX::SpectralParameters::GraphTransformationMethod(
+							transformationParameters.first,
+							transformationParameters.second), false);
+	if (usesDistanceMatrix()) {
+		return std::make_shared<ClusterXX::NormalizedSpectralClustering>(matrix, parameters,
+				true);
+	}
+	return std::make_shared<ClusterXX::NormalizedSpectralClustering>(matrix, parameters);
 }
 
 TCGADataNormalizedSpectralClusterer_RandomWalk::TCGADataNormalizedSpectralClusterer_RandomWalk(TCGAData *_ptrToData,
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 		std::pair<
 				ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
-				double> transformationParameters, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+				double> _transformationParameters, bool _verbose) :
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), transformationParameters(
+				_transformationParameters) {
 	clustererParameters = std::make_shared<ClusterXX::SpectralParameters>(K,
 			_metric,
 			ClusterXX::SpectralParameters::GraphTransformationMethod(
@@ -155,8 +222,9 @@ TCGADataNormalizedSpectralClusterer_RandomWalk::TCGADataNormalizedSpectralCluste
 		const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 		std::pair<
 				ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
-				double> transformationParameters, bool _verbose) :
-		TCGADataClusterer(_ptrToData, _K, _verbose) {
+				double> _transformationParameters, bool _verbose) :
+		TCGADataClusterer(_ptrToData, _K, _verbose), metric(_metric), transformationParameters(
+				_transformationParameters) {
 	clustererParameters = std::make_shared<ClusterXX::SpectralParameters>(K,
 			_metric,
 			ClusterXX::SpectralParameters::GraphTransformationMethod(
@@ -164,4 +232,51 @@ TCGADataNormalizedSpectralClusterer_RandomWalk::TCGADataNormalizedSpectralCluste
 					transformationParameters.second), _verbose);
 	clusterer = std::make_shared<ClusterXX::NormalizedSpectralClustering_RandomWalk>(_distanceMatrix,
 			clustererParameters, true);
+	ptrToDistanceMatrix = &_distanceMatrix;
+}
+
+std::shared_ptr<ClusterXX::Clusterer> TCGADataNormalizedSpectralClusterer_RandomWalk::buildClusterer(
+		const Eigen::MatrixXd &matrix, unsigned int _K) const {
+	std::shared_ptr<ClusterXX::ClustererParameters> parameters =
+			std::make_shared<ClusterXX::SpectralParameters>(_K, metric,
+					ClusterXX::SpectralParameters::GraphTransformationMethod(
+							transformationParameters.first,
+							transformationParameters.second), false);
+	if (usesDistanceMatrix()) {
+		return std::make_shared<ClusterXX::NormalizedSpectralClustering_RandomWalk>(matrix, parameters,
+				true);
+	}
+	return std::make_shared<ClusterXX::NormalizedSpectralClustering_RandomWalk>(matrix, parameters);
+}
+
+std::unique_ptr<TCGADataClusterer> buildTCGADataClusterer(
+		const std::string &method, TCGAData *ptrToData,
+		const Eigen::MatrixXd &distanceMatrix,
+		const std::shared_ptr<ClusterXX::Metric> &metric, unsigned int K,
+		const ClusteringSettings &settings, bool verbose) {
+	std::unique_ptr<TCGADataClusterer> clusterer;
+	if (method == "kmeans") {
+		clusterer.reset(
+				new TCGADataKMeansClusterer(ptrToData, K,
+						settings.kMeansMaxIterations, settings.parallelKMeans,
+						verbose));
+	} else if (method == "hierarchical") {
+		clusterer.reset(
+				new TCGADataHierarchicalClusterer(ptrToData, distanceMatrix,
+						metric, K, settings.linkageMethod, verbose));
+	} else if (method == "unnormalized-spectral") {
+		clusterer.reset(
+				new TCGADataUnnormalizedSpectralClusterer(ptrToData,
+						distanceMatrix, metric, K, settings.graphTransformation,
+						verbose));
+	} else if (method == "normalized-spectral") {
+		clusterer.reset(
+				new TCGADataNormalizedSpectralClusterer(ptrToData,
+						distanceMatrix, metric, K, settings.graphTransformation,
+						verbose));
+	} else {
+		throw std::invalid_argument(
+				"Unknown clustering method '" + method + "'");
+	}
+	return clusterer;
 }
@@ -7,11 +7,25 @@
 #include <ClusterXX/clustering/algorithms.hpp>
 
 #include "../tcga-analyzer/TCGAData.hpp"
+#include "../tcga-analyzer/TCGADataClusteringEvaluator.hpp"
 
 enum ClusteringMethod {
 	KMEANS_CLUSTERING, SPECTRAL_CLUSTERING, HIERARCHICAL_CLUSTERING
 };
 
+//Parameters of the clusterers other than the number of clusters
+struct ClusteringSettings {
+	unsigned int kMeansMaxIterations = 1000;
+	unsigned int parallelKMeans = 100;
+	ClusterXX::HierarchicalParameters::LinkageMethod linkageMethod =
+			ClusterXX::HierarchicalParameters::COMPLETE;
+	std::pair<
+			ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
+			double> graphTransformation = {
+			ClusterXX::SpectralParameters::GraphTransformationMethod::K_NEAREST_NEIGHBORS,
+			3 };
+};
+
 class TCGADataClusterer {
 public:
 	TCGADataClusterer(TCGAData *_ptrToData, unsigned int _K, bool _verbose);
@@ -25,10 +39,25 @@ public:
 	double getAdjustedRandIndex() {
 		return clusterer->computeAdjustedRandIndex(realClusters);
 	}
+	ClusteringEvaluation evaluate(const Eigen::MatrixXd *distanceMatrix =
+			nullptr, bool isSimilarity = false);
+	//Builds a clusterer of the same kind on another matrix (used for resampling)
+	virtual std::shared_ptr<ClusterXX::Clusterer> buildClusterer(
+			const Eigen::MatrixXd &matrix, unsigned int _K) const = 0;
+	bool usesDistanceMatrix() const {
+		return ptrToDistanceMatrix != nullptr;
+	}
+	const Eigen::MatrixXd *getDistanceMatrix() const {
+		return ptrToDistanceMatrix;
+	}
+	virtual std::shared_ptr<ClusterXX::Metric> getMetric() const {
+		return nullptr;
+	}
 protected:
 	TCGAData *ptrToData;
 	unsigned int K;
 	bool verbose;
+	const Eigen::MatrixXd *ptrToDistanceMatrix;
 	std::vector<std::string> realLabels;
 	std::vector<int> realClusters;
 	std::shared_ptr<ClusterXX::ClustererParameters> clustererParameters; //To be initialized in children class
@@ -42,6 +71,11 @@ public:
 	TCGADataKMeansClusterer(TCGAData *_ptrToData, unsigned int _K,
 			unsigned int _maxIteration, unsigned int _parallel_KMeans,
 			bool verbose);
+	std::shared_ptr<ClusterXX::Clusterer> buildClusterer(
+			const Eigen::MatrixXd &matrix, unsigned int _K) const;
+private:
+	unsigned int maxIterations;
+	unsigned int parallelKMeans;
 };
 
 class TCGADataHierarchicalClusterer: public TCGADataClusterer {
@@ -55,6 +89,14 @@ public:
 			const std::shared_ptr<ClusterXX::Metric> &_metric, unsigned int _K,
 			ClusterXX::HierarchicalParameters::LinkageMethod linkageMethod,
 			bool verbose);
+	std::shared_ptr<ClusterXX::Clusterer> buildClusterer(
+			const Eigen::MatrixXd &matrix, unsigned int _K) const;
+	std::shared_ptr<ClusterXX::Metric> getMetric() const {
+		return metric;
+	}
+private:
+	std::shared_ptr<ClusterXX::Metric> metric;
+	ClusterXX::HierarchicalParameters::LinkageMethod linkageMethod;
 };
 
 class TCGADataUnnormalizedSpectralClusterer: public TCGADataClusterer {
@@ -70,6 +112,16 @@ public:
 			std::pair<
 					ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
 					double> transformationParameters, bool _verbose);
+	std::shared_ptr<ClusterXX::Clusterer> buildClusterer(
+			const Eigen::MatrixXd &matrix, unsigned int _K) const;
+	std::shared_ptr<ClusterXX::Metric> getMetric() const {
+		return metric;
+	}
+private:
+	std::shared_ptr<ClusterXX::Metric> metric;
+	std::pair<
+			ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
+			double> transformationParameters;
 };
 
 class TCGADataNormalizedSpectralClusterer: public TCGADataClusterer {
@@ -85,6 +137,16 @@ public:
 			std::pair<
 					ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
 					double> transformationParameters, bool _verbose);
+	std::shared_ptr<ClusterXX::Clusterer> buildClusterer(
+			const Eigen::MatrixXd &matrix, unsigned int _K) const;
+	std::shared_ptr<ClusterXX::Metric> getMetric() const {
+		return metric;
+	}
+private:
+	std::shared_ptr<ClusterXX::Metric> metric;
+	std::pair<
+			ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
+			double> transformationParameters;
 };
 
 class TCGADataNormalizedSpectralClusterer_RandomWalk: public TCGADataClusterer {
@@ -100,6 +162,24 @@ public:
 			std::pair<
 					ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
 					double> transformationParameters, bool _verbose);
+	std::shared_ptr<ClusterXX::Clusterer> buildClusterer(
+			const Eigen::MatrixXd &matrix, unsigned int _K) const;
+	std::shared_ptr<ClusterXX::Metric> getMetric() const {
+		return metric;
+	}
+private:
+	std::shared_ptr<ClusterXX::Metric> metric;
+	std::pair<
+			ClusterXX::SpectralParameters::GraphTransformationMethod::GraphTransformationMethodName,
+			double> transformationParameters;
 };
 
+//method is kmeans, hierarchical, unnormalized-spectral or normalized-spectral
+//(std::invalid_argument otherwise) ; kmeans does not use the distance matrix
+std::unique_ptr<TCGADataClusterer> buildTCGADataClusterer(
+		const std::string &method, TCGAData *ptrToData,
+		const Eigen::MatrixXd &distanceMatrix,
+		const std::shared_ptr<ClusterXX::Metric> &metric, unsigned int K,
+		const ClusteringSettings &settings, bool verbose = false);
+
 #endif /* SRC_TCGADATACLUSTERER_HPP_ */
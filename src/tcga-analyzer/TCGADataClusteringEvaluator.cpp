@@ -0,0 +1,295 @@
+/*
+ * TCGADataClusteringEvaluator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "../tcga-analyzer/TCGADataClusteringEvaluator.hpp"
+
+#include <map>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include "../config.hpp"
+#include "../utilities.hpp"
+#include "../exportWriter.hpp"
+#include "../trace.hpp"
+#include "../tcga-analyzer/typedefs.hpp"
+
+namespace {
+
+//Maps arbitrary labels to 0..n-1
+std::vector<int> denseLabels(const std::vector<int> &labels,
+		unsigned int *numberOfLabels) {
+	std::map<int, int> mapping;
+	for (int label : labels) {
+		mapping.insert( { label, 0 });
+	}
+	int count = 0;
+	for (auto &kv : mapping) {
+		kv.second = count++;
+	}
+	std::vector<int> result(labels.size());
+	for (unsigned int i = 0; i < labels.size(); ++i) {
+		result[i] = mapping[labels[i]];
+	}
+	*numberOfLabels = mapping.size();
+	return result;
+}
+
+double choose2(double n) {
+	return n * (n - 1) / 2.0;
+}
+
+double entropy(const std::vector<double> &counts, double total) {
+	double h = 0.0;
+	for (double c : counts) {
+		if (c > 0) {
+			double p = c / total;
+			h -= p * std::log(p);
+		}
+	}
+	return h;
+}
+
+}
+
+std::string ClusteringEvaluation::toTSVHeader() {
+	return "LABEL\tSAMPLES\tCLUSTERS\tCLASSES\tARI\tNMI\tHOMOGENEITY\tCOMPLETENESS\tV_MEASURE\tPURITY\tSILHOUETTE";
+}
+
+std::string ClusteringEvaluation::toTSVRow(const std::string &label) const {
+	std::ostringstream ss;
+	ss << label << "\t" << numberOfSamples << "\t" << numberOfClusters << "\t"
+			<< numberOfClasses << "\t" << adjustedRandIndex << "\t"
+			<< normalizedMutualInformation << "\t" << homogeneity << "\t"
+			<< completeness << "\t" << vMeasure << "\t" << purity << "\t";
+	if (hasSilhouette) {
+		ss << silhouette;
+	} else {
+		ss << "NA";
+	}
+	return ss.str();
+}
+
+std::string ClusteringEvaluation::toJSON(const std::string &label) const {
+	std::ostringstream ss;
+	ss << "{\"label\": \"" << escapeJSON(label) << "\", \"samples\": " << numberOfSamples
+			<< ", \"clusters\": " << numberOfClusters << ", \"classes\": "
+			<< numberOfClasses << ", \"ari\": " << adjustedRandIndex
+			<< ", \"nmi\": " << normalizedMutualInformation
+			<< ", \"homogeneity\": " << homogeneity << ", \"completeness\": "
+			<< completeness << ", \"v_measure\": " << vMeasure
+			<< ", \"purity\": " << purity << ", \"silhouette\": ";
+	if (hasSilhouette) {
+		ss << silhouette;
+	} else {
+		ss << "null";
+	}
+	ss << "}";
+	return ss.str();
+}
+
+TCGADataClusteringEvaluator::TCGADataClusteringEvaluator(
+		const std::vector<int> &_clusters,
+		const std::vector<int> &_realClusters,
+		const Eigen::MatrixXd *_ptrToDistanceMatrix, bool _isSimilarity) :
+		clusters(_clusters), realClusters(_realClusters), ptrToDistanceMatrix(
+				_ptrToDistanceMatrix), isSimilarity(_isSimilarity) {
+	if (clusters.size() != realClusters.size()) {
+		throw tcga_data_exception(
+				"Cannot evaluate a clustering : predicted and real clusters have different sizes.");
+	}
+}
+
+ClusteringEvaluation TCGADataClusteringEvaluator::evaluate() const {
+	ClusteringEvaluation evaluation;
+	unsigned int N = clusters.size();
+	evaluation.numberOfSamples = N;
+	if (N == 0) {
+		return evaluation;
+	}
+
+	unsigned int K;
+	unsigned int C;
+	std::vector<int> predicted = denseLabels(clusters, &K);
+	std::vector<int> real = denseLabels(realClusters, &C);
+	evaluation.numberOfClusters = K;
+	evaluation.numberOfClasses = C;
+
+	//Contingency table : cluster x class
+	std::vector<double> contingency(K * C, 0.0);
+	std::vector<double> clusterSizes(K, 0.0);
+	std::vector<double> classSizes(C, 0.0);
+	for (unsigned int i = 0; i < N; ++i) {
+		++contingency[predicted[i] * C + real[i]];
+		++clusterSizes[predicted[i]];
+		++classSizes[real[i]];
+	}
+
+	double n = N;
+	double sumPairs = 0.0;
+	double mutualInformation = 0.0;
+	double correctlyAssigned = 0.0;
+	for (unsigned int k = 0; k < K; ++k) {
+		double best = 0.0;
+		for (unsigned int c = 0; c < C; ++c) {
+			double nkc = contingency[k * C + c];
+			sumPairs += choose2(nkc);
+			if (nkc > 0) {
+				mutualInformation += (nkc / n)
+						* std::log(n * nkc / (clusterSizes[k] * classSizes[c]));
+			}
+			best = std::max(best, nkc);
+		}
+		correctlyAssigned += best;
+	}
+
+	double sumClusterPairs = 0.0;
+	for (double s : clusterSizes) {
+		sumClusterPairs += choose2(s);
+	}
+	double sumClassPairs = 0.0;
+	for (double s : classSizes) {
+		sumClassPairs += choose2(s);
+	}
+	double expectedIndex = sumClusterPairs * sumClassPairs / choose2(n);
+	double maxIndex = (sumClusterPairs + sumClassPairs) / 2.0;
+	evaluation.adjustedRandIndex =
+			(maxIndex == expectedIndex) ?
+					1.0 : (sumPairs - expectedIndex) / (maxIndex - expectedIndex);
+
+	double clusterEntropy = entropy(clusterSizes, n);
+	double classEntropy = entropy(classSizes, n);
+	evaluation.homogeneity =
+			(classEntropy > 0) ? mutualInformation / classEntropy : 1.0;
+	evaluation.completeness =
+			(clusterEntropy > 0) ? mutualInformation / clusterEntropy : 1.0;
+	double h = evaluation.homogeneity;
+	double c = evaluation.completeness;
+	evaluation.vMeasure = (h + c > 0) ? 2 * h * c / (h + c) : 0.0;
+	if (classEntropy > 0 && clusterEntropy > 0) {
+		evaluation.normalizedMutualInformation = mutualInformation
+				/ std::sqrt(classEntropy * clusterEntropy);
+	} else {
+		evaluation.normalizedMutualInformation =
+				(classEntropy == clusterEntropy) ? 1.0 : 0.0;
+	}
+	evaluation.purity = correctlyAssigned / n;
+
+	if (ptrToDistanceMatrix != nullptr && K > 1) {
+		evaluation.hasSilhouette = true;
+		evaluation.silhouette = computeSilhouette();
+	}
+
+	return evaluation;
+}
+
+void TCGADataClusteringEvaluator::printClusteringMatrix(
+		const std::vector<std::string> &classLabels,
+		std::ostream &output) const {
+	unsigned int numberOfClusters = 0;
+	std::vector<int> dense = denseLabels(clusters, &numberOfClusters);
+	std::vector<std::vector<unsigned int>> counts(classLabels.size(),
+			std::vector<unsigned int>(numberOfClusters, 0));
+	for (unsigned int i = 0; i < clusters.size(); ++i) {
+		++counts[realClusters[i]][dense[i]];
+	}
+	std::size_t width = 0;
+	for (const auto &label : classLabels) {
+		width = std::max(width, label.size());
+	}
+	output << std::string(width, ' ');
+	for (unsigned int k = 0; k < numberOfClusters; ++k) {
+		output << "\t" << k;
+	}
+	output << std::endl;
+	for (unsigned int c = 0; c < classLabels.size(); ++c) {
+		output << classLabels[c]
+				<< std::string(width - classLabels[c].size(), ' ');
+		for (unsigned int k = 0; k < numberOfClusters; ++k) {
+			output << "\t" << counts[c][k];
+		}
+		output << std::endl;
+	}
+}
+
+std::vector<int> TCGADataClusteringEvaluator::buildRealClusters(
+		const ClassMap &classMap, unsigned int numberOfSamples,
+		std::vector<std::string> *classLabels) {
+	std::vector<int> realClusters(numberOfSamples);
+	int currentCluster = 0;
+	for (const auto &kv : classMap) {
+		if (classLabels) {
+			classLabels->push_back(kv.first);
+		}
+		for (int i : kv.second) {
+			realClusters[i] = currentCluster;
+		}
+		++currentCluster;
+	}
+	return realClusters;
+}
+
+double TCGADataClusteringEvaluator::computeSilhouette() const {
+	unsigned int N = clusters.size();
+	unsigned int K;
+	std::vector<int> predicted = denseLabels(clusters, &K);
+	std::vector<double> clusterSizes(K, 0.0);
+	for (int k : predicted) {
+		++clusterSizes[k];
+	}
+
+	const Eigen::MatrixXd &distanceMatrix = *ptrToDistanceMatrix;
+	double total = 0.0;
+
+#pragma omp parallel
+	{
+		std::vector<double> sums(K);
+#pragma omp for schedule(dynamic, 16) reduction(+:total)
+		for (unsigned int i = 0; i < N; ++i) {
+			std::fill(sums.begin(), sums.end(), 0.0);
+			for (unsigned int j = 0; j < N; ++j) {
+				if (j != i) {
+					double d = distanceMatrix(j, i);
+					sums[predicted[j]] += isSimilarity ? 1.0 - d : d;
+				}
+			}
+			int own = predicted[i];
+			if (clusterSizes[own] > 1) {
+				double a = sums[own] / (clusterSizes[own] - 1);
+				double b = std::numeric_limits<double>::max();
+				for (unsigned int k = 0; k < K; ++k) {
+					if ((int) k != own) {
+						b = std::min(b, sums[k] / clusterSizes[k]);
+					}
+				}
+				double m = std::max(a, b);
+				if (m > 0) {
+					total += (b - a) / m;
+				}
+			}
+		}
+	}
+
+	return total / N;
+}
+
+void TCGADataClusteringEvaluator::exportEvaluation(
+		const ClusteringEvaluation &evaluation, const std::string &label,
+		const std::string &filename) {
+	ScopedTimer timer("export/evaluation");
+	std::string tsvFilename = EXPORT_DIRECTORY + filename + ".tsv";
+	bool writeHeader = !ExportWriter::exists(tsvFilename);
+	ExportStream tsvOutputStream(tsvFilename, true);
+	if (writeHeader) {
+		tsvOutputStream << ClusteringEvaluation::toTSVHeader() << std::endl;
+	}
+	tsvOutputStream << evaluation.toTSVRow(label) << std::endl;
+
+	ExportStream jsonOutputStream(EXPORT_DIRECTORY + filename + ".jsonl",
+			true);
+	jsonOutputStream << evaluation.toJSON(label) << std::endl;
+}
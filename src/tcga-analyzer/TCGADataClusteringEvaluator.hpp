@@ -0,0 +1,65 @@
+/*
+ * TCGADataClusteringEvaluator.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_TCGA_ANALYZER_TCGADATACLUSTERINGEVALUATOR_HPP_
+#define SRC_TCGA_ANALYZER_TCGADATACLUSTERINGEVALUATOR_HPP_
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <Eigen/Dense>
+#include "../tcga-analyzer/typedefs.hpp"
+
+struct ClusteringEvaluation {
+	unsigned int numberOfSamples = 0;
+	unsigned int numberOfClusters = 0;
+	unsigned int numberOfClasses = 0;
+	double adjustedRandIndex = 0.0;
+	double normalizedMutualInformation = 0.0;
+	double homogeneity = 0.0;
+	double completeness = 0.0;
+	double vMeasure = 0.0;
+	double purity = 0.0;
+	//Only computed when a distance matrix is given
+	bool hasSilhouette = false;
+	double silhouette = 0.0;
+
+	static std::string toTSVHeader();
+	std::string toTSVRow(const std::string &label) const;
+	std::string toJSON(const std::string &label) const;
+};
+
+class TCGADataClusteringEvaluator {
+public:
+	//The distance matrix is optional ; similarities are turned into 1 - s
+	TCGADataClusteringEvaluator(const std::vector<int> &_clusters,
+			const std::vector<int> &_realClusters,
+			const Eigen::MatrixXd *_ptrToDistanceMatrix = nullptr,
+			bool _isSimilarity = false);
+	ClusteringEvaluation evaluate() const;
+	//Number of samples of each real class (rows) in each cluster (columns)
+	void printClusteringMatrix(const std::vector<std::string> &classLabels,
+			std::ostream &output = std::cout) const;
+
+	//Class of each sample, numbered in the order of the class map
+	static std::vector<int> buildRealClusters(const ClassMap &classMap,
+			unsigned int numberOfSamples,
+			std::vector<std::string> *classLabels = nullptr);
+
+	//Appends one line to EXPORT_DIRECTORY + filename (.tsv and .jsonl)
+	static void exportEvaluation(const ClusteringEvaluation &evaluation,
+			const std::string &label,
+			const std::string &filename = "clustering-evaluation");
+private:
+	std::vector<int> clusters;
+	std::vector<int> realClusters;
+	const Eigen::MatrixXd *ptrToDistanceMatrix;
+	bool isSimilarity;
+
+	double computeSilhouette() const;
+};
+
+#endif /* SRC_TCGA_ANALYZER_TCGADATACLUSTERINGEVALUATOR_HPP_ */
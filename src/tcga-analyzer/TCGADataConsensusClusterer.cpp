@@ -0,0 +1,325 @@
+/*
+ * TCGADataConsensusClusterer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "../tcga-analyzer/TCGADataConsensusClusterer.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <numeric>
+#include <map>
+#include "../config.hpp"
+#include "../utilities.hpp"
+#include "../exportWriter.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
+
+TCGADataView::TCGADataView(const TCGAData *_ptrToData,
+		const std::vector<int> &_samples, const std::vector<int> &_genes) :
+		ptrToData(_ptrToData), samples(_samples), genes(_genes) {
+}
+
+unsigned int TCGADataView::getNumberOfSamples() const {
+	return samples.size();
+}
+
+unsigned int TCGADataView::getNumberOfGenes() const {
+	return genes.size();
+}
+
+const std::vector<int> &TCGADataView::getSamples() const {
+	return samples;
+}
+
+const std::vector<int> &TCGADataView::getGenes() const {
+	return genes;
+}
+
+void TCGADataView::fillDataMatrix(Eigen::MatrixXd *matrix) const {
+	const Eigen::MatrixXd &dataMatrix = ptrToData->getDataMatrixHandler();
+	matrix->resize(genes.size(), samples.size());
+	for (unsigned int j = 0; j < samples.size(); ++j) {
+		for (unsigned int i = 0; i < genes.size(); ++i) {
+			(*matrix)(i, j) = dataMatrix(genes[i], samples[j]);
+		}
+	}
+}
+
+void TCGADataView::fillDistanceMatrix(const Eigen::MatrixXd &distanceMatrix,
+		Eigen::MatrixXd *matrix) const {
+	matrix->resize(samples.size(), samples.size());
+	for (unsigned int j = 0; j < samples.size(); ++j) {
+		for (unsigned int i = 0; i < samples.size(); ++i) {
+			(*matrix)(i, j) = distanceMatrix(samples[i], samples[j]);
+		}
+	}
+}
+
+TCGADataConsensusClusterer::TCGADataConsensusClusterer(TCGAData *_ptrToData,
+		const TCGADataClusterer *_ptrToClusterer, unsigned int _minK,
+		unsigned int _maxK, unsigned int _resamplingRounds,
+		double _sampleFraction, double _geneFraction, unsigned int _seed,
+		bool _verbose) :
+		ptrToData(_ptrToData), ptrToClusterer(_ptrToClusterer), minK(_minK), maxK(
+				_maxK), resamplingRounds(_resamplingRounds), sampleFraction(
+				_sampleFraction), geneFraction(_geneFraction), seed(_seed), verbose(
+				_verbose) {
+	if (minK < 2 || maxK < minK) {
+		throw tcga_data_exception(
+				"Consensus clustering needs 2 <= minimum K <= maximum K.");
+	}
+	ptrToData->buildDataMatrix();
+}
+
+unsigned long long TCGADataConsensusClusterer::estimateMemory(
+		unsigned int numberOfSamples, unsigned int minK, unsigned int maxK) {
+	unsigned long long numberOfPairs = (unsigned long long) numberOfSamples
+			* (numberOfSamples - 1) / 2;
+	return numberOfPairs * (maxK - minK + 2) * sizeof(unsigned int);
+}
+
+std::size_t TCGADataConsensusClusterer::packedIndex(unsigned int i,
+		unsigned int j) const {
+	if (i > j) {
+		std::swap(i, j);
+	}
+	std::size_t N = ptrToData->getNumberOfSamples();
+	return (std::size_t) i * (2 * N - i - 1) / 2 + (j - i - 1);
+}
+
+TCGADataView TCGADataConsensusClusterer::drawView(
+		std::mt19937_64 *generator) const {
+	auto drawSubset = [&](unsigned int total, double fraction) {
+		std::vector<int> indices(total);
+		std::iota(indices.begin(), indices.end(), 0);
+		unsigned int n = std::min(total,
+				std::max(2u, (unsigned int) (fraction * total + 0.5)));
+		if (n < total) {
+			//Partial Fisher-Yates shuffle
+			for (unsigned int i = 0; i < n; ++i) {
+				std::uniform_int_distribution<unsigned int> distribution(i,
+						total - 1);
+				std::swap(indices[i], indices[distribution(*generator)]);
+			}
+			indices.resize(n);
+			std::sort(indices.begin(), indices.end());
+		}
+		return indices;
+	};
+
+	std::vector<int> samples = drawSubset(ptrToData->getNumberOfSamples(),
+			sampleFraction);
+	std::vector<int> genes = drawSubset(ptrToData->getNumberOfGenes(),
+			geneFraction);
+	return TCGADataView(ptrToData, samples, genes);
+}
+
+void TCGADataConsensusClusterer::runResamplingRound(unsigned int round,
+		Eigen::MatrixXd *dataBuffer, Eigen::MatrixXd *distanceBuffer) {
+	ScopedTimer timer("consensus/round");
+	//One independent stream per round : results do not depend on scheduling
+	std::seed_seq seedSequence { seed, round };
+	std::mt19937_64 generator(seedSequence);
+	TCGADataView view = drawView(&generator);
+	const std::vector<int> &samples = view.getSamples();
+	unsigned int n = view.getNumberOfSamples();
+
+	const Eigen::MatrixXd *matrix = dataBuffer;
+	if (ptrToClusterer->usesDistanceMatrix()) {
+		if (view.getNumberOfGenes() < ptrToData->getNumberOfGenes()) {
+			view.fillDataMatrix(dataBuffer);
+			*distanceBuffer = ptrToClusterer->getMetric()->computeMatrix(
+					*dataBuffer);
+			Trace::count("distance evaluations", (long long) n * (n - 1) / 2);
+		} else {
+			view.fillDistanceMatrix(*ptrToClusterer->getDistanceMatrix(),
+					distanceBuffer);
+		}
+		matrix = distanceBuffer;
+	} else {
+		view.fillDataMatrix(dataBuffer);
+	}
+
+	for (unsigned int a = 0; a < n; ++a) {
+		for (unsigned int b = a + 1; b < n; ++b) {
+			std::size_t index = packedIndex(samples[a], samples[b]);
+#pragma omp atomic
+			++coSampled[index];
+		}
+	}
+
+	for (unsigned int K = minK; K <= maxK; ++K) {
+		std::shared_ptr<ClusterXX::Clusterer> clusterer =
+				ptrToClusterer->buildClusterer(*matrix, K);
+		clusterer->compute();
+		std::vector<int> clusters = clusterer->getClusters();
+
+		std::map<int, std::vector<int>> members;
+		for (unsigned int a = 0; a < n; ++a) {
+			members[clusters[a]].push_back(samples[a]);
+		}
+
+		std::vector<unsigned int> &counts = coClustered[K - minK];
+		for (const auto &kv : members) {
+			const std::vector<int> &cluster = kv.second;
+			for (unsigned int a = 0; a < cluster.size(); ++a) {
+				for (unsigned int b = a + 1; b < cluster.size(); ++b) {
+					std::size_t index = packedIndex(cluster[a], cluster[b]);
+#pragma omp atomic
+					++counts[index];
+				}
+			}
+		}
+	}
+}
+
+void TCGADataConsensusClusterer::computeConsensus() {
+	ScopedTimer timer("consensus");
+	MemoryStage memoryStage("consensus");
+	if (ptrToClusterer->usesDistanceMatrix() && geneFraction < 1.0
+			&& !ptrToClusterer->getMetric()) {
+		throw tcga_data_exception(
+				"Gene resampling needs a clusterer with a metric.");
+	}
+
+	std::size_t N = ptrToData->getNumberOfSamples();
+	std::size_t numberOfPairs = N * (N - 1) / 2;
+	coSampled.assign(numberOfPairs, 0);
+	coClustered.assign(maxK - minK + 1,
+			std::vector<unsigned int>(numberOfPairs, 0));
+	MemoryMonitor::track("consensus counts",
+			estimateMemory(N, minK, maxK));
+
+	if (verbose) {
+		std::cout << "Running " << resamplingRounds
+				<< " resampling rounds (K = " << minK << ".." << maxK
+				<< ")... " << std::endl;
+	}
+
+	unsigned int completedRounds = 0;
+#pragma omp parallel
+	{
+		Eigen::MatrixXd dataBuffer;
+		Eigen::MatrixXd distanceBuffer;
+#pragma omp for schedule(dynamic)
+		for (unsigned int round = 0; round < resamplingRounds; ++round) {
+			runResamplingRound(round, &dataBuffer, &distanceBuffer);
+			if (verbose) {
+#pragma omp critical
+				printAdvancement(++completedRounds, resamplingRounds);
+			}
+		}
+	}
+
+	computeCDF();
+
+	if (verbose) {
+		std::cout << std::endl << "Done." << std::endl;
+	}
+}
+
+void TCGADataConsensusClusterer::computeCDF() {
+	unsigned int N = ptrToData->getNumberOfSamples();
+	consensusCDF.assign(maxK - minK + 1, std::vector<double>(CDF_BINS + 1));
+	areaUnderCDF.assign(maxK - minK + 1, 0.0);
+
+	for (unsigned int K = minK; K <= maxK; ++K) {
+		const std::vector<unsigned int> &counts = coClustered[K - minK];
+		std::vector<unsigned long> histogram(CDF_BINS + 1, 0);
+#pragma omp parallel
+		{
+			std::vector<unsigned long> localHistogram(CDF_BINS + 1, 0);
+#pragma omp for schedule(dynamic, 16)
+			for (unsigned int i = 0; i < N; ++i) {
+				for (unsigned int j = i + 1; j < N; ++j) {
+					std::size_t index = packedIndex(i, j);
+					unsigned long sampled = coSampled[index];
+					if (sampled > 0) {
+						//Smallest bin b such that consensus <= b / CDF_BINS
+						unsigned long bin = ((unsigned long) counts[index]
+								* CDF_BINS + sampled - 1) / sampled;
+						++localHistogram[bin];
+					}
+				}
+			}
+#pragma omp critical
+			for (unsigned int b = 0; b <= CDF_BINS; ++b) {
+				histogram[b] += localHistogram[b];
+			}
+		}
+
+		unsigned long total = std::accumulate(histogram.begin(),
+				histogram.end(), 0ul);
+		std::vector<double> &cdf = consensusCDF[K - minK];
+		unsigned long cumulated = 0;
+		for (unsigned int b = 0; b <= CDF_BINS; ++b) {
+			cumulated += histogram[b];
+			cdf[b] = (total > 0) ? (double) cumulated / (double) total : 0.0;
+		}
+		double area = 0.0;
+		for (unsigned int b = 1; b <= CDF_BINS; ++b) {
+			area += cdf[b] / (double) CDF_BINS;
+		}
+		areaUnderCDF[K - minK] = area;
+	}
+}
+
+double TCGADataConsensusClusterer::getConsensusValue(unsigned int K,
+		unsigned int i, unsigned int j) const {
+	if (i == j) {
+		return 1.0;
+	}
+	std::size_t index = packedIndex(i, j);
+	if (coSampled[index] == 0) {
+		return 0.0;
+	}
+	return (double) coClustered[K - minK][index] / (double) coSampled[index];
+}
+
+const std::vector<double> &TCGADataConsensusClusterer::getConsensusCDF(
+		unsigned int K) const {
+	return consensusCDF.at(K - minK);
+}
+
+double TCGADataConsensusClusterer::getAreaUnderCDF(unsigned int K) const {
+	return areaUnderCDF.at(K - minK);
+}
+
+void TCGADataConsensusClusterer::printConsensusInfo() {
+	for (unsigned int K = minK; K <= maxK; ++K) {
+		double area = getAreaUnderCDF(K);
+		std::cout << "K = " << K << " : area under CDF = " << area;
+		if (K > minK) {
+			double previousArea = getAreaUnderCDF(K - 1);
+			//Without a previous area, the increase is the area itself, as for
+			//the first K in Monti et al.
+			std::cout << ", relative increase = "
+					<< (previousArea > 0 ?
+							(area - previousArea) / previousArea : area);
+		}
+		std::cout << std::endl;
+	}
+}
+
+void TCGADataConsensusClusterer::exportConsensusCDF() {
+	if (verbose) {
+		std::cout << "Exporting consensus CDF... " << std::flush;
+	}
+
+	ExportStream outputStream(EXPORT_DIRECTORY + "consensus-cdf.tsv");
+	outputStream << "K\tCONSENSUS\tCDF" << std::endl;
+	for (unsigned int K = minK; K <= maxK; ++K) {
+		const std::vector<double> &cdf = getConsensusCDF(K);
+		for (unsigned int b = 0; b <= CDF_BINS; ++b) {
+			outputStream << K << "\t" << (double) b / CDF_BINS << "\t" << cdf[b]
+					<< std::endl;
+		}
+	}
+
+	if (verbose) {
+		std::cout << "Done." << std::endl;
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * TCGADataConsensusClusterer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_TCGA_ANALYZER_TCGADATACONSENSUSCLUSTERER_HPP_
+#define SRC_TCGA_ANALYZER_TCGADATACONSENSUSCLUSTERER_HPP_
+
+#include <vector>
+#include <random>
+#include <Eigen/Dense>
+
+#include "../tcga-analyzer/TCGAData.hpp"
+#include "../tcga-analyzer/TCGADataClusterer.hpp"
+
+// Subset of the samples and genes of a TCGAData object, referenced by index
+class TCGADataView {
+public:
+	TCGADataView(const TCGAData *_ptrToData, const std::vector<int> &_samples,
+			const std::vector<int> &_genes);
+	unsigned int getNumberOfSamples() const;
+	unsigned int getNumberOfGenes() const;
+	const std::vector<int> &getSamples() const;
+	const std::vector<int> &getGenes() const;
+	//Gathers the view into a (reused) buffer
+	void fillDataMatrix(Eigen::MatrixXd *matrix) const;
+	void fillDistanceMatrix(const Eigen::MatrixXd &distanceMatrix,
+			Eigen::MatrixXd *matrix) const;
+private:
+	const TCGAData *ptrToData;
+	std::vector<int> samples;
+	std::vector<int> genes;
+};
+
+class TCGADataConsensusClusterer {
+public:
+	TCGADataConsensusClusterer(TCGAData *_ptrToData,
+			const TCGADataClusterer *_ptrToClusterer, unsigned int _minK,
+			unsigned int _maxK, unsigned int _resamplingRounds,
+			double _sampleFraction, double _geneFraction, unsigned int _seed,
+			bool _verbose);
+	void computeConsensus();
+	void printConsensusInfo();
+	void exportConsensusCDF();
+	//Fraction of the rounds where samples i and j were clustered together
+	double getConsensusValue(unsigned int K, unsigned int i,
+			unsigned int j) const;
+	const std::vector<double> &getConsensusCDF(unsigned int K) const;
+	double getAreaUnderCDF(unsigned int K) const;
+	//Co-sampling and co-clustering counts, in bytes
+	static unsigned long long estimateMemory(unsigned int numberOfSamples,
+			unsigned int minK, unsigned int maxK);
+
+	static const unsigned int CDF_BINS = 100;
+private:
+	TCGAData *ptrToData;
+	const TCGADataClusterer *ptrToClusterer;
+	unsigned int minK;
+	unsigned int maxK;
+	unsigned int resamplingRounds;
+	double sampleFraction;
+	double geneFraction;
+	unsigned int seed;
+	bool verbose;
+
+	//Upper triangular matrices stored row by row, without the diagonal
+	std::vector<unsigned int> coSampled;
+	std::vector<std::vector<unsigned int>> coClustered;
+	std::vector<std::vector<double>> consensusCDF;
+	std::vector<double> areaUnderCDF;
+
+	std::size_t packedIndex(unsigned int i, unsigned int j) const;
+	TCGADataView drawView(std::mt19937_64 *generator) const;
+	void runResamplingRound(unsigned int round, Eigen::MatrixXd *dataBuffer,
+			Eigen::MatrixXd *distanceBuffer);
+	void computeCDF();
+};
+
+#endif /* SRC_TCGA_ANALYZER_TCGADATACONSENSUSCLUSTERER_HPP_ */
@@ -0,0 +1,79 @@
+/*
+ * TCGADataDifferentialAnalyzer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_TCGA_ANALYZER_TCGADATADIFFERENTIALANALYZER_HPP_
+#define SRC_TCGA_ANALYZER_TCGADATADIFFERENTIALANALYZER_HPP_
+
+#include <string>
+#include <vector>
+
+#include "../tcga-analyzer/TCGAData.hpp"
+
+enum DifferentialComparisons {
+	//Each tumor class against the control samples of its cancer
+	TUMOR_VERSUS_CONTROL,
+	//Every pair of classes
+	ALL_CLASS_PAIRS
+};
+
+enum DifferentialTest {
+	WELCH_TEST, MANN_WHITNEY_TEST
+};
+
+struct GeneStatistics {
+	//Difference of the means of log2(1 + expression)
+	double log2FoldChange;
+	double welchT;
+	double welchDegreesOfFreedom;
+	double welchP;
+	double welchQ;
+	double mannWhitneyU;
+	double mannWhitneyP;
+	double mannWhitneyQ;
+};
+
+struct ClassComparison {
+	std::string name;
+	std::vector<int> samplesA;
+	std::vector<int> samplesB;
+	//One per gene, in the order of the gene list
+	std::vector<GeneStatistics> statistics;
+};
+
+// Per gene Welch t-tests and Mann-Whitney U tests between classes, with the
+// Benjamini-Hochberg q-values of each comparison. Genes are processed in
+// parallel blocks, the ranks of a gene are sorted once for all comparisons.
+class TCGADataDifferentialAnalyzer {
+public:
+	TCGADataDifferentialAnalyzer(TCGAData *_ptrToData,
+			DifferentialComparisons _comparisons, bool _verbose);
+	void compute();
+	//Number of genes with a q-value below fdr for each comparison and test
+	void printReport(double fdr) const;
+	//One table per comparison, genes ranked by the q-value of the test
+	void exportRankedGenes(DifferentialTest test) const;
+	//Heinz node weights log10(fdr / q) : positive for the genes called at fdr
+	void exportHeinzWeights(DifferentialTest test, double fdr) const;
+	const std::vector<ClassComparison> &getComparisons() const;
+
+	static unsigned long long estimateMemory(unsigned int numberOfGenes,
+			unsigned int numberOfComparisons) {
+		return (unsigned long long) numberOfGenes * numberOfComparisons
+				* sizeof(GeneStatistics);
+	}
+
+private:
+	TCGAData *ptrToData;
+	DifferentialComparisons comparisonsMode;
+	bool verbose;
+	std::vector<ClassComparison> comparisons;
+
+	void buildComparisons();
+	std::vector<unsigned int> rankGenes(const ClassComparison &comparison,
+			DifferentialTest test) const;
+};
+
+#endif /* SRC_TCGA_ANALYZER_TCGADATADIFFERENTIALANALYZER_HPP_ */
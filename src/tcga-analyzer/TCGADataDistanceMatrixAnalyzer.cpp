@@ -6,32 +6,83 @@
 #include <ClusterXX/utils/heatMapBuilder.hpp>
 #include "../config.hpp"
 #include "../utilities.hpp"
+#include "../exportWriter.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
+
+TCGADataDistanceMatrixAnalyser::TCGADataDistanceMatrixAnalyser(
+		TCGAData *_ptrToData, const std::string &_metricName, bool _verbose,
+		DistanceKernels::Mode _kernelMode) :
+		ptrToData(_ptrToData), metric(ClusterXX::buildMetric(_metricName)), metricName(
+				_metricName), kernelMode(_kernelMode), verbose(_verbose), matrixIsComputed(
+				false) {
+}
 
 TCGADataDistanceMatrixAnalyser::TCGADataDistanceMatrixAnalyser(
 		TCGAData *_ptrToData, const std::shared_ptr<ClusterXX::Metric> &_metric,
 		bool _verbose) :
-		ptrToData(_ptrToData), metric(_metric), verbose(_verbose), matrixIsComputed(false) {
+		ptrToData(_ptrToData), metric(_metric), kernelMode(
+				DistanceKernels::CLUSTERXX), verbose(_verbose), matrixIsComputed(
+				false) {
 }
 
 void TCGADataDistanceMatrixAnalyser::computeDistanceMatrix() {
 	if (!matrixIsComputed) {
 		ptrToData->buildDataMatrix();
 		ptrToData->reorderSamples();
-		metric->setVerbose(verbose);
-		distanceMatrix = metric->computeMatrix(ptrToData->getDataMatrixHandler());
+		distanceMatrix =
+				metricName.empty() ?
+						computeDistanceMatrix(*ptrToData, metric, verbose) :
+						computeDistanceMatrix(*ptrToData, metricName, verbose,
+								kernelMode);
 		matrixIsComputed = true;
 	}
 }
 
+Eigen::MatrixXd TCGADataDistanceMatrixAnalyser::computeDistanceMatrix(
+		const TCGAData &data, const std::string &metricName, bool verbose,
+		DistanceKernels::Mode kernelMode) {
+	const Eigen::MatrixXd &dataMatrix = data.getDataMatrixHandler();
+	bool binaryData = kernelMode != DistanceKernels::CLUSTERXX
+			&& DistanceKernels::isBinary(dataMatrix);
+	if (!DistanceKernels::isSupported(metricName, binaryData, kernelMode)) {
+		return computeDistanceMatrix(data, ClusterXX::buildMetric(metricName),
+				verbose);
+	}
+	ScopedTimer timer("distance-matrix");
+	MemoryStage memoryStage("distance-matrix");
+	Eigen::MatrixXd distanceMatrix = DistanceKernels::computeMatrix(metricName,
+			dataMatrix, binaryData, kernelMode, verbose);
+	long long N = distanceMatrix.rows();
+	Trace::count("distance evaluations", N * (N - 1) / 2);
+	MemoryMonitor::track("distanceMatrix", estimateDistanceMatrixBytes(N));
+	return distanceMatrix;
+}
+
+Eigen::MatrixXd TCGADataDistanceMatrixAnalyser::computeDistanceMatrix(
+		const TCGAData &data, const std::shared_ptr<ClusterXX::Metric> &metric,
+		bool verbose) {
+	ScopedTimer timer("distance-matrix");
+	MemoryStage memoryStage("distance-matrix");
+	metric->setVerbose(verbose);
+	Eigen::MatrixXd distanceMatrix = metric->computeMatrix(
+			data.getDataMatrixHandler());
+	long long N = distanceMatrix.rows();
+	Trace::count("distance evaluations", N * (N - 1) / 2);
+	MemoryMonitor::track("distanceMatrix", estimateDistanceMatrixBytes(N));
+	return distanceMatrix;
+}
+
 void TCGADataDistanceMatrixAnalyser::exportDistanceMatrix() {
+	ScopedTimer timer("export/distance-matrix");
 	if (verbose) {
 		std::cout << std::endl << "Exporting Correlation matrix..."
 				<< std::flush;
 	}
 
-	std::ofstream matrixOutputStream(
+	ExportStream matrixOutputStream(
 			EXPORT_DIRECTORY + "matrix-" + metric->toString() + ".txt");
-	std::ofstream patientsOutputStream(
+	ExportStream patientsOutputStream(
 			EXPORT_DIRECTORY + "patients-" + metric->toString() + ".txt");
 
 	unsigned int numberOfSamples = ptrToData->getNumberOfSamples();
@@ -52,7 +103,8 @@ void TCGADataDistanceMatrixAnalyser::exportDistanceMatrix() {
 
 void TCGADataDistanceMatrixAnalyser::exportHeatMap(bool withClassDivision,
 		std::array<unsigned char, 3> separatorColor) {
-	std::ofstream outputStreamLabels(
+	ScopedTimer timer("export/heat-map");
+	ExportStream outputStreamLabels(
 			EXPORT_DIRECTORY + "class-sizes-" + metric->toString()
 					+ ".txt");
 	if (verbose) {
@@ -97,14 +149,27 @@ void TCGADataDistanceMatrixAnalyser::exportHeatMap(bool withClassDivision,
 }
 
 void TCGADataDistanceMatrixAnalyser::exportClassStats() {
+	ScopedTimer timer("export/class-stats");
 
 	if (verbose) {
 		std::cout << "Exporting class stats... " << std::flush;
 	}
 
+	ExportStream outputStream(
+			EXPORT_DIRECTORY + "class-statistics" + metric->toString()
+					+ ".tsv");
+	writeClassStats(*ptrToData, distanceMatrix, outputStream);
+
+	if(verbose){
+		std::cout << "Done." << std::endl;
+	}
+}
+
+void TCGADataDistanceMatrixAnalyser::writeClassStats(const TCGAData &data,
+		const Eigen::MatrixXd &distanceMatrix, std::ostream &outputStream) {
 	//Assumes patients are ordered by class
 	std::vector<std::string> classes;
-	for (const TCGAPatientData &patient : ptrToData->getPatientsHandler()) {
+	for (const TCGAPatientData &patient : data.getPatientsHandler()) {
 		classes.push_back(patient.toClassString());
 	}
 	auto end_unique = unique(classes.begin(), classes.end());
@@ -117,20 +182,20 @@ void TCGADataDistanceMatrixAnalyser::exportClassStats() {
 
 	for (unsigned int i = 0; i < numberOfClasses; ++i) {
 		for (unsigned int j = i; j < numberOfClasses; ++j) {
-			std::vector<double> data;
-			for (int I : ptrToData->getClassMapHandler().at(classes[i])) {
-				for (int J : ptrToData->getClassMapHandler().at(classes[j])) {
+			std::vector<double> distances;
+			for (int I : data.getClassMapHandler().at(classes[i])) {
+				for (int J : data.getClassMapHandler().at(classes[j])) {
 					// When I = J : we are comparing the same patients,
 					//  we know the distance is null
 					if (I != J) {
 						double d = distanceMatrix(I, J);
-						data.push_back(d);
+						distances.push_back(d);
 					}
 				}
 			}
 
-			double mean = computeMean(data);
-			double standard_dev = computeStandardDeviation(data, true);
+			double mean = computeMean(distances);
+			double standard_dev = computeStandardDeviation(distances, true);
 			mean_correlation[numberOfClasses * i + j] = mean;
 			mean_correlation[numberOfClasses * j + i] = mean;
 			standard_dev_correlation[numberOfClasses * i + j] = standard_dev;
@@ -138,19 +203,16 @@ void TCGADataDistanceMatrixAnalyser::exportClassStats() {
 		}
 	}
 
-	std::ofstream outputStream(
-			EXPORT_DIRECTORY + "class-statistics" + metric->toString()
-					+ ".tsv");
 	outputStream << "CLASSES";
 	for (const std::string &s : classes) {
-		outputStream << "\t" << s << " (" << ptrToData->getClassMapHandler().at(s).size()
+		outputStream << "\t" << s << " (" << data.getClassMapHandler().at(s).size()
 				<< ")";
 	}
 	outputStream << std::endl;
 
 	for (unsigned int i = 0; i < numberOfClasses; ++i) {
 		outputStream << classes[i] << " ("
-				<< ptrToData->getClassMapHandler().at(classes[i]).size() << ")";
+				<< data.getClassMapHandler().at(classes[i]).size() << ")";
 		for (unsigned int j = 0; j < numberOfClasses; ++j) {
 			outputStream << "\t" << mean_correlation[numberOfClasses * i + j]
 					<< " (" << standard_dev_correlation[numberOfClasses * i + j]
@@ -158,10 +220,6 @@ void TCGADataDistanceMatrixAnalyser::exportClassStats() {
 		}
 		outputStream << std::endl;
 	}
-
-	if(verbose){
-		std::cout << "Done." << std::endl;
-	}
 }
 
 std::vector<unsigned int> TCGADataDistanceMatrixAnalyser::buildClassDivisionForHeatmap() {
@@ -10,18 +10,34 @@
 
 #include <memory>
 #include <array>
+#include <string>
 #include <ClusterXX/metrics/metrics.hpp>
 
 #include "../tcga-analyzer/TCGAData.hpp"
+#include "../tcga-analyzer/distanceKernels.hpp"
 
 class TCGADataDistanceMatrixAnalyser {
 public:
+	//Native kernel of the metric when there is one (see DistanceKernels)
+	TCGADataDistanceMatrixAnalyser(TCGAData *_ptrToData,
+			const std::string &_metricName, bool _verbose,
+			DistanceKernels::Mode _kernelMode = DistanceKernels::NATIVE);
+	//Always computed by ClusterXX
 	TCGADataDistanceMatrixAnalyser(TCGAData *_ptrToData,
 			const std::shared_ptr<ClusterXX::Metric> &_metric,
 			bool _verbose);
 	void computeDistanceMatrix();
+	//The data matrix of data should be built, samples ordered by class
+	static Eigen::MatrixXd computeDistanceMatrix(const TCGAData &data,
+			const std::string &metricName, bool verbose,
+			DistanceKernels::Mode kernelMode = DistanceKernels::NATIVE);
+	static Eigen::MatrixXd computeDistanceMatrix(const TCGAData &data,
+			const std::shared_ptr<ClusterXX::Metric> &metric, bool verbose);
 	void exportDistanceMatrix();
 	void exportClassStats();
+	//Mean (standard deviation) of the distances between and within classes
+	static void writeClassStats(const TCGAData &data,
+			const Eigen::MatrixXd &distanceMatrix, std::ostream &output);
 	void exportHeatMap(bool withClassDivision = true,
 			std::array<unsigned char, 3> separatorColor = std::array<
 					unsigned char, 3> { static_cast<unsigned char>(255),
@@ -29,9 +45,17 @@ public:
 	Eigen::MatrixXd &getDistanceMatrixHandler() {
 		return distanceMatrix;
 	}
+	static unsigned long long estimateDistanceMatrixBytes(
+			unsigned int numberOfSamples) {
+		return (unsigned long long) numberOfSamples * numberOfSamples
+				* sizeof(double);
+	}
 private:
 	TCGAData *ptrToData;
 	std::shared_ptr<ClusterXX::Metric> metric;
+	//Empty when the analyser was given a ClusterXX metric
+	std::string metricName;
+	DistanceKernels::Mode kernelMode;
 	Eigen::MatrixXd distanceMatrix;
 	bool verbose;
 	bool matrixIsComputed;
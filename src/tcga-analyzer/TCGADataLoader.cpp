@@ -1,12 +1,16 @@
 #include "../tcga-analyzer/TCGADataLoader.hpp"
 
 #include <fstream>
+#include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <sys/stat.h>
 #include <boost/algorithm/string.hpp>
 
 #include "../utilities.hpp"
 #include "../config.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
 
 TCGADataLoader::TCGADataLoader(TCGAData *_ptrToData,
 		const std::set<std::string> &_cancers, unsigned int _maxControlSamples,
@@ -55,7 +59,80 @@ void TCGADataLoader::loadGeneData(const std::string &file) {
 
 void TCGADataLoader::initializeRNASeqData() {
 	unsigned int numberOfGenes = ptrToData->getNumberOfGenes();
+	unsigned int numberOfSamples = countSamples();
 	ptrToData->getDataHandler().resize(numberOfGenes);
+	for (auto &geneData : ptrToData->getDataHandler()) {
+		geneData.reserve(numberOfSamples);
+	}
+	MemoryMonitor::track("RNASeqData",
+			TCGAData::estimateRNASeqDataBytes(numberOfGenes, numberOfSamples));
+}
+
+unsigned int TCGADataLoader::countSamples() const {
+	unsigned int count = 0;
+	for (const auto &cancer : cancers) {
+		std::ifstream input(
+				TCGA_DATA_DIRECTORY + cancer + "-normalized/patient.list");
+		std::string patientId;
+		unsigned int countControl = 0;
+		unsigned int countTumor = 0;
+		while (input >> patientId) {
+			std::string type = patientId.substr(patientId.rfind('-') + 1);
+			if (type == "01" && countTumor < maxTumorSamples) {
+				++countTumor;
+			} else if (type == "11" && countControl < maxControlSamples) {
+				++countControl;
+			}
+		}
+		count += countControl + countTumor;
+	}
+	return count;
+}
+
+namespace {
+
+std::string fileStamp(const std::string &filename) {
+	struct stat fileStatus;
+	if (stat(filename.c_str(), &fileStatus) != 0) {
+		return filename + " missing\n";
+	}
+	return filename + " " + std::to_string(fileStatus.st_size) + " "
+			+ std::to_string(fileStatus.st_mtime) + "\n";
+}
+
+}
+
+std::string TCGADataLoader::getFingerprint(
+		const std::string &sampleFilePath) const {
+	unsigned long long hash = hashBytes(fileStamp(sampleFilePath));
+	for (const auto &cancer : cancers) {
+		std::string directory = TCGA_DATA_DIRECTORY + cancer + "-normalized/";
+		std::string patientList = readFileContent(directory + "patient.list");
+		hash = hashBytes(cancer + "\n" + patientList, hash);
+		hash = hashBytes(readFileContent(directory + "clinical.tsv"), hash);
+		std::istringstream patients(patientList);
+		std::string patientId;
+		while (patients >> patientId) {
+			hash = hashBytes(
+					fileStamp(
+							directory + patientId
+									+ ".genes.normalized.results"), hash);
+		}
+	}
+	return toHexString(hash);
+}
+
+unsigned int TCGADataLoader::countGenes(const std::string &sampleFilePath) {
+	std::ifstream input(sampleFilePath);
+	std::string line;
+	std::getline(input, line);
+	unsigned int count = 0;
+	while (std::getline(input, line)) {
+		if (!line.empty()) {
+			++count;
+		}
+	}
+	return count;
 }
 
 void TCGADataLoader::loadRNASeqData(const std::string &cancer,
@@ -72,9 +149,16 @@ void TCGADataLoader::loadRNASeqData(const std::string &cancer,
 		ptrToData->getDataHandler()[i].push_back(score);
 		i++;
 	}
+	if (Trace::isEnabled()) {
+		input.clear();
+		Trace::count("loaded files", 1);
+		Trace::count("loaded bytes", input.tellg());
+		Trace::count("loaded samples", 1);
+	}
 }
 
 void TCGADataLoader::loadDataByCancer(const std::string &cancer) {
+	ScopedTimer timer("load/cancer");
 	std::string patientListFilename = TCGA_DATA_DIRECTORY + cancer
 			+ "-normalized/patient.list";
 	std::ifstream input(patientListFilename);
@@ -121,6 +205,8 @@ void TCGADataLoader::loadDataByCancer(const std::string &cancer) {
 }
 
 void TCGADataLoader::loadGeneExpressionData(const std::string &sampleFilePath) {
+	ScopedTimer timer("load");
+	MemoryStage memoryStage("load");
 	loadGeneData(sampleFilePath);
 	initializeRNASeqData();
 	for (const auto &cancer : cancers) {
@@ -165,6 +251,7 @@ void TCGADataLoader::loadClinicalDataByCancer(
 
 void TCGADataLoader::loadClinicalData(
 		const std::set<std::string> &clinicalAttributes) {
+	ScopedTimer timer("load/clinical");
 
 	if (!clinicalAttributes.empty()) {
 		for (const auto &cancer : cancers) {
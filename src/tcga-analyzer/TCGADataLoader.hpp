@@ -16,6 +16,12 @@ public:
 			unsigned int _maxTumorSamples, bool verbose);
 	void loadGeneExpressionData(const std::string &sampleFilePath);
 	void loadClinicalData(const std::set<std::string> &clinicalAttributes);
+	//Samples loadGeneExpressionData will load (only the patient lists are read)
+	unsigned int countSamples() const;
+	static unsigned int countGenes(const std::string &sampleFilePath);
+	//Changes whenever a file the loader reads changes : patient lists and
+	//clinical files by content, sample files by size and modification time
+	std::string getFingerprint(const std::string &sampleFilePath) const;
 
 	static std::map<std::string, int> buildHgnc2IdMapping(const std::string &file);
 private:
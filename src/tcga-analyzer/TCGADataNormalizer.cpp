@@ -2,11 +2,18 @@
 #include <iostream>
 #include <fstream>
 #include <memory>
+#include <sstream>
+#include <cmath>
+#include <exception>
+#include <stdexcept>
 #include <Eigen/Dense>
 #include <ClusterXX/clustering/kmeans_clusterer.hpp>
 #include <ClusterXX/utils/utils.hpp>
 #include "../config.hpp"
 #include "../utilities.hpp"
+#include "../exportWriter.hpp"
+#include "../trace.hpp"
+#include "../memory.hpp"
 
 void KMeansNormalizer::normalize(std::vector<double> *v) {
 	Eigen::Map<Eigen::MatrixXd> mapToData((*v).data(), 1, (*v).size());
@@ -55,12 +62,15 @@ void TCGADataNormalizer::normalizeIndividualSample(unsigned int sampleId) {
 }
 
 void TCGADataNormalizer::normalize() {
+	ScopedTimer timer("normalize");
+	MemoryStage memoryStage("normalize");
 	if (verbose) {
 		std::cout << "Normalizing data... " << std::flush;
 	}
 	for(unsigned int i=0; i<ptrToData->getNumberOfSamples(); ++i){
 		normalizeIndividualSample(i);
 	}
+	Trace::count("normalized samples", ptrToData->getNumberOfSamples());
 	if (verbose) {
 		std::cout << "Done." << std::endl;
 	}
@@ -68,31 +78,150 @@ void TCGADataNormalizer::normalize() {
 
 void TCGADataNormalizer::exportToFile(double positiveValue,
 		double negativeValue) {
+	exportToFile(positiveValue, std::vector<double> { negativeValue });
+}
+
+namespace {
+
+std::string formatValue(double value) {
+	std::ostringstream ss;
+	ss << value;
+	return ss.str();
+}
+
+//Takes the buffer, queued to ExportWriter
+void writeBuffer(const std::string &filename, std::string &buffer) {
+	ExportWriter::write(filename, std::move(buffer));
+	buffer.clear();
+}
+
+}
+
+void TCGADataNormalizer::exportToFile(double positiveValue,
+		const std::vector<double> &negativeValues, bool packed) {
+	ScopedTimer timer("export/heinz-input");
+	MemoryStage memoryStage("export/heinz-input");
 	ptrToData->buildDataMatrix();
-	std::ofstream outputStreamSamples(HEINZ_SAMPLES_LIST);
 	const auto &dataMatrix = ptrToData->getDataMatrixHandler();
+	const auto &geneList = ptrToData->getGeneListHandler();
 	unsigned int N = dataMatrix.cols();
+	unsigned int numberOfGenes = dataMatrix.rows();
+
+	std::vector<std::string> patientIDs(N);
+	std::string samplesBuffer;
 	for (unsigned int i = 0; i < N; ++i) {
+		patientIDs[i] = ptrToData->getPatientsHandler()[i].toString();
+		samplesBuffer += patientIDs[i] + "\n";
+	}
+	writeBuffer(HEINZ_SAMPLES_LIST, samplesBuffer);
+
+	//Values are formatted once, as operator<< would write them
+	std::string positiveString = formatValue(positiveValue);
+	std::vector<std::string> weightStrings;
+	std::vector<std::string> negativeStrings;
+	for (double d : negativeValues) {
+		weightStrings.push_back(removeTrailingZeros(std::to_string(std::fabs(d))));
+		negativeStrings.push_back(formatValue(d));
+	}
+
+	if (packed) {
+		std::string genesBuffer;
+		for (unsigned int j = 0; j < numberOfGenes; ++j) {
+			genesBuffer += geneList[j].first + "\n";
+		}
+		writeBuffer(HEINZ_PACKED_GENE_LIST, genesBuffer);
+	}
 
-		std::string outputFilename =
-				ptrToData->getPatientsHandler()[i].toString();
-		outputStreamSamples << outputFilename << std::endl;
-
-		std::ofstream outputStream(
-				HEINZ_INPUT_DIRECTORY
-						+ removeTrailingZeros(
-								std::to_string(std::fabs(negativeValue))) + '_'
-						+ outputFilename + ".txt");
-
-		for (unsigned int j = 0; j < dataMatrix.rows(); ++j) {
-			outputStream << ptrToData->getGeneListHandler()[j].first << " ";
-			if (dataMatrix(j, i) > 0.5) {
-				outputStream << positiveValue << std::endl;
-			} else {
-				outputStream << negativeValue << std::endl;
+	ProgressCounter progress(N, "samples", verbose);
+	std::exception_ptr exception = nullptr;
+#pragma omp parallel
+	{
+		std::string buffer;
+		std::vector<char> isPositive(numberOfGenes);
+#pragma omp for schedule(dynamic)
+		for (unsigned int i = 0; i < N; ++i) {
+			try {
+				ScopedTimer sampleTimer("export/heinz-input/sample");
+				for (unsigned int j = 0; j < numberOfGenes; ++j) {
+					isPositive[j] = dataMatrix(j, i) > 0.5;
+				}
+				if (packed) {
+					buffer.assign((numberOfGenes + 7) / 8, '\0');
+					for (unsigned int j = 0; j < numberOfGenes; ++j) {
+						if (isPositive[j]) {
+							buffer[j / 8] |= (char) (1 << (j % 8));
+						}
+					}
+					writeBuffer(
+							HEINZ_INPUT_DIRECTORY + patientIDs[i]
+									+ HEINZ_PACKED_EXTENSION, buffer);
+				} else {
+					for (unsigned int w = 0; w < negativeValues.size(); ++w) {
+						buffer.clear();
+						for (unsigned int j = 0; j < numberOfGenes; ++j) {
+							buffer += geneList[j].first;
+							buffer += ' ';
+							buffer += isPositive[j] ?
+									positiveString : negativeStrings[w];
+							buffer += '\n';
+						}
+						writeBuffer(
+								HEINZ_INPUT_DIRECTORY + weightStrings[w] + '_'
+										+ patientIDs[i] + ".txt", buffer);
+					}
+				}
+			} catch (...) {
+#pragma omp critical
+				if (!exception) {
+					exception = std::current_exception();
+				}
 			}
+			progress.increment();
 		}
+	}
+	progress.finish();
 
-		ClusterXX::Utilities::printAdvancement(i, N);
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+std::vector<std::string> TCGADataNormalizer::readPackedGeneList() {
+	std::vector<std::string> genes;
+	std::ifstream inputStream(HEINZ_PACKED_GENE_LIST);
+	std::string gene;
+	while (inputStream >> gene) {
+		genes.push_back(gene);
+	}
+	return genes;
+}
+
+void TCGADataNormalizer::expandPackedFile(const std::vector<std::string> &genes,
+		const std::string &patientID, double positiveValue,
+		double negativeValue, const std::string &outputFilename) {
+	std::string bits = readFileContent(
+			HEINZ_INPUT_DIRECTORY + patientID + HEINZ_PACKED_EXTENSION);
+	if (bits.size() != (genes.size() + 7) / 8) {
+		throw tcga_data_exception(
+				"Packed Heinz input for " + patientID
+						+ " does not match the gene list.");
+	}
+	std::string positiveString = formatValue(positiveValue);
+	std::string negativeString = formatValue(negativeValue);
+	std::string buffer;
+	for (unsigned int j = 0; j < genes.size(); ++j) {
+		buffer += genes[j];
+		buffer += ' ';
+		buffer += ((bits[j / 8] >> (j % 8)) & 1) ?
+				positiveString : negativeString;
+		buffer += '\n';
+	}
+	//Synchronous, not queued : the solver reads the file as soon as this
+	//returns, and the scheduler removes it afterwards
+	std::ofstream outputStream(outputFilename, std::ios::binary);
+	outputStream.write(buffer.data(), buffer.size());
+	outputStream.close();
+	if (!outputStream) {
+		throw std::runtime_error("Cannot write " + outputFilename);
 	}
 }
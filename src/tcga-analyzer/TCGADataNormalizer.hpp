@@ -10,6 +10,8 @@
 
 #include <memory>
 #include <fstream>
+#include <vector>
+#include <string>
 #include "../tcga-analyzer/TCGAData.hpp"
 #include "../config.hpp"
 
@@ -55,6 +57,16 @@ public:
 					true);
 	void normalize();
 	void exportToFile(double positiveValue, double negativeValuess);
+	//All weights in one pass, one thread per sample. With packed = true,
+	//only one bit per gene is written for each sample (see expandPackedFile)
+	void exportToFile(double positiveValue,
+			const std::vector<double> &negativeValues, bool packed = false);
+
+	//Reading back the packed export : the consumer applies the weights
+	static std::vector<std::string> readPackedGeneList();
+	static void expandPackedFile(const std::vector<std::string> &genes,
+			const std::string &patientID, double positiveValue,
+			double negativeValue, const std::string &outputFilename);
 private:
 	TCGAData *ptrToData;
 	std::shared_ptr<Normalizer> ptrToNormalizer;
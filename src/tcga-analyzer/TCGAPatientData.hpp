@@ -20,6 +20,9 @@ public:
 	void setClinicalData(const std::string &key, const std::string &value);
 	bool existsClinicalData(const std::string &key) const;
 	std::string getClinicalData(const std::string &key) const;
+	const std::map<std::string, std::string> &getClinicalDataHandler() const {
+		return clinicalData;
+	}
 	std::string toString() const;
 	std::string toClassString(std::set<std::string> keys = std::set<std::string>()) const;
 private:
@@ -0,0 +1,463 @@
+/*
+ * distanceKernels.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "distanceKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../utilities.hpp"
+#include "../memory.hpp"
+
+namespace {
+
+//What is done to each column before the pairs are reduced
+enum Preparation {
+	RAW, NORMALIZED, CENTERED, RANKED
+};
+enum Reduction {
+	DOT, SQUARED_DIFFERENCE, ABSOLUTE_DIFFERENCE
+};
+//What the kernel on bits derives from the number of ones of two columns and
+//of their intersection
+enum BitStatistic {
+	CORRELATION, COSINE, HAMMING, JACCARD
+};
+enum Finalization {
+	IDENTITY, ABSOLUTE, ONE_MINUS, SQUARE_ROOT
+};
+
+struct MetricKernel {
+	Preparation preparation;
+	Reduction reduction;
+	BitStatistic bitStatistic;
+	Finalization finalization;
+	bool binaryOnly;
+};
+
+//Ranks of binary values are an affine function of the values : Spearman is
+//Pearson on bits
+const std::map<std::string, MetricKernel> METRIC_KERNELS = {
+		{ "pearson", { CENTERED, DOT, CORRELATION, IDENTITY, false } },
+		{ "pearson-correlation", { CENTERED, DOT, CORRELATION, IDENTITY, false } },
+		{ "absolute-pearson", { CENTERED, DOT, CORRELATION, ABSOLUTE, false } },
+		{ "pearson-absolute-correlation", { CENTERED, DOT, CORRELATION, ABSOLUTE, false } },
+		{ "pearson-distance", { CENTERED, DOT, CORRELATION, ONE_MINUS, false } },
+		{ "spearman", { RANKED, DOT, CORRELATION, IDENTITY, false } },
+		{ "spearman-correlation", { RANKED, DOT, CORRELATION, IDENTITY, false } },
+		{ "absolute-spearman", { RANKED, DOT, CORRELATION, ABSOLUTE, false } },
+		{ "spearman-absolute-correlation", { RANKED, DOT, CORRELATION, ABSOLUTE, false } },
+		{ "spearman-distance", { RANKED, DOT, CORRELATION, ONE_MINUS, false } },
+		{ "cosine", { NORMALIZED, DOT, COSINE, IDENTITY, false } },
+		{ "cosine-smilarity", { NORMALIZED, DOT, COSINE, IDENTITY, false } },
+		{ "absolute-cosine", { NORMALIZED, DOT, COSINE, ABSOLUTE, false } },
+		{ "cosine-absolute-similarity", { NORMALIZED, DOT, COSINE, ABSOLUTE, false } },
+		{ "cosine-distance", { NORMALIZED, DOT, COSINE, ONE_MINUS, false } },
+		{ "euclidean", { RAW, SQUARED_DIFFERENCE, HAMMING, SQUARE_ROOT, false } },
+		{ "euclidean-distance", { RAW, SQUARED_DIFFERENCE, HAMMING, SQUARE_ROOT, false } },
+		{ "squared-euclidean", { RAW, SQUARED_DIFFERENCE, HAMMING, IDENTITY, false } },
+		{ "squared-euclidean-distance", { RAW, SQUARED_DIFFERENCE, HAMMING, IDENTITY, false } },
+		{ "manhattan", { RAW, ABSOLUTE_DIFFERENCE, HAMMING, IDENTITY, false } },
+		{ "manhattan-distance", { RAW, ABSOLUTE_DIFFERENCE, HAMMING, IDENTITY, false } },
+		{ "jaccard", { RAW, DOT, JACCARD, IDENTITY, true } },
+		{ "jaccard-similarity", { RAW, DOT, JACCARD, IDENTITY, true } },
+		{ "jaccard-distance", { RAW, DOT, JACCARD, ONE_MINUS, true } } };
+
+//Columns are paired by blocks, and the rows of a pair of blocks are reduced
+//by chunks which stay in cache
+const unsigned int BLOCK_COLUMNS = 16;
+
+template<Finalization F>
+inline double finalize(double value) {
+	switch (F) {
+	case ABSOLUTE:
+		return std::fabs(value);
+	case ONE_MINUS:
+		return 1 - value;
+	case SQUARE_ROOT:
+		return std::sqrt(std::max(0.0, value));
+	default:
+		return value;
+	}
+}
+
+template<typename T, Reduction R, Finalization F>
+struct DenseKernel {
+	typedef T Accumulator;
+	static const unsigned int CHUNK = 8192 / sizeof(T);
+
+	//Column-major
+	const T *values;
+	unsigned int rows;
+
+	unsigned int getLength() const {
+		return rows;
+	}
+
+	T reduce(unsigned int i, unsigned int j, unsigned int begin,
+			unsigned int end) const {
+		const T *x = values + (std::size_t) i * rows;
+		const T *y = values + (std::size_t) j * rows;
+		T sum = 0;
+		if (R == DOT) {
+#pragma omp simd reduction(+:sum)
+			for (unsigned int k = begin; k < end; ++k) {
+				sum += x[k] * y[k];
+			}
+		} else if (R == SQUARED_DIFFERENCE) {
+#pragma omp simd reduction(+:sum)
+			for (unsigned int k = begin; k < end; ++k) {
+				T difference = x[k] - y[k];
+				sum += difference * difference;
+			}
+		} else {
+#pragma omp simd reduction(+:sum)
+			for (unsigned int k = begin; k < end; ++k) {
+				sum += std::abs(x[k] - y[k]);
+			}
+		}
+		return sum;
+	}
+
+	double finish(unsigned int, unsigned int, T sum) const {
+		return finalize<F>(sum);
+	}
+
+	//Value for two identical columns : the prepared columns have a unit norm
+	double diagonal() const {
+		return finalize<F>(R == DOT ? 1 : 0);
+	}
+};
+
+template<BitStatistic S, Finalization F>
+struct BitKernel {
+	typedef std::uint64_t Accumulator;
+	static const unsigned int CHUNK = 1024;
+
+	const std::uint64_t *words;
+	unsigned int wordsPerColumn;
+	//Number of ones of each column
+	const unsigned int *ones;
+	unsigned int rows;
+
+	unsigned int getLength() const {
+		return wordsPerColumn;
+	}
+
+	std::uint64_t reduce(unsigned int i, unsigned int j, unsigned int begin,
+			unsigned int end) const {
+		const std::uint64_t *x = words + (std::size_t) i * wordsPerColumn;
+		const std::uint64_t *y = words + (std::size_t) j * wordsPerColumn;
+		std::uint64_t both = 0;
+#pragma omp simd reduction(+:both)
+		for (unsigned int k = begin; k < end; ++k) {
+			both += __builtin_popcountll(x[k] & y[k]);
+		}
+		return both;
+	}
+
+	double finish(unsigned int i, unsigned int j, std::uint64_t both) const {
+		double a = ones[i];
+		double b = ones[j];
+		double c = both;
+		double n = rows;
+		double value = 0;
+		switch (S) {
+		case CORRELATION: {
+			double variances = (n * a - a * a) * (n * b - b * b);
+			value = variances > 0 ? (n * c - a * b) / std::sqrt(variances) : 0;
+			break;
+		}
+		case COSINE:
+			value = a * b > 0 ? c / std::sqrt(a * b) : 0;
+			break;
+		case HAMMING:
+			value = a + b - 2 * c;
+			break;
+		case JACCARD:
+			//Two empty sets are identical
+			value = a + b - c > 0 ? c / (a + b - c) : 1;
+			break;
+		}
+		return finalize<F>(value);
+	}
+
+	double diagonal() const {
+		return finalize<F>(S == HAMMING ? 0 : 1);
+	}
+};
+
+template<typename Kernel>
+Eigen::MatrixXd computePairs(const Kernel &kernel, unsigned int N,
+		bool verbose) {
+	typedef typename Kernel::Accumulator Accumulator;
+	const unsigned int chunk = Kernel::CHUNK;
+	unsigned int length = kernel.getLength();
+	unsigned int numberOfBlocks = (N + BLOCK_COLUMNS - 1) / BLOCK_COLUMNS;
+	std::vector<std::pair<unsigned int, unsigned int>> blockPairs;
+	for (unsigned int bi = 0; bi < numberOfBlocks; ++bi) {
+		for (unsigned int bj = bi; bj < numberOfBlocks; ++bj) {
+			blockPairs.emplace_back(bi, bj);
+		}
+	}
+
+	Eigen::MatrixXd matrix(N, N);
+	ProgressCounter progress(blockPairs.size(), "blocks", verbose);
+#pragma omp parallel
+	{
+		Accumulator partial[BLOCK_COLUMNS][BLOCK_COLUMNS];
+#pragma omp for schedule(dynamic)
+		for (unsigned int p = 0; p < blockPairs.size(); ++p) {
+			unsigned int iBegin = blockPairs[p].first * BLOCK_COLUMNS;
+			unsigned int iEnd = std::min(N, iBegin + BLOCK_COLUMNS);
+			unsigned int jBegin = blockPairs[p].second * BLOCK_COLUMNS;
+			unsigned int jEnd = std::min(N, jBegin + BLOCK_COLUMNS);
+			for (auto &row : partial) {
+				std::fill(row, row + BLOCK_COLUMNS, Accumulator(0));
+			}
+			for (unsigned int begin = 0; begin < length; begin += chunk) {
+				unsigned int end = std::min(length, begin + chunk);
+				for (unsigned int i = iBegin; i < iEnd; ++i) {
+					for (unsigned int j = std::max(i + 1, jBegin); j < jEnd;
+							++j) {
+						partial[i - iBegin][j - jBegin] += kernel.reduce(i, j,
+								begin, end);
+					}
+				}
+			}
+			for (unsigned int i = iBegin; i < iEnd; ++i) {
+				//Set, not computed : a constant column is zeroed by its
+				//preparation, and would not be identical to itself
+				if (i >= jBegin) {
+					matrix(i, i) = kernel.diagonal();
+				}
+				for (unsigned int j = std::max(i + 1, jBegin); j < jEnd; ++j) {
+					double value = kernel.finish(i, j,
+							partial[i - iBegin][j - jBegin]);
+					matrix(i, j) = value;
+					matrix(j, i) = value;
+				}
+			}
+			progress.increment();
+		}
+	}
+	progress.finish();
+	return matrix;
+}
+
+template<typename T, Reduction R>
+Eigen::MatrixXd computeDense(const T *values, unsigned int rows,
+		unsigned int N, Finalization finalization, bool verbose) {
+	switch (finalization) {
+	case ABSOLUTE:
+		return computePairs(DenseKernel<T, R, ABSOLUTE> { values, rows }, N,
+				verbose);
+	case ONE_MINUS:
+		return computePairs(DenseKernel<T, R, ONE_MINUS> { values, rows }, N,
+				verbose);
+	case SQUARE_ROOT:
+		return computePairs(DenseKernel<T, R, SQUARE_ROOT> { values, rows }, N,
+				verbose);
+	default:
+		return computePairs(DenseKernel<T, R, IDENTITY> { values, rows }, N,
+				verbose);
+	}
+}
+
+template<typename T>
+Eigen::MatrixXd computeDense(const T *values, unsigned int rows,
+		unsigned int N, Reduction reduction, Finalization finalization,
+		bool verbose) {
+	switch (reduction) {
+	case SQUARED_DIFFERENCE:
+		return computeDense<T, SQUARED_DIFFERENCE>(values, rows, N,
+				finalization, verbose);
+	case ABSOLUTE_DIFFERENCE:
+		return computeDense<T, ABSOLUTE_DIFFERENCE>(values, rows, N,
+				finalization, verbose);
+	default:
+		return computeDense<T, DOT>(values, rows, N, finalization, verbose);
+	}
+}
+
+struct PackedColumns {
+	std::vector<std::uint64_t> words;
+	std::vector<unsigned int> ones;
+	unsigned int wordsPerColumn;
+};
+
+template<BitStatistic S>
+Eigen::MatrixXd computeBits(const PackedColumns &packed, unsigned int rows,
+		unsigned int N, Finalization finalization, bool verbose) {
+	const std::uint64_t *words = packed.words.data();
+	unsigned int wordsPerColumn = packed.wordsPerColumn;
+	const unsigned int *ones = packed.ones.data();
+	switch (finalization) {
+	case ABSOLUTE:
+		return computePairs(BitKernel<S, ABSOLUTE> { words, wordsPerColumn,
+				ones, rows }, N, verbose);
+	case ONE_MINUS:
+		return computePairs(BitKernel<S, ONE_MINUS> { words, wordsPerColumn,
+				ones, rows }, N, verbose);
+	case SQUARE_ROOT:
+		return computePairs(BitKernel<S, SQUARE_ROOT> { words, wordsPerColumn,
+				ones, rows }, N, verbose);
+	default:
+		return computePairs(BitKernel<S, IDENTITY> { words, wordsPerColumn,
+				ones, rows }, N, verbose);
+	}
+}
+
+Eigen::MatrixXd computeBits(const PackedColumns &packed, unsigned int rows,
+		unsigned int N, BitStatistic statistic, Finalization finalization,
+		bool verbose) {
+	switch (statistic) {
+	case COSINE:
+		return computeBits<COSINE>(packed, rows, N, finalization, verbose);
+	case HAMMING:
+		return computeBits<HAMMING>(packed, rows, N, finalization, verbose);
+	case JACCARD:
+		return computeBits<JACCARD>(packed, rows, N, finalization, verbose);
+	default:
+		return computeBits<CORRELATION>(packed, rows, N, finalization,
+				verbose);
+	}
+}
+
+PackedColumns packColumns(const Eigen::MatrixXd &data) {
+	unsigned int rows = data.rows();
+	unsigned int N = data.cols();
+	PackedColumns packed;
+	packed.wordsPerColumn = (rows + 63) / 64;
+	packed.words.assign((std::size_t) N * packed.wordsPerColumn, 0);
+	packed.ones.assign(N, 0);
+#pragma omp parallel for schedule(dynamic)
+	for (unsigned int i = 0; i < N; ++i) {
+		std::uint64_t *column = packed.words.data()
+				+ (std::size_t) i * packed.wordsPerColumn;
+		for (unsigned int k = 0; k < rows; ++k) {
+			if (data(k, i) != 0) {
+				column[k / 64] |= std::uint64_t(1) << (k % 64);
+				++packed.ones[i];
+			}
+		}
+	}
+	return packed;
+}
+
+//Ties get the mean of their ranks
+Eigen::VectorXd rankValues(const Eigen::VectorXd &values) {
+	std::vector<unsigned int> order(values.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&values](unsigned int a,
+			unsigned int b) {
+		return values[a] < values[b];
+	});
+	Eigen::VectorXd ranks(values.size());
+	for (unsigned int k = 0; k < order.size();) {
+		unsigned int end = k + 1;
+		while (end < order.size() && values[order[end]] == values[order[k]]) {
+			++end;
+		}
+		double rank = (k + end - 1) / 2.0 + 1;
+		for (unsigned int m = k; m < end; ++m) {
+			ranks[order[m]] = rank;
+		}
+		k = end;
+	}
+	return ranks;
+}
+
+//Correlations and cosines become dot products of the prepared columns
+template<typename T>
+Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> prepareColumns(
+		const Eigen::MatrixXd &data, Preparation preparation) {
+	Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> prepared(data.rows(),
+			data.cols());
+	long N = data.cols();
+#pragma omp parallel for schedule(dynamic)
+	for (long i = 0; i < N; ++i) {
+		Eigen::VectorXd column = data.col(i);
+		if (preparation == RANKED) {
+			column = rankValues(column);
+		}
+		if (preparation == CENTERED || preparation == RANKED) {
+			//Rounding would leave a constant column with a tiny, random norm
+			if (column.size() == 0 || column.maxCoeff() == column.minCoeff()) {
+				column.setZero();
+			} else {
+				column.array() -= column.mean();
+			}
+		}
+		if (preparation != RAW) {
+			double norm = column.norm();
+			if (norm > 0) {
+				column /= norm;
+			}
+		}
+		prepared.col(i) = column.cast<T>();
+	}
+	return prepared;
+}
+
+}
+
+bool DistanceKernels::isBinary(const Eigen::MatrixXd &data) {
+	return ((data.array() == 0.0) || (data.array() == 1.0)).all();
+}
+
+bool DistanceKernels::isSupported(const std::string &metricName,
+		bool binaryData, Mode mode) {
+	auto it = METRIC_KERNELS.find(metricName);
+	return mode != CLUSTERXX && it != METRIC_KERNELS.end()
+			&& (!it->second.binaryOnly || binaryData);
+}
+
+Eigen::MatrixXd DistanceKernels::computeMatrix(const std::string &metricName,
+		const Eigen::MatrixXd &data, bool binaryData, Mode mode,
+		bool verbose) {
+	auto it = METRIC_KERNELS.find(metricName);
+	if (mode == CLUSTERXX || it == METRIC_KERNELS.end()) {
+		throw std::invalid_argument(
+				"No native distance kernel for metric " + metricName);
+	}
+	const MetricKernel &kernel = it->second;
+	unsigned int rows = data.rows();
+	unsigned int N = data.cols();
+
+	if (binaryData) {
+		PackedColumns packed = packColumns(data);
+		MemoryMonitor::track("packedColumns",
+				packed.words.size() * sizeof(std::uint64_t));
+		return computeBits(packed, rows, N, kernel.bitStatistic,
+				kernel.finalization, verbose);
+	}
+	if (kernel.binaryOnly) {
+		throw std::invalid_argument(
+				"The native " + metricName + " kernel needs binary data");
+	}
+	if (mode == NATIVE_FLOAT) {
+		Eigen::MatrixXf prepared = prepareColumns<float>(data,
+				kernel.preparation);
+		MemoryMonitor::track("preparedColumns",
+				prepared.size() * sizeof(float));
+		return computeDense<float>(prepared.data(), rows, N, kernel.reduction,
+				kernel.finalization, verbose);
+	}
+	if (kernel.preparation == RAW) {
+		return computeDense<double>(data.data(), rows, N, kernel.reduction,
+				kernel.finalization, verbose);
+	}
+	Eigen::MatrixXd prepared = prepareColumns<double>(data, kernel.preparation);
+	MemoryMonitor::track("preparedColumns", prepared.size() * sizeof(double));
+	return computeDense<double>(prepared.data(), rows, N, kernel.reduction,
+			kernel.finalization, verbose);
+}
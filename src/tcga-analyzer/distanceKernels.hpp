@@ -0,0 +1,43 @@
+/*
+ * distanceKernels.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_TCGA_ANALYZER_DISTANCEKERNELS_HPP_
+#define SRC_TCGA_ANALYZER_DISTANCEKERNELS_HPP_
+
+#include <string>
+#include <Eigen/Dense>
+
+// Pairwise matrices of the columns of a data matrix for the metrics of
+// ALLOWED_METRICS, without the virtual calls of ClusterXX::Metric : each
+// metric is a kernel instantiated for its data type (double, float, or bits
+// when the data is binary) and chosen once per matrix. Constant columns have
+// a correlation of 0 with the other columns, zero columns a cosine of 0 ; the
+// diagonal is always the value of two identical columns (1 for the
+// similarities, 0 for the distances).
+class DistanceKernels {
+public:
+	enum Mode {
+		//Double precision, bits for binary data (exact)
+		NATIVE,
+		//Single precision for non-binary data
+		NATIVE_FLOAT,
+		//Every matrix is computed by ClusterXX
+		CLUSTERXX
+	};
+
+	//Only 0s and 1s : scanned once by the caller, for both calls below
+	static bool isBinary(const Eigen::MatrixXd &data);
+	//Jaccard is only native on binary data
+	static bool isSupported(const std::string &metricName, bool binaryData,
+			Mode mode = NATIVE);
+	//Same matrix as ClusterXX::buildMetric(metricName)->computeMatrix(data).
+	//Throws std::invalid_argument when the metric is not supported.
+	static Eigen::MatrixXd computeMatrix(const std::string &metricName,
+			const Eigen::MatrixXd &data, bool binaryData, Mode mode = NATIVE,
+			bool verbose = false);
+};
+
+#endif /* SRC_TCGA_ANALYZER_DISTANCEKERNELS_HPP_ */
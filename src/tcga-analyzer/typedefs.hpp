@@ -9,6 +9,7 @@
 #define SRC_TYPEDEFS_HPP_
 
 #include <unordered_map>
+#include <map>
 #include <vector>
 
 class tcga_data_exception: public std::exception {
@@ -0,0 +1,151 @@
+/*
+ * differentialAnalyzerTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <vector>
+#include <limits>
+#include <numeric>
+#include "../tcga-analyzer/TCGADataDifferentialAnalyzer.hpp"
+
+namespace {
+
+//log2(1 + expression) of the genes, tumor samples then control samples
+const std::vector<std::pair<std::vector<double>, std::vector<double>>> GENES = {
+		{ { 1, 2, 3, 4, 5 }, { 3, 4, 5, 6, 7, 8 } },
+		//Ties within and across the classes
+		{ { 1.5, 2.5, 2, 3, 1 }, { 2, 2, 3, 3, 4, 4 } },
+		//Constant
+		{ { 2, 2, 2, 2, 2 }, { 2, 2, 2, 2, 2, 2 } },
+		//Constant in each class
+		{ { 1, 1, 1, 1, 1 }, { 2, 2, 2, 2, 2, 2 } },
+		{ { 0.2, 0.1, 0.4, 0.3, 0.5 }, { 0.35, 0.15, 0.25, 0.45, 0.05, 0.65 } } };
+
+//Reference values (R : t.test, and wilcox.test with exact = FALSE, then
+//p.adjust with method "BH"), computed independently with an integral of the
+//Student density
+const double WELCH_T[] = { -2.4019223070763065, -1.9674775073518591, 0.0,
+		-std::numeric_limits<double>::infinity(), -0.14744195615489708 };
+const double WELCH_DEGREES_OF_FREEDOM[] = { 8.989361702127662,
+		8.943694741740341, 9, 9, 8.898233809924307 };
+const double WELCH_P[] = { 0.03980308202413539, 0.08087034740198613, 1.0, 0.0,
+		0.8860699001921656 };
+const double WELCH_Q[] = { 0.09950770506033849, 0.13478391233664355, 1.0, 0.0,
+		1.0 };
+const double MANN_WHITNEY_U[] = { 4.5, 6.0, 15.0, 0.0, 15.0 };
+const double MANN_WHITNEY_P[] = { 0.06601543152123106, 0.11304997885632297,
+		1.0, 0.00223662444520987, 1.0 };
+const double MANN_WHITNEY_Q[] = { 0.16503857880307765, 0.18841663142720497,
+		1.0, 0.01118312222604935, 1.0 };
+
+const unsigned int TUMOR_SAMPLES = 5;
+const unsigned int CONTROL_SAMPLES = 6;
+
+//The BRCA samples alternate, tumor first ; extra LUAD tumor and control
+//samples take the values of the first BRCA ones
+void fillData(TCGAData *data, unsigned int luadTumors,
+		unsigned int luadControls) {
+	std::vector<std::pair<bool, unsigned int>> samples;
+	for (unsigned int i = 0; i < TUMOR_SAMPLES + CONTROL_SAMPLES; ++i) {
+		bool tumor = i % 2 == 0 && i / 2 < TUMOR_SAMPLES;
+		unsigned int index = tumor ? i / 2 : i - std::min(i / 2 + 1, TUMOR_SAMPLES);
+		samples.emplace_back(tumor, index);
+		data->getPatientsHandler().emplace_back("BRCA" + std::to_string(i),
+				"BRCA", tumor);
+	}
+	for (unsigned int i = 0; i < luadTumors + luadControls; ++i) {
+		bool tumor = i < luadTumors;
+		samples.emplace_back(tumor, tumor ? i : i - luadTumors);
+		data->getPatientsHandler().emplace_back("LUAD" + std::to_string(i),
+				"LUAD", tumor);
+	}
+	for (unsigned int j = 0; j < GENES.size(); ++j) {
+		data->getGeneListHandler().emplace_back("GENE" + std::to_string(j), j);
+		std::vector<double> row;
+		for (const auto &sample : samples) {
+			double value =
+					sample.first ?
+							GENES[j].first[sample.second] :
+							GENES[j].second[sample.second];
+			row.push_back(std::exp2(value) - 1.0);
+		}
+		data->getDataHandler().push_back(row);
+	}
+}
+
+}
+
+TEST(differentialTumorVersusControl) {
+	TCGAData data;
+	fillData(&data, 0, 0);
+	TCGADataDifferentialAnalyzer analyzer(&data, TUMOR_VERSUS_CONTROL, false);
+	analyzer.compute();
+	CHECK(analyzer.getComparisons().size() == 1);
+	if (analyzer.getComparisons().size() != 1) {
+		return;
+	}
+	const ClassComparison &comparison = analyzer.getComparisons()[0];
+	CHECK(comparison.name == "BRCA_Tumor_vs_BRCA_Control");
+	CHECK(comparison.samplesA.size() == TUMOR_SAMPLES);
+	CHECK(comparison.samplesB.size() == CONTROL_SAMPLES);
+
+	for (unsigned int j = 0; j < GENES.size(); ++j) {
+		const GeneStatistics &statistics = comparison.statistics[j];
+		const auto &gene = GENES[j];
+		double meanA = std::accumulate(gene.first.begin(), gene.first.end(), 0.0)
+				/ gene.first.size();
+		double meanB = std::accumulate(gene.second.begin(), gene.second.end(),
+				0.0) / gene.second.size();
+		CHECK_CLOSE(statistics.log2FoldChange, meanA - meanB, 1e-12);
+		if (std::isinf(WELCH_T[j])) {
+			CHECK(statistics.welchT == WELCH_T[j]);
+		} else {
+			CHECK_CLOSE(statistics.welchT, WELCH_T[j], 1e-10);
+		}
+		CHECK_CLOSE(statistics.welchDegreesOfFreedom,
+				WELCH_DEGREES_OF_FREEDOM[j], 1e-10);
+		CHECK_CLOSE(statistics.welchP, WELCH_P[j], 1e-9);
+		CHECK_CLOSE(statistics.welchQ, WELCH_Q[j], 1e-9);
+		CHECK(statistics.mannWhitneyU == MANN_WHITNEY_U[j]);
+		CHECK_CLOSE(statistics.mannWhitneyP, MANN_WHITNEY_P[j], 1e-12);
+		CHECK_CLOSE(statistics.mannWhitneyQ, MANN_WHITNEY_Q[j], 1e-12);
+	}
+}
+
+TEST(differentialAllClassPairs) {
+	//LUAD_Control has a single sample : its comparisons are skipped
+	TCGAData data;
+	fillData(&data, 3, 1);
+	TCGADataDifferentialAnalyzer analyzer(&data, ALL_CLASS_PAIRS, false);
+	analyzer.compute();
+	const std::vector<ClassComparison> &comparisons = analyzer.getComparisons();
+	CHECK(comparisons.size() == 3);
+	if (comparisons.size() != 3) {
+		return;
+	}
+	CHECK(comparisons[0].name == "BRCA_Control_vs_BRCA_Tumor");
+	CHECK(comparisons[1].name == "BRCA_Control_vs_LUAD_Tumor");
+	CHECK(comparisons[2].name == "BRCA_Tumor_vs_LUAD_Tumor");
+
+	//Classes swapped : same p-values, opposite statistics
+	const std::vector<GeneStatistics> &statistics = comparisons[0].statistics;
+	for (unsigned int j = 0; j < GENES.size(); ++j) {
+		CHECK_CLOSE(statistics[j].welchP, WELCH_P[j], 1e-9);
+		if (std::isinf(WELCH_T[j])) {
+			CHECK(statistics[j].welchT == -WELCH_T[j]);
+		} else {
+			CHECK_CLOSE(statistics[j].welchT, -WELCH_T[j], 1e-10);
+		}
+		CHECK(statistics[j].mannWhitneyU
+				== TUMOR_SAMPLES * CONTROL_SAMPLES - MANN_WHITNEY_U[j]);
+		CHECK_CLOSE(statistics[j].mannWhitneyP, MANN_WHITNEY_P[j], 1e-12);
+	}
+
+	TCGADataDifferentialAnalyzer tumorVersusControl(&data,
+			TUMOR_VERSUS_CONTROL, false);
+	tumorVersusControl.compute();
+	CHECK(tumorVersusControl.getComparisons().size() == 1);
+}
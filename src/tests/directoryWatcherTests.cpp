@@ -0,0 +1,42 @@
+/*
+ * directoryWatcherTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <fstream>
+#include <vector>
+#include "../heinz-analyzer/directoryWatcher.hpp"
+
+TEST(directoryWatcherWrittenFiles) {
+	TemporaryDirectory directory;
+	DirectoryWatcher watcher( { directory.getPath() + "/" });
+	if (watcher.isPolling()) {
+		return;
+	}
+	std::ofstream(directory.file("module.txt")) << "graph {}\n";
+	bool overflowed = true;
+	std::vector<std::string> files = watcher.waitForFiles(1000, &overflowed);
+	CHECK(!overflowed);
+	CHECK(files == std::vector<std::string>( { directory.file("module.txt") }));
+}
+
+TEST(directoryWatcherQueueOverflow) {
+	TemporaryDirectory directory;
+	DirectoryWatcher watcher( { directory.getPath() + "/" });
+	if (watcher.isPolling()) {
+		return;
+	}
+	//More events than the kernel queues (16384 by default)
+	unsigned int maxQueuedEvents = 16384;
+	std::ifstream("/proc/sys/fs/inotify/max_queued_events") >> maxQueuedEvents;
+	for (unsigned int i = 0; i <= maxQueuedEvents; ++i) {
+		std::ofstream(directory.file(std::to_string(i)));
+	}
+	bool overflowed = false;
+	std::vector<std::string> files = watcher.waitForFiles(1000, &overflowed);
+	CHECK(overflowed);
+	CHECK(files.size() < maxQueuedEvents + 1);
+}
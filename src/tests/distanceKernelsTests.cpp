@@ -0,0 +1,167 @@
+/*
+ * distanceKernelsTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <random>
+#include <stdexcept>
+#include <Eigen/Dense>
+#include <ClusterXX/metrics/metrics.hpp>
+#include "../config.hpp"
+#include "../tcga-analyzer/distanceKernels.hpp"
+
+namespace {
+
+//Not a multiple of the column blocks of the kernels
+const unsigned int ROWS = 203;
+const unsigned int COLUMNS = 37;
+
+//Continuous values without ties
+Eigen::MatrixXd buildDenseData() {
+	std::mt19937 generator(11);
+	std::normal_distribution<double> distribution(1.0, 2.0);
+	Eigen::MatrixXd data(ROWS, COLUMNS);
+	for (unsigned int j = 0; j < COLUMNS; ++j) {
+		for (unsigned int i = 0; i < ROWS; ++i) {
+			data(i, j) = distribution(generator);
+		}
+	}
+	return data;
+}
+
+//No column is empty or full
+Eigen::MatrixXd buildBinaryData() {
+	std::mt19937 generator(13);
+	std::bernoulli_distribution distribution(0.3);
+	Eigen::MatrixXd data(ROWS, COLUMNS);
+	for (unsigned int j = 0; j < COLUMNS; ++j) {
+		for (unsigned int i = 0; i < ROWS; ++i) {
+			data(i, j) = distribution(generator) ? 1.0 : 0.0;
+		}
+		data(j % ROWS, j) = 1.0;
+		data((j + 1) % ROWS, j) = 0.0;
+	}
+	return data;
+}
+
+//Largest difference relative to the magnitude of the reference entry
+double maximumError(const Eigen::MatrixXd &actual,
+		const Eigen::MatrixXd &expected) {
+	return ((actual - expected).array().abs()
+			/ expected.array().abs().max(1.0)).maxCoeff();
+}
+
+void checkAgainstClusterXX(const Eigen::MatrixXd &data, bool binaryData,
+		DistanceKernels::Mode mode, double tolerance) {
+	for (const std::string &metricName : ALLOWED_METRICS) {
+		if (!DistanceKernels::isSupported(metricName, binaryData, mode)) {
+			continue;
+		}
+		Eigen::MatrixXd expected = ClusterXX::buildMetric(metricName)->computeMatrix(
+				data);
+		Eigen::MatrixXd actual = DistanceKernels::computeMatrix(metricName,
+				data, binaryData, mode);
+		bool sameSize = actual.rows() == COLUMNS && actual.cols() == COLUMNS;
+		CHECK(sameSize);
+		if (!sameSize) {
+			continue;
+		}
+		double error = maximumError(actual, expected);
+		if (!(error <= tolerance)) {
+			TestRegistry::fail(__FILE__, __LINE__,
+					metricName + " differs from ClusterXX by "
+							+ std::to_string(error));
+		}
+	}
+}
+
+}
+
+TEST(distanceKernelsSupport) {
+	Eigen::MatrixXd dense = buildDenseData();
+	Eigen::MatrixXd binary = buildBinaryData();
+	CHECK(!DistanceKernels::isBinary(dense));
+	CHECK(DistanceKernels::isBinary(binary));
+
+	for (const std::string &metricName : ALLOWED_METRICS) {
+		bool binaryOnly = metricName.find("jaccard") != std::string::npos;
+		CHECK(DistanceKernels::isSupported(metricName, true));
+		CHECK(DistanceKernels::isSupported(metricName, false) != binaryOnly);
+		CHECK(DistanceKernels::isSupported(metricName, false,
+				DistanceKernels::NATIVE_FLOAT) != binaryOnly);
+		CHECK(!DistanceKernels::isSupported(metricName, true,
+				DistanceKernels::CLUSTERXX));
+	}
+	CHECK(!DistanceKernels::isSupported("unknown", true));
+	CHECK_THROWS(DistanceKernels::computeMatrix("unknown", dense, false),
+			std::invalid_argument);
+	CHECK_THROWS(DistanceKernels::computeMatrix("pearson", dense, false,
+			DistanceKernels::CLUSTERXX), std::invalid_argument);
+}
+
+TEST(distanceKernelsMatchClusterXXDense) {
+	checkAgainstClusterXX(buildDenseData(), false, DistanceKernels::NATIVE,
+			1e-10);
+}
+
+TEST(distanceKernelsMatchClusterXXFloat) {
+	checkAgainstClusterXX(buildDenseData(), false,
+			DistanceKernels::NATIVE_FLOAT, 1e-4);
+}
+
+TEST(distanceKernelsMatchClusterXXBinary) {
+	checkAgainstClusterXX(buildBinaryData(), true, DistanceKernels::NATIVE,
+			1e-10);
+	//The dense kernels give the same matrices on binary data
+	Eigen::MatrixXd binary = buildBinaryData();
+	for (const std::string &metricName : ALLOWED_METRICS) {
+		if (DistanceKernels::isSupported(metricName, false)) {
+			double error = maximumError(
+					DistanceKernels::computeMatrix(metricName, binary, false),
+					DistanceKernels::computeMatrix(metricName, binary, true));
+			if (!(error <= 1e-10)) {
+				TestRegistry::fail(__FILE__, __LINE__,
+						metricName + " differs between bits and doubles by "
+								+ std::to_string(error));
+			}
+		}
+	}
+}
+
+TEST(distanceKernelsConstantColumns) {
+	Eigen::MatrixXd dense = buildDenseData();
+	dense.col(3).setConstant(2.5);
+	Eigen::MatrixXd binary = buildBinaryData();
+	binary.col(4).setZero();
+	binary.col(5).setOnes();
+
+	for (const char *metricName : { "pearson", "spearman" }) {
+		Eigen::MatrixXd matrix = DistanceKernels::computeMatrix(metricName,
+				dense, false);
+		CHECK(matrix(3, 3) == 1.0);
+		CHECK(matrix(3, 0) == 0.0 && matrix(0, 3) == 0.0);
+		matrix = DistanceKernels::computeMatrix(metricName, binary, true);
+		CHECK(matrix(4, 4) == 1.0 && matrix(5, 5) == 1.0);
+		CHECK(matrix(4, 0) == 0.0 && matrix(5, 0) == 0.0 && matrix(5, 4) == 0.0);
+	}
+	//Only zero columns have a cosine of 0
+	for (bool binaryData : { false, true }) {
+		Eigen::MatrixXd data = binaryData ? binary : dense;
+		data.col(6).setZero();
+		Eigen::MatrixXd matrix = DistanceKernels::computeMatrix("cosine", data,
+				binaryData);
+		CHECK(matrix(6, 6) == 1.0);
+		CHECK(matrix(6, 0) == 0.0 && matrix(0, 6) == 0.0);
+		CHECK(matrix.allFinite());
+	}
+	Eigen::MatrixXd distances = DistanceKernels::computeMatrix(
+			"pearson-distance", binary, true);
+	CHECK(distances(4, 4) == 0.0 && distances(5, 5) == 0.0);
+	CHECK(distances(4, 0) == 1.0 && distances(5, 4) == 1.0);
+	CHECK(distances.diagonal().isZero(0.0));
+	CHECK(DistanceKernels::computeMatrix("jaccard", binary, true)(4, 4) == 1.0);
+	CHECK(DistanceKernels::computeMatrix("euclidean", dense, false).diagonal().isZero(0.0));
+}
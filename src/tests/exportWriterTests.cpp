@@ -0,0 +1,80 @@
+/*
+ * exportWriterTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <sys/resource.h>
+#include "../utilities.hpp"
+#include "../exportWriter.hpp"
+
+namespace {
+
+//Lowers the soft limit of open descriptors for the lifetime of the object
+class DescriptorLimit {
+public:
+	explicit DescriptorLimit(rlim_t limit) {
+		getrlimit(RLIMIT_NOFILE, &previous);
+		rlimit lowered = previous;
+		lowered.rlim_cur = std::min(limit, previous.rlim_max);
+		setrlimit(RLIMIT_NOFILE, &lowered);
+	}
+	~DescriptorLimit() {
+		setrlimit(RLIMIT_NOFILE, &previous);
+	}
+
+private:
+	rlimit previous;
+};
+
+//Many more files than descriptors, written by the background thread
+void checkManyFiles(bool sync, unsigned int numberOfFiles) {
+	TemporaryDirectory directory;
+	{
+		DescriptorLimit limit(512);
+		ExportWriter::start(64 << 20, sync);
+		for (unsigned int i = 0; i < numberOfFiles; ++i) {
+			ExportWriter::write(directory.file(std::to_string(i)),
+					std::to_string(i));
+		}
+		bool thrown = false;
+		try {
+			ExportWriter::finish();
+		} catch (const std::runtime_error &) {
+			thrown = true;
+		}
+		CHECK(!thrown);
+	}
+	for (unsigned int i = 0; i < numberOfFiles; ++i) {
+		CHECK(readFileContent(directory.file(std::to_string(i)))
+				== std::to_string(i));
+	}
+}
+
+}
+
+TEST(exportWriterManyFiles) {
+	checkManyFiles(false, 5000);
+}
+
+TEST(exportWriterManyFilesSync) {
+	checkManyFiles(true, 1000);
+}
+
+TEST(exportWriterPendingAppends) {
+	TemporaryDirectory directory;
+	std::string filename = directory.file("results.tsv");
+	ExportWriter::start(64 << 20);
+	CHECK(!ExportWriter::exists(filename));
+	//Queued or already written, the file is there for the next writer
+	ExportWriter::write(filename, "HEADER\n", true);
+	CHECK(ExportWriter::exists(filename));
+	ExportWriter::write(filename, "ROW\n", true);
+	ExportWriter::finish();
+	CHECK(readFileContent(filename) == "HEADER\nROW\n");
+	CHECK(!ExportWriter::exists(directory.file("missing.tsv")));
+}
@@ -0,0 +1,176 @@
+/*
+ * graphSnapshotTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <fstream>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+#include "../utilities.hpp"
+#include "../tcga-analyzer/typedefs.hpp"
+#include "../heinz-analyzer/graph.hpp"
+
+namespace {
+
+//A ring of n labelled nodes with chords, and an isolated node
+void writeGraphFiles(const std::string &nodesFile, const std::string &edgesFile,
+		unsigned int n) {
+	std::ofstream nodes(nodesFile);
+	for (unsigned int i = 0; i < n; ++i) {
+		nodes << "GENE" << i << " " << i * 0.5 - 3.0 << "\n";
+	}
+	nodes << "ISOLATED -1.25\n";
+	std::ofstream edges(edgesFile);
+	for (unsigned int i = 0; i < n; ++i) {
+		edges << "GENE" << i << " GENE" << (i + 1) % n << "\n";
+		if (i % 7 == 0) {
+			edges << "GENE" << i << " GENE" << (i * 3 + 2) % n << "\n";
+		}
+	}
+}
+
+std::multiset<std::string> getNeighborNames(const PPIGraph &graph,
+		PPIGraph::NodeIDType id) {
+	std::multiset<std::string> names;
+	for (auto it = graph.neighborsBegin(id); it != graph.neighborsEnd(id);
+			++it) {
+		names.insert(graph.getNodeName(*it));
+	}
+	return names;
+}
+
+void checkSameGraph(const PPIGraph &actual, const PPIGraph &expected) {
+	CHECK(actual.size() == expected.size());
+	CHECK(actual.edgeCount() == expected.edgeCount());
+	if (actual.size() != expected.size()) {
+		return;
+	}
+	for (unsigned int u = 0; u < expected.size(); ++u) {
+		std::string name = expected.getNodeName(u);
+		CHECK(actual.getNodeName(u) == name);
+		CHECK(actual.getNodeId(name) == u);
+		CHECK(actual.getNodeValue(u) == expected.getNodeValue(u));
+		CHECK(actual.getOutDegree(u) == expected.getOutDegree(u));
+		CHECK(getNeighborNames(actual, u) == getNeighborNames(expected, u));
+	}
+}
+
+}
+
+TEST(graphSnapshotRoundTrip) {
+	TemporaryDirectory directory;
+	std::string nodesFile = directory.file("nodes.txt");
+	std::string edgesFile = directory.file("edges.txt");
+	std::string snapshotFile = directory.file("edges.txt.snapshot");
+	writeGraphFiles(nodesFile, edgesFile, 100);
+
+	std::shared_ptr<PPIGraph> graph = PPIGraph::buildFromTextFiles(nodesFile,
+			edgesFile, true);
+	CHECK(graph->size() == 101);
+	CHECK(graph->getNodeValue("GENE10") == 2.0);
+	CHECK(graph->getOutDegree("ISOLATED") == 0);
+	CHECK(!graph->hasNode("GENE100"));
+
+	graph->saveSnapshot(snapshotFile, nodesFile, edgesFile, true);
+	std::shared_ptr<PPIGraph> loaded = PPIGraph::loadSnapshot(snapshotFile,
+			nodesFile, edgesFile, true);
+	CHECK(loaded != nullptr);
+	if (loaded) {
+		checkSameGraph(*loaded, *graph);
+		PPIGraph::NodeIDType id;
+		CHECK(!loaded->findNode("GENE100", &id));
+		CHECK(loaded->findNode("ISOLATED", &id) && id == 100);
+	}
+	//buildFromFile reads the snapshot next to the edges file
+	checkSameGraph(*PPIGraph::buildFromFile(nodesFile, edgesFile, true), *graph);
+}
+
+TEST(graphSnapshotConcurrentSaves) {
+	TemporaryDirectory directory;
+	std::string nodesFile = directory.file("nodes.txt");
+	std::string edgesFile = directory.file("edges.txt");
+	std::string snapshotFile = directory.file("edges.txt.snapshot");
+	writeGraphFiles(nodesFile, edgesFile, 1000);
+	std::shared_ptr<PPIGraph> graph = PPIGraph::buildFromTextFiles(nodesFile,
+			edgesFile, true);
+
+	//Each writer has its own temporary file, the last rename wins
+	std::vector<std::thread> writers;
+	for (unsigned int i = 0; i < 8; ++i) {
+		writers.emplace_back([&]() {
+			graph->saveSnapshot(snapshotFile, nodesFile, edgesFile, true);
+		});
+	}
+	for (std::thread &writer : writers) {
+		writer.join();
+	}
+	std::shared_ptr<PPIGraph> loaded = PPIGraph::loadSnapshot(snapshotFile,
+			nodesFile, edgesFile, true);
+	CHECK(loaded != nullptr);
+	if (loaded) {
+		checkSameGraph(*loaded, *graph);
+	}
+
+	std::set<std::string> files;
+	DIR *dir = opendir(directory.getPath().c_str());
+	CHECK(dir != nullptr);
+	while (dir) {
+		dirent *entry = readdir(dir);
+		if (!entry) {
+			closedir(dir);
+			break;
+		}
+		std::string name = entry->d_name;
+		if (name != "." && name != "..") {
+			files.insert(name);
+		}
+	}
+	CHECK(files == std::set<std::string>( { "nodes.txt", "edges.txt",
+			"edges.txt.snapshot" }));
+}
+
+TEST(graphSnapshotOutOfDate) {
+	TemporaryDirectory directory;
+	std::string nodesFile = directory.file("nodes.txt");
+	std::string edgesFile = directory.file("edges.txt");
+	std::string snapshotFile = directory.file("edges.txt.snapshot");
+	writeGraphFiles(nodesFile, edgesFile, 20);
+	PPIGraph::buildFromTextFiles(nodesFile, edgesFile, true)->saveSnapshot(
+			snapshotFile, nodesFile, edgesFile, true);
+
+	//Another labelling, then other text files
+	CHECK(PPIGraph::loadSnapshot(snapshotFile, nodesFile, edgesFile, false) == nullptr);
+	writeGraphFiles(nodesFile, edgesFile, 30);
+	CHECK(PPIGraph::loadSnapshot(snapshotFile, nodesFile, edgesFile, true) == nullptr);
+	CHECK(PPIGraph::loadSnapshot(directory.file("missing.snapshot"), nodesFile,
+			edgesFile, true) == nullptr);
+
+	//Rebuilt from the new text files
+	std::shared_ptr<PPIGraph> graph = PPIGraph::buildFromFile(nodesFile,
+			edgesFile, true);
+	CHECK(graph->size() == 31);
+	CHECK(PPIGraph::loadSnapshot(snapshotFile, nodesFile, edgesFile, true) != nullptr);
+}
+
+TEST(graphSnapshotCorrupt) {
+	TemporaryDirectory directory;
+	std::string nodesFile = directory.file("nodes.txt");
+	std::string edgesFile = directory.file("edges.txt");
+	std::string snapshotFile = directory.file("edges.txt.snapshot");
+	writeGraphFiles(nodesFile, edgesFile, 100);
+	PPIGraph::buildFromTextFiles(nodesFile, edgesFile, true)->saveSnapshot(
+			snapshotFile, nodesFile, edgesFile, true);
+
+	std::string content = readFileContent(snapshotFile);
+	CHECK(truncate(snapshotFile.c_str(), content.size() / 2) == 0);
+	CHECK_THROWS(
+			PPIGraph::loadSnapshot(snapshotFile, nodesFile, edgesFile, true),
+			tcga_data_exception);
+}
@@ -0,0 +1,135 @@
+/*
+ * heinzOutputAnalyzerTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <omp.h>
+#include <unistd.h>
+#include "../config.hpp"
+#include "../utilities.hpp"
+#include "../heinz-analyzer/graph.hpp"
+#include "../heinz-analyzer/heinzOutputAnalyzer.hpp"
+
+namespace {
+
+const unsigned int NUMBER_OF_GENES = 200;
+
+//Runs in directory, where the data/ layout is created
+class WorkingDirectory {
+public:
+	explicit WorkingDirectory(const std::string &directory) {
+		char *current = getcwd(nullptr, 0);
+		previous = current;
+		free(current);
+		if (chdir(directory.c_str()) != 0) {
+			throw std::runtime_error("Cannot enter " + directory);
+		}
+	}
+	~WorkingDirectory() {
+		if (chdir(previous.c_str()) != 0) {
+			std::cerr << "Cannot go back to " << previous << std::endl;
+		}
+	}
+
+private:
+	std::string previous;
+};
+
+std::shared_ptr<const PPIGraph> writeGraph() {
+	makeDirectory("data");
+	makeDirectory(GRAPH_DATA_DIRECTORY);
+	std::ofstream nodes(GRAPH_DATA_DIRECTORY + "nodes.txt");
+	std::ofstream edges(GRAPH_DATA_DIRECTORY + "edges.txt");
+	for (unsigned int i = 0; i < NUMBER_OF_GENES; ++i) {
+		nodes << "GENE" << i << " 0\n";
+		edges << "GENE" << i << " GENE" << (i + 1) % NUMBER_OF_GENES << "\n";
+	}
+	nodes.close();
+	edges.close();
+	return PPIGraph::buildFromTextFiles(GRAPH_DATA_DIRECTORY + "nodes.txt",
+			GRAPH_DATA_DIRECTORY + "edges.txt", true);
+}
+
+//A random module in Heinz DOT output, genes negative a third of the time
+void writeModule(const std::string &weight, const std::string &patientID,
+		std::mt19937 &generator) {
+	std::ofstream output(
+			HEINZ_RAW_OUTPUT_DIRECTORY + weight + "/" + weight + "_" + patientID
+					+ ".txt");
+	std::uniform_int_distribution<unsigned int> gene(0, NUMBER_OF_GENES - 1);
+	unsigned int size = generator() % 30;
+	output << "graph G {\n";
+	for (unsigned int i = 0; i < size; ++i) {
+		output << i << " [label=\"GENE" << gene(generator) << "\\n"
+				<< (generator() % 3 == 0 ? "-1" : "1") << "\\n\"];\n";
+	}
+	for (unsigned int i = 1; i < size; ++i) {
+		output << i - 1 << " -- " << i << "\n";
+	}
+	output << "}\n";
+}
+
+}
+
+TEST(heinzOutputAnalyzerParallelMatchesSerial) {
+	TemporaryDirectory directory;
+	WorkingDirectory workingDirectory(directory.getPath());
+	std::shared_ptr<const PPIGraph> graph = writeGraph();
+	makeDirectory(HEINZ_DIRECTORY);
+	makeDirectory(HEINZ_RAW_OUTPUT_DIRECTORY);
+
+	std::vector<WeightType> weights = { "1", "2", "3" };
+	std::vector<std::string> patientIDs;
+	for (const std::string cancer : { "BRCA", "LUAD" }) {
+		for (unsigned int i = 0; i < 40; ++i) {
+			patientIDs.push_back(
+					cancer + (i % 4 == 0 ? "_Control_" : "_Tumor_") + "P"
+							+ std::to_string(i));
+		}
+	}
+	std::mt19937 generator(7);
+	for (const auto &weight : weights) {
+		makeDirectory(HEINZ_RAW_OUTPUT_DIRECTORY + weight);
+		for (const auto &patientID : patientIDs) {
+			writeModule(weight, patientID, generator);
+		}
+	}
+
+	HeinzOutputAnalyzer parallel(weights, patientIDs, graph, false);
+	HeinzOutputAnalyzer serial(weights, patientIDs, graph, false);
+	int threads = omp_get_max_threads();
+	omp_set_num_threads(4);
+	std::ostringstream report;
+	std::streambuf *coutBuffer = std::cout.rdbuf(report.rdbuf());
+	parallel.analyze();
+	std::cout.rdbuf(coutBuffer);
+	omp_set_num_threads(threads);
+	for (const auto &weight : weights) {
+		for (const auto &patientID : patientIDs) {
+			serial.analyzeModule(weight + "_" + patientID);
+		}
+	}
+
+	const HeinzStatistics &actual = parallel.getStatistics();
+	const HeinzStatistics &expected = serial.getStatistics();
+	CHECK(actual.getNumberOfClasses() == 12);
+	for (HeinzStatistics::ClassIDType c = 0;
+			c < expected.getNumberOfClasses(); ++c) {
+		CHECK(actual.getClassCount(c) == expected.getClassCount(c));
+		CHECK(actual.getMeanDegrees(c) == expected.getMeanDegrees(c));
+		for (unsigned int gene = 0; gene < NUMBER_OF_GENES; ++gene) {
+			CHECK(actual.getNegativeGeneCount(c, gene)
+					== expected.getNegativeGeneCount(c, gene));
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/*
+ * main.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <cstdlib>
+#include <ftw.h>
+#include <unistd.h>
+
+namespace {
+
+std::vector<std::pair<std::string, std::function<void()>>> &getTests() {
+	static std::vector<std::pair<std::string, std::function<void()>>> tests;
+	return tests;
+}
+
+unsigned int currentFailures = 0;
+
+int removeEntry(const char *path, const struct stat *, int, struct FTW *) {
+	return ::remove(path);
+}
+
+}
+
+bool TestRegistry::add(const std::string &name,
+		const std::function<void()> &test) {
+	getTests().emplace_back(name, test);
+	return true;
+}
+
+void TestRegistry::fail(const char *file, int line,
+		const std::string &message) {
+	std::cout << "  " << file << ":" << line << " : " << message << std::endl;
+	++currentFailures;
+}
+
+unsigned int TestRegistry::run(const std::string &filter) {
+	unsigned int numberOfTests = 0;
+	unsigned int failedTests = 0;
+	for (const auto &test : getTests()) {
+		if (test.first.find(filter) == std::string::npos) {
+			continue;
+		}
+		std::cout << "* " << test.first << std::endl;
+		currentFailures = 0;
+		try {
+			test.second();
+		} catch (const std::exception &e) {
+			std::cout << "  Exception : " << e.what() << std::endl;
+			++currentFailures;
+		}
+		++numberOfTests;
+		if (currentFailures > 0) {
+			std::cout << "  FAILED" << std::endl;
+			++failedTests;
+		}
+	}
+	std::cout << numberOfTests << " tests, " << failedTests << " failed."
+			<< std::endl;
+	return failedTests;
+}
+
+TemporaryDirectory::TemporaryDirectory() {
+	const char *base = std::getenv("TMPDIR");
+	std::string pattern = std::string(base ? base : "/tmp")
+			+ "/tcga-tests-XXXXXX";
+	std::vector<char> buffer(pattern.begin(), pattern.end());
+	buffer.push_back('\0');
+	if (mkdtemp(buffer.data()) == nullptr) {
+		throw std::runtime_error("Cannot create a directory from " + pattern);
+	}
+	path = buffer.data();
+}
+
+TemporaryDirectory::~TemporaryDirectory() {
+	nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+//Usage : TCGA-Analyzer-tests [filter]
+int main(int argc, char *argv[]) {
+	return TestRegistry::run(argc > 1 ? argv[1] : "") == 0 ? 0 : 1;
+}
@@ -0,0 +1,66 @@
+/*
+ * memoryTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <sstream>
+#include <thread>
+#include "../memory.hpp"
+
+namespace {
+
+//Line of the report for a stage, empty if absent
+std::string getReportLine(const std::string &stage) {
+	std::ostringstream report;
+	MemoryMonitor::printReport(report);
+	std::istringstream lines(report.str());
+	std::string line;
+	while (std::getline(lines, line)) {
+		std::size_t start = line.find_first_not_of(' ');
+		if (start != std::string::npos
+				&& line.compare(start, stage.size() + 1, stage + " ") == 0) {
+			return line;
+		}
+	}
+	return "";
+}
+
+}
+
+TEST(memoryStagesOfConcurrentThreads) {
+	MemoryMonitor::enable();
+	{
+		MemoryStage outer("test/outer");
+		MemoryMonitor::track("outerContainer", 1 << 20);
+		std::thread worker([]() {
+			MemoryStage stage("test/worker");
+			MemoryMonitor::track("workerContainer", 2 << 20);
+		});
+		worker.join();
+	}
+	{
+		MemoryStage alone("test/alone");
+		MemoryStage nested("test/nested");
+		MemoryMonitor::track("nestedContainer", 3 << 20);
+	}
+
+	std::string outer = getReportLine("test/outer");
+	std::string worker = getReportLine("test/worker");
+	CHECK(outer.find("(*)") != std::string::npos);
+	CHECK(worker.find("(*)") != std::string::npos);
+	//Containers go to the stage of the thread that tracks them
+	CHECK(outer.find("outerContainer") != std::string::npos);
+	CHECK(outer.find("workerContainer") == std::string::npos);
+	CHECK(worker.find("workerContainer") != std::string::npos);
+	//The worker stage is not nested in the one of another thread
+	CHECK(worker.compare(0, 11, "test/worker") == 0);
+
+	std::string nested = getReportLine("test/nested");
+	CHECK(getReportLine("test/alone").find("(*)") == std::string::npos);
+	CHECK(nested.find("(*)") == std::string::npos);
+	CHECK(nested.compare(0, 13, "  test/nested") == 0);
+	CHECK(nested.find("nestedContainer") != std::string::npos);
+}
@@ -0,0 +1,156 @@
+/*
+ * positiveComponentsTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <functional>
+#include "../heinz-analyzer/graph.hpp"
+#include "../heinz-analyzer/positiveComponents.hpp"
+
+namespace {
+
+//positive[j][i] : gene j is positive in sample i
+void fillData(TCGAData *data, const std::vector<std::string> &genes,
+		const std::vector<std::vector<bool>> &positive) {
+	for (unsigned int j = 0; j < genes.size(); ++j) {
+		data->getGeneListHandler().emplace_back(genes[j], j);
+		std::vector<double> row;
+		for (bool value : positive[j]) {
+			row.push_back(value ? 1.0 : 0.0);
+		}
+		data->getDataHandler().push_back(row);
+	}
+	for (unsigned int i = 0; i < positive[0].size(); ++i) {
+		data->getPatientsHandler().emplace_back("SAMPLE" + std::to_string(i),
+				"BRCA", true);
+	}
+}
+
+//Breadth-first search over the positive genes, for comparison
+std::vector<unsigned int> referenceComponentSizes(const PPIGraph &graph,
+		const TCGAData &data, unsigned int sample) {
+	const Eigen::MatrixXd &matrix = data.getDataMatrixHandler();
+	const GeneList &genes = data.getGeneListHandler();
+	std::vector<bool> visited(genes.size(), false);
+	std::vector<unsigned int> sizes;
+	for (unsigned int j = 0; j < genes.size(); ++j) {
+		if (visited[j] || matrix(j, sample) <= 0.5) {
+			continue;
+		}
+		std::vector<unsigned int> queue = { j };
+		visited[j] = true;
+		for (unsigned int k = 0; k < queue.size(); ++k) {
+			PPIGraph::NodeIDType u;
+			if (!graph.findNode(genes[queue[k]].first, &u)) {
+				continue;
+			}
+			for (auto it = graph.neighborsBegin(u); it != graph.neighborsEnd(u);
+					++it) {
+				for (unsigned int row = 0; row < genes.size(); ++row) {
+					if (!visited[row] && matrix(row, sample) > 0.5
+							&& genes[row].first == graph.getNodeName(*it)) {
+						visited[row] = true;
+						queue.push_back(row);
+					}
+				}
+			}
+		}
+		sizes.push_back(queue.size());
+	}
+	std::sort(sizes.begin(), sizes.end(), std::greater<unsigned int>());
+	return sizes;
+}
+
+}
+
+TEST(positiveComponentsSmallGraph) {
+	//X is not in the graph, Z has no data
+	PPIGraphBuilder builder;
+	for (const char *name : { "A", "B", "C", "D", "E", "F", "G", "H", "Z" }) {
+		builder.addNode(name);
+	}
+	builder.addEdge("A", "B");
+	builder.addEdge("B", "C");
+	builder.addEdge("D", "E");
+	builder.addEdge("F", "G");
+	builder.addEdge("H", "Z");
+	std::shared_ptr<const PPIGraph> graph = builder.build();
+
+	TCGAData data;
+	//Samples : scattered, A and C without B, empty, everything
+	fillData(&data, { "A", "B", "C", "D", "E", "F", "G", "H", "X" }, {
+			{ 1, 1, 0, 1 }, { 1, 0, 0, 1 }, { 1, 1, 0, 1 }, { 1, 0, 0, 1 },
+			{ 1, 0, 0, 1 }, { 0, 1, 0, 1 }, { 0, 1, 0, 1 }, { 1, 0, 0, 1 },
+			{ 1, 0, 0, 0 } });
+	PositiveComponents components(&data, graph, false);
+	components.compute();
+	CHECK((components.getComponentSizes(0) == std::vector<unsigned int> { 3, 2, 1, 1 }));
+	CHECK((components.getComponentSizes(1) == std::vector<unsigned int> { 2, 1, 1 }));
+	CHECK(components.getComponentSizes(2).empty());
+	CHECK((components.getComponentSizes(3) == std::vector<unsigned int> { 3, 2, 2, 1 }));
+	CHECK((components.getEmptySamples() == std::vector<std::string> {
+			data.getPatientsHandler()[2].toString() }));
+
+	//H and X of sample 0, A and C of sample 1, H of sample 3
+	CHECK(components.shrink(2) == 5);
+	const Eigen::MatrixXd &matrix = data.getDataMatrixHandler();
+	CHECK(matrix(7, 0) == 0.0 && data.getDataHandler()[7][0] == 0.0);
+	CHECK(matrix(8, 0) == 0.0 && data.getDataHandler()[8][0] == 0.0);
+	CHECK(matrix(0, 1) == 0.0 && matrix(2, 1) == 0.0 && matrix(5, 1) == 1.0);
+	CHECK(matrix(0, 3) == 1.0 && matrix(7, 3) == 0.0);
+	CHECK((components.getComponentSizes(1) == std::vector<unsigned int> { 2 }));
+	CHECK(components.getEmptySamples().size() == 1);
+
+	//D and E of sample 0, F and G of sample 1, D to G of sample 3
+	CHECK(components.shrink(3) == 8);
+	CHECK((components.getComponentSizes(3) == std::vector<unsigned int> { 3 }));
+	CHECK((components.getEmptySamples() == std::vector<std::string> {
+			data.getPatientsHandler()[1].toString(),
+			data.getPatientsHandler()[2].toString() }));
+}
+
+TEST(positiveComponentsRandomGraph) {
+	std::mt19937 generator(7);
+	const unsigned int numberOfGenes = 300;
+	const unsigned int numberOfSamples = 12;
+	std::vector<std::string> genes;
+	PPIGraphBuilder builder;
+	for (unsigned int j = 0; j < numberOfGenes; ++j) {
+		genes.push_back("GENE" + std::to_string(j));
+		//One gene in ten is not in the graph
+		if (j % 10 != 0) {
+			builder.addNode(genes.back());
+		}
+	}
+	std::uniform_int_distribution<unsigned int> pick(0, numberOfGenes - 1);
+	for (unsigned int e = 0; e < 400; ++e) {
+		unsigned int j1 = pick(generator);
+		unsigned int j2 = pick(generator);
+		if (j1 % 10 != 0 && j2 % 10 != 0) {
+			builder.addEdge(genes[j1], genes[j2]);
+		}
+	}
+	std::shared_ptr<const PPIGraph> graph = builder.build();
+
+	std::bernoulli_distribution positiveDistribution(0.3);
+	std::vector<std::vector<bool>> positive(numberOfGenes);
+	for (auto &row : positive) {
+		for (unsigned int i = 0; i < numberOfSamples; ++i) {
+			row.push_back(positiveDistribution(generator));
+		}
+	}
+	TCGAData data;
+	fillData(&data, genes, positive);
+	PositiveComponents components(&data, graph, false);
+	components.compute();
+	for (unsigned int i = 0; i < numberOfSamples; ++i) {
+		CHECK(components.getComponentSizes(i)
+				== referenceComponentSizes(*graph, data, i));
+	}
+}
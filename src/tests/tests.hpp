@@ -0,0 +1,84 @@
+/*
+ * tests.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_TESTS_TESTS_HPP_
+#define SRC_TESTS_TESTS_HPP_
+
+#include <string>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+// Minimal test registry for the unit tests (run by ctest, see main.cpp).
+// TEST(name) defines a test case ; a failed CHECK is reported and the test
+// goes on, an exception fails the test and stops it.
+class TestRegistry {
+public:
+	static bool add(const std::string &name, const std::function<void()> &test);
+	static void fail(const char *file, int line, const std::string &message);
+	//Runs the tests whose name contains filter ; returns the number of failures
+	static unsigned int run(const std::string &filter);
+};
+
+//Empty directory for the files of a test, removed with its content on exit
+class TemporaryDirectory {
+public:
+	TemporaryDirectory();
+	~TemporaryDirectory();
+	TemporaryDirectory(const TemporaryDirectory &) = delete;
+	TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+	const std::string &getPath() const {
+		return path;
+	}
+	std::string file(const std::string &name) const {
+		return path + "/" + name;
+	}
+
+private:
+	std::string path;
+};
+
+#define TEST(name) \
+	static void test_##name(); \
+	static const bool test_##name##_registered = TestRegistry::add(#name, test_##name); \
+	static void test_##name()
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			TestRegistry::fail(__FILE__, __LINE__, #condition); \
+		} \
+	} while (0)
+
+//Relative to the expected value, absolute below 1
+#define CHECK_CLOSE(actual, expected, tolerance) \
+	do { \
+		double actualValue = (actual); \
+		double expectedValue = (expected); \
+		if (!(std::fabs(actualValue - expectedValue) <= (tolerance) \
+				* std::max(1.0, std::fabs(expectedValue)))) { \
+			TestRegistry::fail(__FILE__, __LINE__, #actual " = " \
+					+ std::to_string(actualValue) + ", expected " \
+					+ std::to_string(expectedValue)); \
+		} \
+	} while (0)
+
+#define CHECK_THROWS(statement, exception) \
+	do { \
+		bool thrown = false; \
+		try { \
+			statement; \
+		} catch (const exception &) { \
+			thrown = true; \
+		} \
+		if (!thrown) { \
+			TestRegistry::fail(__FILE__, __LINE__, \
+					#statement " does not throw " #exception); \
+		} \
+	} while (0)
+
+#endif /* SRC_TESTS_TESTS_HPP_ */
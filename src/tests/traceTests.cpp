@@ -0,0 +1,63 @@
+/*
+ * traceTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "tests.hpp"
+
+#include <limits>
+#include <sstream>
+#include <thread>
+#include "../utilities.hpp"
+#include "../trace.hpp"
+
+namespace {
+
+std::string getSummary() {
+	std::ostringstream summary;
+	Trace::printSummary(summary);
+	return summary.str();
+}
+
+//Value printed for counter by Trace::printSummary, -1 if absent
+long long getSummaryTotal(const std::string &counter) {
+	std::istringstream lines(getSummary());
+	std::string name;
+	long long value;
+	while (lines >> name) {
+		if (name == counter && lines >> value) {
+			return value;
+		}
+		lines.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+	}
+	return -1;
+}
+
+}
+
+TEST(traceCountersPastTheEventCap) {
+	Trace::enable();
+	//A fresh thread, so that its buffer only holds these samples
+	const long long samples = (1 << 20) + 1000;
+	std::thread counting([&]() {
+		for (long long i = 0; i < samples; ++i) {
+			Trace::count("test/samples", 2);
+		}
+	});
+	counting.join();
+	CHECK(getSummaryTotal("test/samples") == 2 * samples);
+	CHECK(getSummary().find("Events dropped") != std::string::npos);
+
+	//The last sample of the timeline is the exact total
+	TemporaryDirectory directory;
+	std::string traceFile = directory.file("trace.json");
+	Trace::writeChromeTrace(traceFile);
+	std::string content = readFileContent(traceFile);
+	std::string lastSample = content.substr(content.rfind("test/samples"));
+	CHECK(lastSample.find(
+			"{\"value\": " + std::to_string(2 * samples) + "}") != std::string::npos);
+
+	Trace::clear();
+	CHECK(getSummaryTotal("test/samples") == -1);
+}
@@ -0,0 +1,130 @@
+/*
+ * threads.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "threads.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include <omp.h>
+#include <Eigen/Core>
+
+namespace {
+
+void pinCurrentThread(int cpu) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+		std::cerr << "Cannot pin a thread to CPU " << cpu << std::endl;
+	}
+}
+
+}
+
+unsigned int ThreadBudget::threads = 0;
+ThreadBudget::NestedPolicy ThreadBudget::policy = ThreadBudget::OUTER;
+bool ThreadBudget::pin = false;
+std::vector<int> ThreadBudget::cpus;
+
+void ThreadBudget::configure(unsigned int _threads, NestedPolicy _policy,
+		bool _pin) {
+	cpus = getAvailableCPUs();
+	threads = _threads == 0 ? cpus.size() : _threads;
+	policy = _policy;
+	pin = _pin;
+
+	omp_set_dynamic(0);
+	omp_set_num_threads(threads);
+	//A loop inside a parallel loop (the k-means restarts of a consensus
+	//round) runs on the thread of the outer loop
+	omp_set_max_active_levels(1);
+	//Follow omp_get_max_threads() of the calling thread
+	Eigen::setNbThreads(0);
+	if (pin) {
+		pinTeam(0, threads);
+	}
+}
+
+unsigned int ThreadBudget::getThreads() {
+	if (threads == 0) {
+		return std::max(1u, std::thread::hardware_concurrency());
+	}
+	return threads;
+}
+
+ThreadBudget::NestedPolicy ThreadBudget::getNestedPolicy() {
+	return policy;
+}
+
+bool ThreadBudget::isPinned() {
+	return pin;
+}
+
+unsigned int ThreadBudget::getWorkers(unsigned int requested) {
+	if (requested > 0) {
+		return requested;
+	}
+	return policy == OUTER ? getThreads() : 1;
+}
+
+std::string ThreadBudget::describe() {
+	return std::to_string(getThreads()) + " ("
+			+ (policy == OUTER ? "outer" : "inner") + " nested policy"
+			+ (pin ? ", pinned" : "") + ")";
+}
+
+std::vector<int> ThreadBudget::getAvailableCPUs() {
+	std::vector<int> available;
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+		for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+			if (CPU_ISSET(cpu, &set)) {
+				available.push_back(cpu);
+			}
+		}
+	}
+	if (available.empty()) {
+		for (unsigned int cpu = 0;
+				cpu < std::max(1u, std::thread::hardware_concurrency());
+				++cpu) {
+			available.push_back(cpu);
+		}
+	}
+	return available;
+}
+
+void ThreadBudget::pinTeam(unsigned int first, unsigned int count) {
+	if (cpus.empty()) {
+		return;
+	}
+	//OpenMP keeps the threads of a team for the next loops of the thread. The
+	//calling thread (number 0) is left alone : the threads and the processes
+	//it starts inherit its mask, and would otherwise share a single CPU.
+#pragma omp parallel num_threads(count)
+	{
+		if (omp_get_thread_num() != 0) {
+			pinCurrentThread(cpus[(first + omp_get_thread_num()) % cpus.size()]);
+		}
+	}
+}
+
+ThreadScope::ThreadScope(unsigned int worker, unsigned int numberOfWorkers) :
+		previousThreads(omp_get_max_threads()) {
+	unsigned int share = std::max(1u,
+			ThreadBudget::getThreads() / std::max(1u, numberOfWorkers));
+	omp_set_num_threads(share);
+	if (ThreadBudget::pin) {
+		ThreadBudget::pinTeam(worker * share, share);
+	}
+}
+
+ThreadScope::~ThreadScope() {
+	omp_set_num_threads(previousThreads);
+}
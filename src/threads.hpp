@@ -0,0 +1,67 @@
+/*
+ * threads.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_THREADS_HPP_
+#define SRC_THREADS_HPP_
+
+#include <string>
+#include <vector>
+
+// Number of threads a run may use, shared by the OpenMP loops, the Eigen
+// products and the thread pools (pipeline stages, batch experiments, server
+// connections, Heinz jobs). Eigen follows the OpenMP setting of the calling
+// thread, so limiting OpenMP limits both.
+class ThreadBudget {
+public:
+	//Which level of a nested parallelism gets the threads : the pools
+	//(OUTER, their loops then run on what is left for each worker) or the
+	//loops (INNER, pools default to one worker)
+	enum NestedPolicy {
+		OUTER, INNER
+	};
+
+	//0 threads means one per CPU the process may run on. Pinned threads are
+	//bound to one of those CPUs each, except the threads which own a team
+	//(main thread, pool workers), whose children would inherit the pinning.
+	static void configure(unsigned int threads, NestedPolicy policy = OUTER,
+			bool pin = false);
+	static unsigned int getThreads();
+	static NestedPolicy getNestedPolicy();
+	static bool isPinned();
+
+	//Workers of a pool : requested, or when 0, what the nested policy gives
+	static unsigned int getWorkers(unsigned int requested);
+	static std::string describe();
+
+	//CPUs of the affinity mask of the process
+	static std::vector<int> getAvailableCPUs();
+
+private:
+	static unsigned int threads;
+	static NestedPolicy policy;
+	static bool pin;
+	static std::vector<int> cpus;
+
+	friend class ThreadScope;
+	//Binds the threads of the OpenMP loops of the calling thread to count
+	//CPUs from first ; the calling thread keeps the mask of the process
+	static void pinTeam(unsigned int first, unsigned int count);
+};
+
+//Share of the budget of the current thread while it is one of numberOfWorkers
+//workers of a pool, for the OpenMP loops and Eigen products it runs
+class ThreadScope {
+public:
+	ThreadScope(unsigned int worker, unsigned int numberOfWorkers);
+	~ThreadScope();
+	ThreadScope(const ThreadScope &) = delete;
+	ThreadScope &operator=(const ThreadScope &) = delete;
+
+private:
+	int previousThreads;
+};
+
+#endif /* SRC_THREADS_HPP_ */
@@ -0,0 +1,219 @@
+/*
+ * trace.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "utilities.hpp"
+
+namespace {
+
+struct TimerEvent {
+	const char *name;
+	double begin;
+	double end;
+};
+
+struct CountEvent {
+	const char *counter;
+	double time;
+	long long value;
+};
+
+//Events of one thread, only written by that thread until the trace is dumped
+struct ThreadBuffer {
+	unsigned int threadId;
+	std::vector<TimerEvent> timers;
+	std::vector<CountEvent> counts;
+	//Events past MAX_EVENTS_PER_THREAD
+	unsigned long long dropped = 0;
+	//Sum of every count, kept or dropped, per counter literal
+	std::unordered_map<const char *, long long> counterTotals;
+};
+
+//About 24 MB of timers per thread : a long server or batch run keeps its
+//first events and counts the others
+const std::size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+std::chrono::steady_clock::time_point traceStart;
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer *localBuffer = nullptr;
+
+ThreadBuffer *getLocalBuffer() {
+	if (!localBuffer) {
+		std::lock_guard<std::mutex> lock(buffersMutex);
+		buffers.emplace_back(new ThreadBuffer());
+		buffers.back()->threadId = buffers.size() - 1;
+		localBuffer = buffers.back().get();
+	}
+	return localBuffer;
+}
+
+}
+
+bool Trace::enabled = false;
+
+void Trace::enable() {
+	traceStart = std::chrono::steady_clock::now();
+	enabled = true;
+}
+
+double Trace::now() {
+	return std::chrono::duration<double, std::micro>(
+			std::chrono::steady_clock::now() - traceStart).count();
+}
+
+void Trace::recordEvent(const char *name, double begin, double end) {
+	ThreadBuffer *buffer = getLocalBuffer();
+	if (buffer->timers.size() + buffer->counts.size()
+			>= MAX_EVENTS_PER_THREAD) {
+		++buffer->dropped;
+		return;
+	}
+	buffer->timers.push_back( { name, begin, end });
+}
+
+void Trace::recordCount(const char *counter, long long value) {
+	ThreadBuffer *buffer = getLocalBuffer();
+	buffer->counterTotals[counter] += value;
+	if (buffer->timers.size() + buffer->counts.size()
+			>= MAX_EVENTS_PER_THREAD) {
+		++buffer->dropped;
+		return;
+	}
+	buffer->counts.push_back( { counter, now(), value });
+}
+
+void Trace::clear() {
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	//The buffers themselves stay, threads keep a pointer to theirs
+	for (const auto &buffer : buffers) {
+		std::vector<TimerEvent>().swap(buffer->timers);
+		std::vector<CountEvent>().swap(buffer->counts);
+		buffer->dropped = 0;
+		buffer->counterTotals.clear();
+	}
+}
+
+void Trace::writeChromeTrace(const std::string &filename) {
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	std::ofstream outputStream(filename);
+	outputStream << std::fixed << std::setprecision(3);
+	outputStream << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+	bool first = true;
+	auto separator = [&]() -> const char * {
+		const char *s = first ? "" : ",\n";
+		first = false;
+		return s;
+	};
+
+	std::vector<CountEvent> counts;
+	std::map<std::string, long long> exactTotals;
+	for (const auto &buffer : buffers) {
+		for (const auto &counter : buffer->counterTotals) {
+			exactTotals[counter.first] += counter.second;
+		}
+		outputStream << separator()
+				<< "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": "
+				<< buffer->threadId << ", \"args\": {\"name\": \""
+				<< (buffer->threadId == 0 ? "main" : "worker") << " "
+				<< buffer->threadId << "\"}}";
+		for (const auto &event : buffer->timers) {
+			outputStream << separator() << "{\"name\": \""
+					<< escapeJSON(event.name)
+					<< "\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+					<< buffer->threadId << ", \"ts\": " << event.begin
+					<< ", \"dur\": " << event.end - event.begin << "}";
+		}
+		counts.insert(counts.end(), buffer->counts.begin(),
+				buffer->counts.end());
+	}
+
+	//Counters are shown as running totals over all threads
+	std::stable_sort(counts.begin(), counts.end(),
+			[](const CountEvent &a, const CountEvent &b) {
+				return a.time < b.time;
+			});
+	std::map<std::string, long long> totals;
+	for (const auto &event : counts) {
+		long long &total = totals[event.counter];
+		total += event.value;
+		outputStream << separator() << "{\"name\": \"" << escapeJSON(event.counter)
+				<< "\", \"ph\": \"C\", \"pid\": 1, \"ts\": " << event.time
+				<< ", \"args\": {\"value\": " << total << "}}";
+	}
+	//Dropped samples still count : a last sample brings the curve to the total
+	double end = now();
+	for (const auto &counter : exactTotals) {
+		if (totals[counter.first] != counter.second) {
+			outputStream << separator() << "{\"name\": \""
+					<< escapeJSON(counter.first)
+					<< "\", \"ph\": \"C\", \"pid\": 1, \"ts\": " << end
+					<< ", \"args\": {\"value\": " << counter.second << "}}";
+		}
+	}
+	outputStream << "\n]}\n";
+
+	if (!outputStream) {
+		throw std::runtime_error("Cannot write trace file " + filename);
+	}
+}
+
+void Trace::printSummary(std::ostream &output) {
+	std::lock_guard<std::mutex> lock(buffersMutex);
+	std::map<std::string, std::pair<double, unsigned int>> stages;
+	std::map<std::string, long long> counters;
+	unsigned long long dropped = 0;
+	for (const auto &buffer : buffers) {
+		dropped += buffer->dropped;
+		for (const auto &event : buffer->timers) {
+			auto &stage = stages[event.name];
+			stage.first += event.end - event.begin;
+			++stage.second;
+		}
+		for (const auto &counter : buffer->counterTotals) {
+			counters[counter.first] += counter.second;
+		}
+	}
+
+	std::vector<std::pair<std::string, std::pair<double, unsigned int>>> sortedStages(
+			stages.begin(), stages.end());
+	std::sort(sortedStages.begin(), sortedStages.end(),
+			[](const decltype(sortedStages)::value_type &a,
+					const decltype(sortedStages)::value_type &b) {
+				return a.second.first > b.second.first;
+			});
+
+	std::ios::fmtflags flags = output.flags();
+	std::streamsize precision = output.precision();
+	output << std::left << std::setw(32) << "Stage" << std::setw(14)
+			<< "Total (ms)" << "Calls" << std::endl;
+	output << std::fixed << std::setprecision(1);
+	for (const auto &stage : sortedStages) {
+		output << std::setw(32) << stage.first << std::setw(14)
+				<< stage.second.first / 1000 << stage.second.second
+				<< std::endl;
+	}
+	for (const auto &counter : counters) {
+		output << std::setw(32) << counter.first << counter.second
+				<< std::endl;
+	}
+	if (dropped > 0) {
+		output << std::setw(32) << "Events dropped" << dropped << std::endl;
+	}
+	output.flags(flags);
+	output.precision(precision);
+}
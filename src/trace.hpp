@@ -0,0 +1,66 @@
+/*
+ * trace.hpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef SRC_TRACE_HPP_
+#define SRC_TRACE_HPP_
+
+#include <string>
+#include <iostream>
+
+// Stage timings and counters of a run, written as a Chrome trace-event file
+// (chrome://tracing, Perfetto). Nothing is recorded until enable() is called :
+// timers and counters then only test a flag. Each thread keeps at most about
+// a million events, the others are only counted ; counter totals stay exact.
+class Trace {
+public:
+	static void enable();
+	static bool isEnabled() {
+		return enabled;
+	}
+	//Adds value to a global counter (files, bytes, samples...)
+	static void count(const char *counter, long long value) {
+		if (enabled) {
+			recordCount(counter, value);
+		}
+	}
+	static void writeChromeTrace(const std::string &filename);
+	//Total time per stage (over all threads) and counter totals
+	static void printSummary(std::ostream &output = std::cout);
+	//Forgets the recorded events ; no other thread should be recording
+	static void clear();
+
+private:
+	friend class ScopedTimer;
+	static bool enabled;
+
+	//Microseconds since enable()
+	static double now();
+	static void recordEvent(const char *name, double begin, double end);
+	static void recordCount(const char *counter, long long value);
+};
+
+//Records the lifetime of the object as a stage of the current thread. name
+//should be a literal : only the pointer is kept.
+class ScopedTimer {
+public:
+	explicit ScopedTimer(const char *_name) :
+			name(Trace::isEnabled() ? _name : nullptr), begin(
+					name ? Trace::now() : 0) {
+	}
+	~ScopedTimer() {
+		if (name) {
+			Trace::recordEvent(name, begin, Trace::now());
+		}
+	}
+	ScopedTimer(const ScopedTimer &) = delete;
+	ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+private:
+	const char *name;
+	double begin;
+};
+
+#endif /* SRC_TRACE_HPP_ */
@@ -1,6 +1,13 @@
 #include <iostream>
+#include <fstream>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cerrno>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "utilities.hpp"
 
 void printAdvancement(unsigned int currentCount, unsigned int totalCount) {
@@ -8,6 +15,49 @@ void printAdvancement(unsigned int currentCount, unsigned int totalCount) {
 			<< "% \r" << std::flush;
 }
 
+ProgressCounter::ProgressCounter(unsigned int _total, const std::string &_unit,
+		bool _verbose) :
+		total(_total), unit(_unit), verbose(_verbose), start(
+				std::chrono::steady_clock::now()), count(0), lastPrint(0) {
+}
+
+void ProgressCounter::increment(unsigned int increment) {
+	unsigned int current = (count += increment);
+	if (!verbose) {
+		return;
+	}
+	//At most one print every 200ms, by whichever thread gets there first
+	long long now = std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - start).count();
+	long long last = lastPrint.load();
+	if (now - last >= 200 && lastPrint.compare_exchange_strong(last, now)) {
+		print(current);
+	}
+}
+
+void ProgressCounter::finish() {
+	if (verbose) {
+		print(count.load());
+		std::cout << std::endl;
+	}
+}
+
+unsigned int ProgressCounter::getCount() const {
+	return count.load();
+}
+
+double ProgressCounter::getThroughput() const {
+	double seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	return (seconds > 0) ? count.load() / seconds : 0.0;
+}
+
+void ProgressCounter::print(unsigned int current) const {
+	std::cout << current << "/" << total << " " << unit << " ("
+			<< (100.0 * (double) current) / (double) (total) << "%), "
+			<< getThroughput() << " " << unit << "/s \r" << std::flush;
+}
+
 std::vector<std::string> split(const std::string &s,
 		const std::vector<char> &delimiters) {
 	std::vector<std::string> strs;
@@ -28,6 +78,24 @@ std::vector<std::string> split(const std::string &s,
 	return strs;
 }
 
+std::string escapeJSON(const std::string &s) {
+	static const char hexDigits[] = "0123456789abcdef";
+	std::string result;
+	for (char c : s) {
+		if (c == '"' || c == '\\') {
+			result += '\\';
+			result += c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			result += "\\u00";
+			result += hexDigits[(c >> 4) & 0xf];
+			result += hexDigits[c & 0xf];
+		} else {
+			result += c;
+		}
+	}
+	return result;
+}
+
 std::string removeTrailingZeros(std::string s) {
 	if (std::find(s.begin(), s.end(), '.') != s.end()) {
 		int n = s.size();
@@ -39,6 +107,70 @@ std::string removeTrailingZeros(std::string s) {
 	return s;
 }
 
+std::string temporaryFilename(const std::string &filename) {
+	static std::atomic<unsigned long> counter(0);
+	return filename + ".tmp." + std::to_string(getpid()) + "."
+			+ std::to_string(counter++);
+}
+
+std::string readFileContent(const std::string &filename) {
+	std::ifstream input(filename, std::ios::binary);
+	std::string content;
+	if (input) {
+		input.seekg(0, std::ios::end);
+		std::streamoff size = input.tellg();
+		if (size > 0) {
+			content.resize(size);
+			input.seekg(0, std::ios::beg);
+			input.read(&content[0], size);
+			content.resize(input.gcount());
+		}
+	}
+	return content;
+}
+
+void makeDirectory(const std::string &path) {
+	if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+		throw std::runtime_error("Cannot create directory " + path);
+	}
+}
+
+unsigned long long hashBytes(const std::string &bytes,
+		unsigned long long seed) {
+	unsigned long long hash = seed;
+	for (unsigned char c : bytes) {
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+std::string toHexString(unsigned long long value) {
+	static const char digits[] = "0123456789abcdef";
+	std::string s(16, '0');
+	for (int i = 15; i >= 0; --i, value >>= 4) {
+		s[i] = digits[value & 0xf];
+	}
+	return s;
+}
+
+void writeBinary(std::ostream &output, const std::string &s) {
+	writeBinary(output, (unsigned int) s.size());
+	output.write(s.data(), s.size());
+}
+
+void readBinary(std::istream &input, std::string *s) {
+	unsigned int size = 0;
+	readBinary(input, &size);
+	//A corrupted size should not allocate gigabytes
+	if (!input || size > (1u << 28)) {
+		input.setstate(std::ios::failbit);
+		return;
+	}
+	s->resize(size);
+	input.read(&(*s)[0], size);
+}
+
 double computeMean(const std::vector<double> &vec) {
 	double sum = accumulate(vec.cbegin(), vec.cend(), 0.0);
 	return sum / (double) vec.size();
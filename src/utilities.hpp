@@ -5,10 +5,31 @@
 #include <string>
 #include <tuple>
 #include <iostream>
+#include <atomic>
+#include <chrono>
 
 //Prints advancement of a task in %
 void printAdvancement(unsigned int currentCount, unsigned int totalCount);
 
+//Thread-safe counterpart of printAdvancement, also reporting throughput
+class ProgressCounter {
+public:
+	ProgressCounter(unsigned int _total, const std::string &_unit,
+			bool _verbose = true);
+	void increment(unsigned int count = 1);
+	void finish();
+	unsigned int getCount() const;
+	double getThroughput() const;
+private:
+	unsigned int total;
+	std::string unit;
+	bool verbose;
+	std::chrono::steady_clock::time_point start;
+	std::atomic<unsigned int> count;
+	std::atomic<long long> lastPrint;
+	void print(unsigned int current) const;
+};
+
 //Splits a string according to delimiters
 std::vector<std::string> split(const std::string &s,
 		const std::vector<char> &delimiters);
@@ -48,6 +69,36 @@ std::ostream& operator<<(std::ostream& out, const std::tuple<Args...>& t) {
 
 std::string removeTrailingZeros(std::string s);
 
+//Content of a JSON string literal
+std::string escapeJSON(const std::string &s);
+
+//mkdir 0755 which tolerates an existing directory, throws otherwise
+void makeDirectory(const std::string &path);
+
+//Name next to filename for a file written then renamed to it, unique to the
+//process and to the call so that concurrent writers do not share it
+std::string temporaryFilename(const std::string &filename);
+
+//Reads a whole file in one go (empty string if it cannot be opened)
+std::string readFileContent(const std::string &filename);
+
+//64-bit FNV-1a, chained through seed
+unsigned long long hashBytes(const std::string &bytes,
+		unsigned long long seed = 14695981039346656037ULL);
+std::string toHexString(unsigned long long value);
+
+//Binary serialization of trivially copyable values and of strings
+template<typename T>
+void writeBinary(std::ostream &output, const T &value) {
+	output.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+template<typename T>
+void readBinary(std::istream &input, T *value) {
+	input.read(reinterpret_cast<char *>(value), sizeof(T));
+}
+void writeBinary(std::ostream &output, const std::string &s);
+void readBinary(std::istream &input, std::string *s);
+
 double computeMean(const std::vector<double> &vec);
 double computeStandardDeviation(const std::vector<double> &vec, bool correction = true);
 